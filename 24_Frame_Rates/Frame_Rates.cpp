@@ -5,6 +5,8 @@
 #include <string>
 #include <sstream>
 #include <iostream>
+#include "../Engine/LTimer.h"
+#include "../Engine/GlyphCache.h"
 
 using namespace std;
 
@@ -12,84 +14,6 @@ using namespace std;
 const int SCREEN_WIDTH = 640;
 const int SCREEN_HEIGHT = 480;
 
-//Texture wrapper class
-class LTexture
-{
-	public:
-		//Initializes variables
-		LTexture();
-
-		//Deallocates memory
-		~LTexture();
-
-		//Loads image at specified path
-		bool loadFromFile( string path );
-
-		#ifdef _SDL_TTF_H
-		//Creates image from font string
-		bool loadFromRenderedText( string textureText, SDL_Color textColor );
-		#endif
-
-		//Deallocates texture
-		void free();
-
-		//set color modulation
-		void setColor( Uint8 red, Uint8 green, Uint8 blue );
-
-		//Set Blending
-		void setBlendMode( SDL_BlendMode blending );
-
-		//Set alpha modulation
-		void setAlpha( Uint8 alpha );
-
-		//Renders texture at given point
-		void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
-
-		//Gets image dimensions
-		int getWidth();
-		int getHeight();
-
-	private:
-		//The actual hardware texture
-		SDL_Texture* mTexture;
-
-		//Image dimensions
-		int mWidth;
-		int mHeight;
-};
-
-//The application time based timer
-class LTimer
-{
-	public:
-		//Initializes variable
-		LTimer();
-
-		//The various clock actions
-		void start();
-		void stop();
-		void pause();
-		void unpause();
-
-		//Gets the timer's time
-		Uint32 getTicks();
-
-		//Checks the status of the timer
-		bool isStarted();
-		bool isPaused();
-
-	private:
-		//The clock time when the timer started
-		Uint32 mStartTicks;
-
-		//The ticks stored when the timer was paused
-		Uint32 mPausedTicks;
-
-		//The timer status
-		bool mPaused;
-		bool mStarted;
-};
-
 //Starts up SDL and creates window
 bool init();
 
@@ -108,257 +32,8 @@ SDL_Renderer* gRenderer = NULL;
 //Globally used font
 TTF_Font *gFont = NULL;
 
-//Scene textures
-LTexture gFPSTextTexture;
-
-LTexture::LTexture()
-{
-	//Initialize
-	mTexture = NULL;
-	mWidth = 0;
-	mHeight = 0;
-}
-
-LTexture::~LTexture()
-{
-	//Deallocate
-	free();
-}
-
-bool LTexture::loadFromFile( string path )
-{
-	//Get rid of preexisting texture
-	free();
-
-	//The final texture
-	SDL_Texture* newTexture = NULL;
-
-	//Load image at specified path
-	SDL_Surface* loadedSurface = IMG_Load( path.c_str() );
-	if( loadedSurface == NULL )
-	{
-		cout << "Unable to load image %s! SDL_image Error: %s\n" << path.c_str() << IMG_GetError() << endl;
-	}
-	else
-	{
-		//Color key image
-		SDL_SetColorKey( loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ) );
-
-		//Create texture from surface pixels
-	newTexture = SDL_CreateTextureFromSurface( gRenderer, loadedSurface );
-		if( newTexture == NULL )
-		{
-			cout << "Unable to create texture from %s! SDL Error %s\n" << path.c_str() << SDL_GetError() << endl;
-		}
-		else
-		{
-			//Get image dimensions
-			mWidth = loadedSurface->w;
-			mHeight = loadedSurface->h;
-		}
-
-		//Get rid of old loaded surface
-		SDL_FreeSurface( loadedSurface );
-	}
-
-	//Return success
-	mTexture = newTexture;
-	return mTexture != NULL;
-}
-
-#ifdef _SDL_TTF_H
-bool LTexture::loadFromRenderedText( string textureText, SDL_Color textColor )
-{
-	//Get rid of preexisting texture
-	free();
-
-	//Render text surface
-	SDL_Surface* textSurface = TTF_RenderText_Solid( gFont, textureText.c_str(), textColor );
-	if( textSurface != NULL )
-	{
-		//Create texture from surface pixels
-	mTexture = SDL_CreateTextureFromSurface( gRenderer, textSurface );
-		if( mTexture == NULL )
-		{
-		cout << "Unable to create texture from rendered text! SDL Error: %s\n" << SDL_GetError() << endl;
-		}
-		else
-		{
-			//Get image dimensions
-			mWidth = textSurface->w;
-			mHeight = textSurface->h;
-		}
-
-		//Get rid of old surface
-		SDL_FreeSurface( textSurface );
-	}
-	else
-	{
-		cout << "Unable to render text Surface! SDL_ttf Error: %s\n" << TTF_GetError() << endl;
-	}
-
-	//Return success
-	return mTexture != NULL;
-}
-#endif
-
-void LTexture::free()
-{
-	//Free texture if it exists
-	if( mTexture != NULL )
-	{
-		SDL_DestroyTexture( mTexture );
-		mTexture = NULL;
-		mWidth = 0;
-		mHeight = 0;
-	}
-}
-
-void LTexture::setColor( Uint8 red, Uint8 green, Uint8 blue )
-{
-	//Modulate texture rgb
-	SDL_SetTextureColorMod( mTexture, red, green, blue );
-}
-
-void LTexture::setBlendMode( SDL_BlendMode blending )
-{
-	//Set blending function
-	SDL_SetTextureBlendMode( mTexture, blending );
-}
-
-void LTexture::setAlpha( Uint8 alpha )
-{
-	//Modulate texture alpha
-	SDL_SetTextureAlphaMod( mTexture, alpha );
-}
-
-void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip )
-{
-	//Set rendering space and render to screen
-	SDL_Rect renderQuad = { x, y, mWidth, mHeight };
-
-	//Set clip rending dimensions
-	if( clip != NULL )
-	{
-		renderQuad.w = clip->w;
-		renderQuad.h = clip->h;
-	}
-
-	//Render to screen
-	SDL_RenderCopyEx( gRenderer, mTexture, clip, &renderQuad, angle, center, flip );
-}
-
-int LTexture::getWidth()
-{
-	return mWidth;
-}
-
-int LTexture::getHeight()
-{
-	return mHeight;
-}
-
-LTimer::LTimer()
-{
-	//Initialize the variables
-	mStartTicks = 0;
-	mPausedTicks = 0;
-
-	mPaused = false;
-	mStarted = false;
-}
-
-void LTimer::start()
-{
-	//Start the timer
-	mStarted = true;
-
-	//Unpause the timer
-	mPaused = false;
-
-	//Get the current clock time
-	mStartTicks = SDL_GetTicks();
-		mPausedTicks = 0;
-}
-
-void LTimer::stop()
-{
-	//Stop the timer
-	mStarted = false;
-
-	//Unpaused the timer
-	mPaused = false;
-
-	//Clear tick variables
-	mStartTicks = 0;
-	mPausedTicks = 0;
-}
-
-void LTimer::pause()
-{
-	//IF the timer is running and isn't slready paused
-	if( mStarted && !mPaused )
-	{
-		//Pause the timer
-		mPaused = true;
-
-		//Calculate the paused ticks
-		mPausedTicks = SDL_GetTicks() - mStartTicks;
-			mStartTicks = 0;
-	}
-}
-
-void LTimer::unpause()
-{
-	//If the timer is running and paused
-	if( mStarted && mPaused )
-	{
-		//Unpaused the timer
-		mPaused = false;
-
-		//Reset the starting ticks
-		mStartTicks = SDL_GetTicks() - mPausedTicks;
-
-		//Reset the paused ticks
-		mPausedTicks = 0;
-	}
-}
-
-Uint32 LTimer::getTicks()
-{
-	//The actual timer time
-	Uint32 time = 0;
-
-	//If the timer is running
-	if( mStarted )
-	{
-		//If the timer is paused
-		if( mPaused )
-		{
-			//Return the number of ticks when the timer was paused
-			time = mPausedTicks;
-		}
-		else
-		{
-			//Return the current time minus the start time
-			time = SDL_GetTicks() - mStartTicks;
-		}
-	}
-
-	return time;
-}
-
-bool LTimer::isStarted()
-{
-	//Timer is running and paused or unpaused
-	return mStarted;
-}
-
-bool LTimer::isPaused()
-{
-	//Timer is running and paused
-	return mPaused && mStarted;
-}
+//Font glyphs for text that changes every frame
+GlyphCache gTextCache;
 
 bool init()
 {
@@ -379,7 +54,6 @@ bool init()
 			cout << "Warning: Linear texture filtering not enabled!" << endl;
 		}
 
-
 		//Create window
 		gWindow = SDL_CreateWindow( "SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN );
 		if( gWindow == NULL )
@@ -434,14 +108,23 @@ bool loadMedia()
 		cout << "failed to load lazy font! SDL_ttf Error: %s\n" << TTF_GetError() << endl;
 		success = false;
 	}
+	else
+	{
+		//Render the font's glyphs once
+		if( !gTextCache.load( gRenderer, gFont ) )
+		{
+			cout << "Unable to cache lazy font glyphs!" << endl;
+			success = false;
+		}
+	}
 
 	return success;
 }
 
 void close()
 {
-	//Free loaded image
-	gFPSTextTexture.free();
+	//Free cached glyphs
+	gTextCache.free();
 
 	//Free global font
 	TTF_CloseFont( gFont );
@@ -485,7 +168,15 @@ int main()
 			SDL_Color textColor = { 0, 0, 0, 255 };
 
 			//The framed per second timer
-			LTimer fpsTimer;
+			LTimer fpsTimer( TIMER_PERFORMANCE );
+
+			//Times each section of a frame, milliseconds are too coarse for this
+			LTimer frameTimer( TIMER_PERFORMANCE );
+
+			//Section times of the last frame in nanoseconds
+			Uint64 updateTime = 0;
+			Uint64 drawTime = 0;
+			Uint64 presentTime = 0;
 
 			//In memory text stream
 			stringstream timeText;
@@ -497,6 +188,9 @@ int main()
 			//While application is running
 			while( !quit )
 			{
+				//Start timing the frame
+				frameTimer.start();
+
 				//Handle events on queue
 				while( SDL_PollEvent( &e ) != 0 )
 				{
@@ -508,32 +202,37 @@ int main()
 				}
 
 				//Calculated and correct fps
-				float avgFPS = countedFrames / (fpsTimer.getTicks() / 1000.f );
+				float avgFPS = countedFrames / fpsTimer.getSeconds();
 				if( avgFPS > 2000000 )
 				{
 					avgFPS = 0;
 				}
 
-				//Set text to be rendered
+				//Set text to be rendered, composed from cached glyphs so no text is rendered through SDL_ttf
+				int textHeight = gTextCache.getHeight();
+				gTextCache.begin();
 				timeText.str( "" );
 				timeText << "Average frames per Second" << avgFPS;
+				gTextCache.add( timeText.str(), ( SCREEN_WIDTH - gTextCache.getTextWidth( timeText.str() ) ) / 2, ( SCREEN_HEIGHT - textHeight ) / 2, textColor );
 
-				//Render text
-				if( !gFPSTextTexture.loadFromRenderedText( timeText.str().c_str(), textColor ) )
-				{
-					cout << "Unable to render FPS texture!\n" << endl;
-				}
+				//Section times in milliseconds below it
+				timeText.str( "" );
+				timeText << "Update " << updateTime / 1000000.0 << " Draw " << drawTime / 1000000.0 << " Present " << presentTime / 1000000.0;
+				gTextCache.add( timeText.str(), ( SCREEN_WIDTH - gTextCache.getTextWidth( timeText.str() ) ) / 2, ( SCREEN_HEIGHT + textHeight ) / 2, textColor );
+				updateTime = frameTimer.lap();
 
 				//Clear screen
 				SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
 
 				SDL_RenderClear( gRenderer );
 
-				//Render texture
-			gFPSTextTexture.render( ( SCREEN_WIDTH - gFPSTextTexture.getWidth() ) / 2, ( SCREEN_HEIGHT - gFPSTextTexture.getHeight() ) / 2 );
+				//Render text
+				gTextCache.flush( gRenderer );
+				drawTime = frameTimer.lap();
 
 				//Update screen
 				SDL_RenderPresent( gRenderer );
+				presentTime = frameTimer.lap();
 				++countedFrames;
 			}
 		}
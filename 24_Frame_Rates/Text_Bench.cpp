@@ -0,0 +1,119 @@
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <sstream>
+#include <iostream>
+#include "../Engine/LTexture.h"
+#include "../Engine/GlyphCache.h"
+#include "../Engine/BenchUtil.h"
+
+using namespace std;
+
+//Same screen and font as the sample
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+const int FONT_SIZE = 28;
+
+//Text updates per run
+const int BENCH_UPDATES = 5000;
+
+//Ways to show changing text
+enum TextMode
+{
+	TEXT_TTF,
+	TEXT_GLYPHS,
+	TOTAL_TEXT_MODES
+};
+
+//Mode display names
+const char* TEXT_MODE_NAMES[] = { "TTF texture", "glyph cache" };
+
+//Software renderer drawing into a surface, so no window is needed
+SDL_Renderer* gRenderer = NULL;
+
+//The sample's font
+TTF_Font* gFont = NULL;
+
+int main( int argc, char* args[] )
+{
+	if( TTF_Init() == -1 )
+	{
+		cout << "SDL_ttf could not initialize! SDL_ttf Error: " << TTF_GetError() << endl;
+		return 1;
+	}
+
+	SDL_Surface* screen = SDL_CreateRGBSurfaceWithFormat( 0, SCREEN_WIDTH, SCREEN_HEIGHT, 32, SDL_PIXELFORMAT_RGBA8888 );
+	gRenderer = screen != NULL ? SDL_CreateSoftwareRenderer( screen ) : NULL;
+	gFont = TTF_OpenFont( "lazy.ttf", FONT_SIZE );
+	if( gRenderer == NULL || gFont == NULL )
+	{
+		cout << "Unable to set up renderer and font! SDL Error: " << SDL_GetError() << " SDL_ttf Error: " << TTF_GetError() << endl;
+		return 1;
+	}
+
+	//Glyphs are rendered once, outside the timed runs
+	Uint64 start = SDL_GetPerformanceCounter();
+	GlyphCache cache;
+	if( !cache.load( gRenderer, gFont ) )
+	{
+		return 1;
+	}
+	cout << "glyph cache built in " << getSeconds( start ) * 1000.0 << " ms" << endl;
+
+	//Both paths have to lay the readouts out the same, or the timings compare different text
+	stringstream timeText;
+	int mismatches = 0;
+	for( int i = 0; i < BENCH_UPDATES; ++i )
+	{
+		timeText.str( "" );
+		timeText << "Average frames per Second" << 60.0f + i / 1000.0f;
+		int width = 0;
+		int height = 0;
+		if( TTF_SizeText( gFont, timeText.str().c_str(), &width, &height ) != 0 || width != cache.getTextWidth( timeText.str() ) )
+		{
+			++mismatches;
+		}
+	}
+	if( mismatches > 0 )
+	{
+		cout << mismatches << " readouts are laid out wider or narrower by the glyph cache than by SDL_ttf!" << endl;
+		return 1;
+	}
+
+	cout << "mode\tupdates/s\tus/update" << endl;
+
+	SDL_Color textColor = { 0, 0, 0, 255 };
+	LTexture texture;
+	for( int m = 0; m < TOTAL_TEXT_MODES; ++m )
+	{
+		//A changing frame rate readout like the sample's, set up and drawn each update
+		start = SDL_GetPerformanceCounter();
+		for( int i = 0; i < BENCH_UPDATES; ++i )
+		{
+			timeText.str( "" );
+			timeText << "Average frames per Second" << 60.0f + i / 1000.0f;
+			if( m == TEXT_TTF )
+			{
+				texture.loadFromRenderedText( timeText.str(), textColor );
+				texture.render( ( SCREEN_WIDTH - texture.getWidth() ) / 2, ( SCREEN_HEIGHT - texture.getHeight() ) / 2 );
+			}
+			else
+			{
+				cache.render( gRenderer, timeText.str(), ( SCREEN_WIDTH - cache.getTextWidth( timeText.str() ) ) / 2, ( SCREEN_HEIGHT - cache.getHeight() ) / 2, textColor );
+			}
+		}
+		double seconds = getSeconds( start );
+
+		cout << TEXT_MODE_NAMES[ m ] << "\t" << BENCH_UPDATES / seconds << "\t" << seconds / BENCH_UPDATES * 1000000.0 << endl;
+	}
+
+	//Free resources
+	texture.free();
+	cache.free();
+	TTF_CloseFont( gFont );
+	SDL_DestroyRenderer( gRenderer );
+	SDL_FreeSurface( screen );
+	TTF_Quit();
+	SDL_Quit();
+
+	return 0;
+}
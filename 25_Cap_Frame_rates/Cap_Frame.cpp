@@ -2,9 +2,13 @@
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string>
 #include <sstream>
 #include <iostream>
+#include "../Engine/LTimer.h"
+#include "../Engine/FramePacer.h"
+#include "../Engine/GlyphCache.h"
 
 using namespace std;
 
@@ -12,85 +16,6 @@ using namespace std;
 const int SCREEN_WIDTH = 640;
 const int SCREEN_HEIGHT = 480;
 const int SCREEN_FPS = 60;
-const int SCREEN_TICK_PER_FRAME = 1000 / SCREEN_FPS;
-
-//Texture wrapper class
-class LTexture
-{
-	public:
-		//Initializes variables
-		LTexture();
-
-		//Deallocates memory
-		~LTexture();
-
-		//Loads image at specified path
-		bool loadFromFile( string path );
-
-		#ifdef _SDL_TTF_H
-		//Creates image from font string
-		bool loadFromRenderedText( string textureText, SDL_Color textColor );
-		#endif
-
-		//Deallocates texture
-		void free();
-
-		//set color modulation
-		void setColor( Uint8 red, Uint8 green, Uint8 blue );
-
-		//Set Blending
-		void setBlendMode( SDL_BlendMode blending );
-
-		//Set alpha modulation
-		void setAlpha( Uint8 alpha );
-
-		//Renders texture at given point
-		void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
-
-		//Gets image dimensions
-		int getWidth();
-		int getHeight();
-
-	private:
-		//The actual hardware texture
-		SDL_Texture* mTexture;
-
-		//Image dimensions
-		int mWidth;
-		int mHeight;
-};
-
-//The application time based timer
-class LTimer
-{
-	public:
-		//Initializes variable
-		LTimer();
-
-		//The various clock actions
-		void start();
-		void stop();
-		void pause();
-		void unpause();
-
-		//Gets the timer's time
-		Uint32 getTicks();
-
-		//Checks the status of the timer
-		bool isStarted();
-		bool isPaused();
-
-	private:
-		//The clock time when the timer started
-		Uint32 mStartTicks;
-
-		//The ticks stored when the timer was paused
-		Uint32 mPausedTicks;
-
-		//The timer status
-		bool mPaused;
-		bool mStarted;
-};
 
 //Starts up SDL and creates window
 bool init();
@@ -110,257 +35,8 @@ SDL_Renderer* gRenderer = NULL;
 //Globally used font
 TTF_Font *gFont = NULL;
 
-//Scene textures
-LTexture gFPSTextTexture;
-
-LTexture::LTexture()
-{
-	//Initialize
-	mTexture = NULL;
-	mWidth = 0;
-	mHeight = 0;
-}
-
-LTexture::~LTexture()
-{
-	//Deallocate
-	free();
-}
-
-bool LTexture::loadFromFile( string path )
-{
-	//Get rid of preexisting texture
-	free();
-
-	//The final texture
-	SDL_Texture* newTexture = NULL;
-
-	//Load image at specified path
-	SDL_Surface* loadedSurface = IMG_Load( path.c_str() );
-	if( loadedSurface == NULL )
-	{
-		cout << "Unable to load image %s! SDL_image Error: %s\n" << path.c_str() << IMG_GetError() << endl;
-	}
-	else
-	{
-		//Color key image
-		SDL_SetColorKey( loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ) );
-
-		//Create texture from surface pixels
-	newTexture = SDL_CreateTextureFromSurface( gRenderer, loadedSurface );
-		if( newTexture == NULL )
-		{
-			cout << "Unable to create texture from %s! SDL Error %s\n" << path.c_str() << SDL_GetError() << endl;
-		}
-		else
-		{
-			//Get image dimensions
-			mWidth = loadedSurface->w;
-			mHeight = loadedSurface->h;
-		}
-
-		//Get rid of old loaded surface
-		SDL_FreeSurface( loadedSurface );
-	}
-
-	//Return success
-	mTexture = newTexture;
-	return mTexture != NULL;
-}
-
-#ifdef _SDL_TTF_H
-bool LTexture::loadFromRenderedText( string textureText, SDL_Color textColor )
-{
-	//Get rid of preexisting texture
-	free();
-
-	//Render text surface
-	SDL_Surface* textSurface = TTF_RenderText_Solid( gFont, textureText.c_str(), textColor );
-	if( textSurface != NULL )
-	{
-		//Create texture from surface pixels
-	mTexture = SDL_CreateTextureFromSurface( gRenderer, textSurface );
-		if( mTexture == NULL )
-		{
-		cout << "Unable to create texture from rendered text! SDL Error: %s\n" << SDL_GetError() << endl;
-		}
-		else
-		{
-			//Get image dimensions
-			mWidth = textSurface->w;
-			mHeight = textSurface->h;
-		}
-
-		//Get rid of old surface
-		SDL_FreeSurface( textSurface );
-	}
-	else
-	{
-		cout << "Unable to render text Surface! SDL_ttf Error: %s\n" << TTF_GetError() << endl;
-	}
-
-	//Return success
-	return mTexture != NULL;
-}
-#endif
-
-void LTexture::free()
-{
-	//Free texture if it exists
-	if( mTexture != NULL )
-	{
-		SDL_DestroyTexture( mTexture );
-		mTexture = NULL;
-		mWidth = 0;
-		mHeight = 0;
-	}
-}
-
-void LTexture::setColor( Uint8 red, Uint8 green, Uint8 blue )
-{
-	//Modulate texture rgb
-	SDL_SetTextureColorMod( mTexture, red, green, blue );
-}
-
-void LTexture::setBlendMode( SDL_BlendMode blending )
-{
-	//Set blending function
-	SDL_SetTextureBlendMode( mTexture, blending );
-}
-
-void LTexture::setAlpha( Uint8 alpha )
-{
-	//Modulate texture alpha
-	SDL_SetTextureAlphaMod( mTexture, alpha );
-}
-
-void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip )
-{
-	//Set rendering space and render to screen
-	SDL_Rect renderQuad = { x, y, mWidth, mHeight };
-
-	//Set clip rending dimensions
-	if( clip != NULL )
-	{
-		renderQuad.w = clip->w;
-		renderQuad.h = clip->h;
-	}
-
-	//Render to screen
-	SDL_RenderCopyEx( gRenderer, mTexture, clip, &renderQuad, angle, center, flip );
-}
-
-int LTexture::getWidth()
-{
-	return mWidth;
-}
-
-int LTexture::getHeight()
-{
-	return mHeight;
-}
-
-LTimer::LTimer()
-{
-	//Initialize the variables
-	mStartTicks = 0;
-	mPausedTicks = 0;
-
-	mPaused = false;
-	mStarted = false;
-}
-
-void LTimer::start()
-{
-	//Start the timer
-	mStarted = true;
-
-	//Unpause the timer
-	mPaused = false;
-
-	//Get the current clock time
-	mStartTicks = SDL_GetTicks();
-		mPausedTicks = 0;
-}
-
-void LTimer::stop()
-{
-	//Stop the timer
-	mStarted = false;
-
-	//Unpaused the timer
-	mPaused = false;
-
-	//Clear tick variables
-	mStartTicks = 0;
-	mPausedTicks = 0;
-}
-
-void LTimer::pause()
-{
-	//IF the timer is running and isn't slready paused
-	if( mStarted && !mPaused )
-	{
-		//Pause the timer
-		mPaused = true;
-
-		//Calculate the paused ticks
-		mPausedTicks = SDL_GetTicks() - mStartTicks;
-			mStartTicks = 0;
-	}
-}
-
-void LTimer::unpause()
-{
-	//If the timer is running and paused
-	if( mStarted && mPaused )
-	{
-		//Unpaused the timer
-		mPaused = false;
-
-		//Reset the starting ticks
-		mStartTicks = SDL_GetTicks() - mPausedTicks;
-
-		//Reset the paused ticks
-		mPausedTicks = 0;
-	}
-}
-
-Uint32 LTimer::getTicks()
-{
-	//The actual timer time
-	Uint32 time = 0;
-
-	//If the timer is running
-	if( mStarted )
-	{
-		//If the timer is paused
-		if( mPaused )
-		{
-			//Return the number of ticks when the timer was paused
-			time = mPausedTicks;
-		}
-		else
-		{
-			//Return the current time minus the start time
-			time = SDL_GetTicks() - mStartTicks;
-		}
-	}
-
-	return time;
-}
-
-bool LTimer::isStarted()
-{
-	//Timer is running and paused or unpaused
-	return mStarted;
-}
-
-bool LTimer::isPaused()
-{
-	//Timer is running and paused
-	return mPaused && mStarted;
-}
+//Font glyphs for text that changes every frame
+GlyphCache gTextCache;
 
 bool init()
 {
@@ -381,7 +57,6 @@ bool init()
 			cout << "Warning: Linear texture filtering not enabled!" << endl;
 		}
 
-
 		//Create window
 		gWindow = SDL_CreateWindow( "SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN );
 		if( gWindow == NULL )
@@ -436,14 +111,23 @@ bool loadMedia()
 		cout << "failed to load lazy font! SDL_ttf Error: %s\n" << TTF_GetError() << endl;
 		success = false;
 	}
+	else
+	{
+		//Render the font's glyphs once
+		if( !gTextCache.load( gRenderer, gFont ) )
+		{
+			cout << "Unable to cache lazy font glyphs!" << endl;
+			success = false;
+		}
+	}
 
 	return success;
 }
 
 void close()
 {
-	//Free loaded image
-	gFPSTextTexture.free();
+	//Free cached glyphs
+	gTextCache.free();
 
 	//Free global font
 	TTF_CloseFont( gFont );
@@ -461,8 +145,15 @@ void close()
 	SDL_Quit();
 }
 
-int main()
+int main( int argc, char* args[] )
 {
+	//Target rate can be given on the command line, like 144 or 240
+	double targetFPS = SCREEN_FPS;
+	if( argc > 1 && atof( args[ 1 ] ) > 0 )
+	{
+		targetFPS = atof( args[ 1 ] );
+	}
+
 	//Start up SDL and create window
 	if( !init() )
 	{
@@ -487,10 +178,10 @@ int main()
 			SDL_Color textColor = { 0, 0, 0, 255 };
 
 			//The framed per second timer
-			LTimer fpsTimer;
+			LTimer fpsTimer( TIMER_PERFORMANCE );
 
-			//The framed per second cap timer
-			LTimer capTimer;
+			//Holds frames to the target rate
+			FramePacer pacer( targetFPS );
 
 			//In memory text stream
 			stringstream timeText;
@@ -498,14 +189,11 @@ int main()
 			//Start counting frames per second
 			int countedFrames = 0;
 			fpsTimer.start();
+			pacer.start();
 
 			//While application is running
 			while( !quit )
 			{
-
-				//Start cap timer
-				capTimer.start();
-
 				//Handle events on queue
 				while( SDL_PollEvent( &e ) != 0 )
 				{
@@ -517,7 +205,7 @@ int main()
 				}
 
 				//Calculated and correct fps
-				float avgFPS = countedFrames / ( fpsTimer.getTicks() / 1000.f );
+				float avgFPS = countedFrames / fpsTimer.getSeconds();
 				if( avgFPS > 2000000 )
 				{
 					avgFPS = 0;
@@ -527,32 +215,27 @@ int main()
 				timeText.str( "" );
 				timeText << "Average frames per Second ( with Cap) " << avgFPS;
 
-				//Render text
-				if( !gFPSTextTexture.loadFromRenderedText( timeText.str().c_str(), textColor ) )
-				{
-					cout << "Unable to render FPS texture!\n" << endl;
-				}
-
 				//Clear screen
 				SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
 
 				SDL_RenderClear( gRenderer );
 
-				//Render texture
-			gFPSTextTexture.render( ( SCREEN_WIDTH - gFPSTextTexture.getWidth() ) / 2, ( SCREEN_HEIGHT - gFPSTextTexture.getHeight() ) / 2 );
+				//Render text from cached glyphs
+				gTextCache.render( gRenderer, timeText.str(), ( SCREEN_WIDTH - gTextCache.getTextWidth( timeText.str() ) ) / 2, ( SCREEN_HEIGHT - gTextCache.getHeight() ) / 2, textColor );
 
 				//Update screen
 				SDL_RenderPresent( gRenderer );
 				++countedFrames;
 
-				//If frame finished early
-				int frameTicks = capTimer.getTicks();
-				if( frameTicks < SCREEN_TICK_PER_FRAME - frameTicks );
-				{
-					//Wait remaining time
-					SDL_Delay( SCREEN_TICK_PER_FRAME - frameTicks );
-				}
+				//Wait out the rest of the frame
+				pacer.wait();
 			}
+
+			//Report how evenly frames were paced
+			FramePacerStats stats = pacer.getStats();
+			cout << "Target " << pacer.getTarget() << " fps, paced " << stats.fps << " fps over " << stats.frames << " frames" << endl;
+			cout << "Frame time mean " << stats.mean << " ms, std dev " << stats.deviation << " ms, p99 " << stats.p99 << " ms, max " << stats.max << " ms" << endl;
+			cout << pacer.getMissedCount() << " frames missed their deadline" << endl;
 		}
 	}
 
@@ -0,0 +1,94 @@
+#include <SDL2/SDL.h>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <math.h>
+#include "../Engine/LTimer.h"
+#include "../Engine/FramePacer.h"
+#include "../Engine/BenchUtil.h"
+
+using namespace std;
+
+//Rates to pace to
+const int BENCH_RATES[] = { 60, 144, 240 };
+const int TOTAL_BENCH_RATES = 3;
+
+//Seconds of frames per run
+const double BENCH_SECONDS = 2.0;
+
+//Ways to wait out a frame
+enum PaceMode
+{
+	PACE_DELAY,
+	PACE_PACER,
+	TOTAL_PACE_MODES
+};
+
+//Mode display names
+const char* PACE_MODE_NAMES[] = { "SDL_Delay cap", "frame pacer" };
+
+//Busy work standing in for a frame's update and render
+void work( LTimer& clock, Uint64 nanoseconds )
+{
+	Uint64 end = clock.getNanoseconds() + nanoseconds;
+	while( clock.getNanoseconds() < end )
+	{
+	}
+}
+
+int main( int argc, char* args[] )
+{
+	cout << "rate\tmode\tfps\tmean ms\tstd dev ms\tp99 ms\tmax ms" << endl;
+
+	for( int r = 0; r < TOTAL_BENCH_RATES; ++r )
+	{
+		int rate = BENCH_RATES[ r ];
+		int frames = (int)( rate * BENCH_SECONDS );
+		Uint64 period = 1000000000ull / rate;
+
+		for( int m = 0; m < TOTAL_PACE_MODES; ++m )
+		{
+			//Same work each run, up to half a frame
+			Uint32 random = 1;
+			LTimer clock( TIMER_PERFORMANCE );
+			clock.start();
+
+			//The sample's old cap, with its stray semicolon fixed
+			LTimer capTimer;
+			int ticksPerFrame = 1000 / rate;
+
+			//A pacer recording frame times for both modes
+			FramePacer pacer( rate, frames );
+			FramePacer recorder( 0, frames );
+			pacer.start();
+			recorder.start();
+
+			for( int f = 0; f < frames; ++f )
+			{
+				capTimer.start();
+				work( clock, nextRandom( random ) % ( period / 2 ) );
+
+				if( m == PACE_DELAY )
+				{
+					int frameTicks = capTimer.getTicks();
+					if( frameTicks < ticksPerFrame )
+					{
+						SDL_Delay( ticksPerFrame - frameTicks );
+					}
+				}
+				else
+				{
+					pacer.wait();
+				}
+
+				//Never waits, just keeps the time since the last frame
+				recorder.wait();
+			}
+
+			FramePacerStats stats = recorder.getStats();
+			cout << rate << "\t" << PACE_MODE_NAMES[ m ] << "\t" << stats.fps << "\t" << stats.mean << "\t" << stats.deviation << "\t" << stats.p99 << "\t" << stats.max << endl;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,275 @@
+#include <SDL2/SDL.h>
+#include <vector>
+#include <iostream>
+#include "../Engine/GameLoop.h"
+#include "../Engine/BenchUtil.h"
+
+using namespace std;
+
+//Same screen and dots as the sample
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+const int DOT_WIDTH = 20;
+const int DOT_HEIGHT = 20;
+const int DOT_VEL = 10;
+
+//Simulation rate and length
+const int STEPS_PER_SECOND = 60;
+const int SIM_SECONDS = 10;
+const int SIM_STEPS = STEPS_PER_SECOND * SIM_SECONDS;
+
+//Dots moved each step, and how often the scripted input turns them
+const int SIM_DOTS = 1000;
+const int TURN_STEPS = 37;
+
+//Render rates to compare
+const int RENDER_RATES[] = { 30, 60, 240 };
+const int TOTAL_RENDER_RATES = 3;
+
+//Scripted frame check, a step rate and frame times in whole units of 1 / CHECK_UNITS seconds so every sum is exact in a double
+const int CHECK_STEPS_PER_SECOND = 64;
+const int CHECK_UNITS = 1024;
+const int CHECK_MAX_STEPS = 8;
+const int CHECK_SECONDS = 4;
+
+//Units added to or taken from each frame time in turn
+const int CHECK_JITTER[] = { 0, 3, -2, 1, -1, 5, -3, 0, 2, -4 };
+const int TOTAL_CHECK_JITTER = 10;
+
+//A one second hitch halfway through, far more than the step limit catches up on
+const int HITCH_UNITS = CHECK_UNITS;
+
+//A dot moved like the sample's
+struct Mover
+{
+	int x, y;
+	int velX, velY;
+};
+
+//Every dot and where the run is
+struct Simulation
+{
+	vector<Mover> movers;
+	int step;
+	Uint32 checksum;
+};
+
+//Scripted input, the same dots turn on the same steps however frames are drawn
+void turn( Simulation& simulation, int step )
+{
+	Uint32 random = (Uint32)step * 2654435761u + 1;
+	for( int i = 0; i < (int)simulation.movers.size(); ++i )
+	{
+		Mover& mover = simulation.movers[ i ];
+		mover.velX = ( (int)( nextRandom( random ) % 3 ) - 1 ) * DOT_VEL;
+		mover.velY = ( (int)( nextRandom( random ) % 3 ) - 1 ) * DOT_VEL;
+	}
+}
+
+//Dot::move from the sample, undoing moves off screen
+void move( Mover& mover )
+{
+	mover.x += mover.velX;
+	if( mover.x < 0 || mover.x + DOT_WIDTH > SCREEN_WIDTH )
+	{
+		mover.x -= mover.velX;
+	}
+	mover.y += mover.velY;
+	if( mover.y < 0 || mover.y + DOT_HEIGHT > SCREEN_HEIGHT )
+	{
+		mover.y -= mover.velY;
+	}
+}
+
+//Hash of every dot's position
+Uint32 getChecksum( Simulation& simulation )
+{
+	Uint32 hash = 2166136261u;
+	for( int i = 0; i < (int)simulation.movers.size(); ++i )
+	{
+		hash = ( hash ^ (Uint32)simulation.movers[ i ].x ) * 16777619u;
+		hash = ( hash ^ (Uint32)simulation.movers[ i ].y ) * 16777619u;
+	}
+	return hash;
+}
+
+//One fixed step of the simulation passed as data, stops once the run is done
+void stepSimulation( void* data )
+{
+	Simulation& simulation = *(Simulation*)data;
+	if( simulation.step >= SIM_STEPS )
+	{
+		return;
+	}
+
+	if( simulation.step % TURN_STEPS == 0 )
+	{
+		turn( simulation, simulation.step );
+	}
+	for( int i = 0; i < (int)simulation.movers.size(); ++i )
+	{
+		move( simulation.movers[ i ] );
+	}
+
+	++simulation.step;
+	if( simulation.step == SIM_STEPS )
+	{
+		simulation.checksum = getChecksum( simulation );
+	}
+}
+
+//Same starting dots for every run
+void reset( Simulation& simulation )
+{
+	simulation.movers.assign( SIM_DOTS, Mover() );
+	Uint32 random = 1;
+	for( int i = 0; i < SIM_DOTS; ++i )
+	{
+		simulation.movers[ i ].x = (int)( nextRandom( random ) % ( SCREEN_WIDTH - DOT_WIDTH ) );
+		simulation.movers[ i ].y = (int)( nextRandom( random ) % ( SCREEN_HEIGHT - DOT_HEIGHT ) );
+		simulation.movers[ i ].velX = 0;
+		simulation.movers[ i ].velY = 0;
+	}
+	simulation.step = 0;
+	simulation.checksum = 0;
+}
+
+//What one run did
+struct RunResult
+{
+	int frames;
+	Uint64 steps;
+	double seconds;
+	Uint32 checksum;
+};
+
+//Runs the simulation with frames drawn at rate, through the fixed step loop or the old one move per frame loop
+RunResult run( Simulation& simulation, int rate, bool fixed )
+{
+	RunResult result = { 0, 0, 0, 0 };
+	reset( simulation );
+
+	if( fixed )
+	{
+		//Frames of 1 / rate seconds until the simulation has run its steps
+		GameLoop loop( STEPS_PER_SECOND );
+		while( simulation.step < SIM_STEPS )
+		{
+			loop.advance( 1.0 / rate, stepSimulation, &simulation );
+			++result.frames;
+		}
+		result.steps = loop.getStepCount();
+		result.seconds = loop.getStepSeconds();
+	}
+	else
+	{
+		//One move per frame over the same time, turning on the first frame at or after each scripted step
+		Uint64 start = SDL_GetPerformanceCounter();
+		int nextTurn = 0;
+		for( result.frames = 0; result.frames < rate * SIM_SECONDS; ++result.frames )
+		{
+			if( result.frames * STEPS_PER_SECOND >= nextTurn * rate )
+			{
+				turn( simulation, nextTurn );
+				nextTurn += TURN_STEPS;
+			}
+			for( int i = 0; i < SIM_DOTS; ++i )
+			{
+				move( simulation.movers[ i ] );
+			}
+		}
+		simulation.checksum = getChecksum( simulation );
+		result.steps = result.frames;
+		result.seconds = (double)( SDL_GetPerformanceCounter() - start ) / SDL_GetPerformanceFrequency();
+	}
+
+	result.checksum = simulation.checksum;
+	return result;
+}
+
+//Feeds uneven frame times through the loop and checks it against the accumulator worked out in whole units
+bool checkRate( Simulation& simulation, Simulation& expected, int rate )
+{
+	reset( simulation );
+	reset( expected );
+	GameLoop loop( CHECK_STEPS_PER_SECOND, CHECK_MAX_STEPS );
+
+	int stepUnits = CHECK_UNITS / CHECK_STEPS_PER_SECOND;
+	int accumulator = 0;
+	Uint64 expectedSteps = 0;
+	int expectedDropped = 0;
+	bool alphaValid = true;
+	int frames = rate * CHECK_SECONDS;
+	for( int frame = 0; frame < frames; ++frame )
+	{
+		int units = CHECK_UNITS / rate + CHECK_JITTER[ frame % TOTAL_CHECK_JITTER ];
+		if( frame == frames / 2 )
+		{
+			units += HITCH_UNITS;
+		}
+		loop.advance( (double)units / CHECK_UNITS, stepSimulation, &simulation );
+
+		//Whole steps up to the limit, and time past the limit is dropped
+		accumulator += units;
+		int steps = accumulator / stepUnits < CHECK_MAX_STEPS ? accumulator / stepUnits : CHECK_MAX_STEPS;
+		accumulator -= steps * stepUnits;
+		if( accumulator >= stepUnits )
+		{
+			accumulator = 0;
+			++expectedDropped;
+		}
+		for( int i = 0; i < steps; ++i )
+		{
+			stepSimulation( &expected );
+		}
+		expectedSteps += steps;
+
+		double alpha = loop.getAlpha();
+		if( alpha < 0 || alpha >= 1 || alpha != (double)accumulator / stepUnits )
+		{
+			alphaValid = false;
+		}
+	}
+
+	bool stateMatches = simulation.step == expected.step && getChecksum( simulation ) == getChecksum( expected );
+	bool success = loop.getStepCount() == expectedSteps && loop.getDroppedFrames() == expectedDropped && stateMatches && alphaValid;
+	cout << rate << "\t" << frames << "\t" << loop.getStepCount() << "/" << expectedSteps << "\t" << loop.getDroppedFrames() << "/" << expectedDropped << "\t";
+	cout << ( stateMatches ? "yes" : "no" ) << "\t" << ( alphaValid ? "yes" : "no" ) << endl;
+	return success;
+}
+
+int main( int argc, char* args[] )
+{
+	//Uneven frames, hitch included, must run exactly the steps the accumulator allows
+	cout << "render fps\tframes\tsteps/expected\tdropped/expected\tstate matches\talpha in [0,1)" << endl;
+	Simulation checked;
+	Simulation expected;
+	bool success = true;
+	for( int r = 0; r < TOTAL_RENDER_RATES; ++r )
+	{
+		success = checkRate( checked, expected, RENDER_RATES[ r ] ) && success;
+	}
+	if( !success )
+	{
+		cout << "Fixed step loop does not match its accumulator!" << endl;
+		return 1;
+	}
+	cout << endl;
+
+	cout << "render fps\tloop\tframes\tsteps\tchecksum\tmatches 60 fps\tus CPU/step" << endl;
+
+	Simulation simulation;
+	for( int fixed = 1; fixed >= 0; --fixed )
+	{
+		RunResult reference = run( simulation, STEPS_PER_SECOND, fixed != 0 );
+		for( int r = 0; r < TOTAL_RENDER_RATES; ++r )
+		{
+			RunResult result = RENDER_RATES[ r ] == STEPS_PER_SECOND ? reference : run( simulation, RENDER_RATES[ r ], fixed != 0 );
+			cout << RENDER_RATES[ r ] << "\t" << ( fixed ? "fixed step" : "per frame" ) << "\t" << result.frames << "\t" << result.steps << "\t";
+			cout << hex << result.checksum << dec << "\t" << ( result.checksum == reference.checksum ? "yes" : "no" ) << "\t";
+			cout << result.seconds / result.steps * 1000000.0 << endl;
+		}
+	}
+
+	return 0;
+}
@@ -3,6 +3,8 @@
 #include <stdio.h>
 #include <string>
 #include <iostream>
+#include "../Engine/LTexture.h"
+#include "../Engine/GameLoop.h"
 
 using namespace std;
 
@@ -10,83 +12,8 @@ using namespace std;
 const int SCREEN_WIDTH = 640;
 const int SCREEN_HEIGHT = 480;
 
-//Texture wrapper class
-class LTexture
-{
-	public:
-		//Initializes variables
-		LTexture();
-
-		//Deallocates memory
-		~LTexture();
-
-		//Loads image at specified path
-		bool loadFromFile( string path );
-
-		#ifdef _SDL_TTF_H
-		//Creates image from font string
-		bool loadFromRenderedText( string textureText, SDL_Color textColor );
-		#endif
-
-		//Deallocates texture
-		void free();
-
-		//set color modulation
-		void setColor( Uint8 red, Uint8 green, Uint8 blue );
-
-		//Set Blending
-		void setBlendMode( SDL_BlendMode blending );
-
-		//Set alpha modulation
-		void setAlpha( Uint8 alpha );
-
-		//Renders texture at given point
-		void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
-
-		//Gets image dimensions
-		int getWidth();
-		int getHeight();
-
-	private:
-		//The actual hardware texture
-		SDL_Texture* mTexture;
-
-		//Image dimensions
-		int mWidth;
-		int mHeight;
-};
-
-//The application time based timer
-class LTimer
-{
-	public:
-		//Initializes variable
-		LTimer();
-
-		//The various clock actions
-		void start();
-		void stop();
-		void pause();
-		void unpause();
-
-		//Gets the timer's time
-		Uint32 getTicks();
-
-		//Checks the status of the timer
-		bool isStarted();
-		bool isPaused();
-
-	private:
-		//The clock time when the timer started
-		Uint32 mStartTicks;
-
-		//The ticks stored when the timer was paused
-		Uint32 mPausedTicks;
-
-		//The timer status
-		bool mPaused;
-		bool mStarted;
-};
+//Simulation steps per second, the dot moves the same however fast frames are drawn
+const int STEPS_PER_SECOND = 60;
 
 //The dot that will move around on the screen
 class Dot
@@ -96,7 +23,7 @@ class Dot
 		static const int DOT_WIDTH = 20;
 		static const int DOT_HEIGHT = 20;
 
-		//Maximum axis velocity of the dot
+		//Maximum axis velocity of the dot in pixels per step
 		static const int DOT_VEL = 10;
 
 		//Initializes the variables
@@ -105,16 +32,19 @@ class Dot
 		//Takes key presses and adjusts the dot's velocity
 		void handleEvent( SDL_Event& e );
 
-		//Moves the dot
+		//Moves the dot one simulation step
 		void move();
 
-		//Shows the dot on the screen
-		void render();
+		//Shows the dot on the screen alpha of the way from its last step to its current one
+		void render( double alpha );
 
 	private:
 		//The X and Y offsets of the dot
 		int mPosX, mPosY;
 
+		//The offsets before the last step
+		int mPrevX, mPrevY;
+
 		//The velocity of the dot
 		int mVelX, mVelY;
 };
@@ -137,158 +67,13 @@ SDL_Renderer* gRenderer = NULL;
 //Scene textures
 LTexture gDotTexture;
 
-LTexture::LTexture()
-{
-	//Initialize
-	mTexture = NULL;
-	mWidth = 0;
-	mHeight = 0;
-}
-
-LTexture::~LTexture()
-{
-	//Deallocate
-	free();
-}
-
-bool LTexture::loadFromFile( string path )
-{
-	//Get rid of preexisting texture
-	free();
-
-	//The final texture
-	SDL_Texture* newTexture = NULL;
-
-	//Load image at specified path
-	SDL_Surface* loadedSurface = IMG_Load( path.c_str() );
-	if( loadedSurface == NULL )
-	{
-		cout << "Unable to load image %s! SDL_image Error: %s\n" << path.c_str() << IMG_GetError() << endl;
-	}
-	else
-	{
-		//Color key image
-		SDL_SetColorKey( loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ) );
-
-		//Create texture from surface pixels
-	newTexture = SDL_CreateTextureFromSurface( gRenderer, loadedSurface );
-		if( newTexture == NULL )
-		{
-			cout << "Unable to create texture from %s! SDL Error %s\n" << path.c_str() << SDL_GetError() << endl;
-		}
-		else
-		{
-			//Get image dimensions
-			mWidth = loadedSurface->w;
-			mHeight = loadedSurface->h;
-		}
-
-		//Get rid of old loaded surface
-		SDL_FreeSurface( loadedSurface );
-	}
-
-	//Return success
-	mTexture = newTexture;
-	return mTexture != NULL;
-}
-
-#ifdef _SDL_TTF_H
-bool LTexture::loadFromRenderedText( string textureText, SDL_Color textColor )
-{
-	//Get rid of preexisting texture
-	free();
-
-	//Render text surface
-	SDL_Surface* textSurface = TTF_RenderText_Solid( gFont, textureText.c_str(), textColor );
-	if( textSurface != NULL )
-	{
-		//Create texture from surface pixels
-	mTexture = SDL_CreateTextureFromSurface( gRenderer, textSurface );
-		if( mTexture == NULL )
-		{
-		cout << "Unable to create texture from rendered text! SDL Error: %s\n" << SDL_GetError() << endl;
-		}
-		else
-		{
-			//Get image dimensions
-			mWidth = textSurface->w;
-			mHeight = textSurface->h;
-		}
-
-		//Get rid of old surface
-		SDL_FreeSurface( textSurface );
-	}
-	else
-	{
-		cout << "Unable to render text Surface! SDL_ttf Error: %s\n" << TTF_GetError() << endl;
-	}
-
-	//Return success
-	return mTexture != NULL;
-}
-#endif
-
-void LTexture::free()
-{
-	//Free texture if it exists
-	if( mTexture != NULL )
-	{
-		SDL_DestroyTexture( mTexture );
-		mTexture = NULL;
-		mWidth = 0;
-		mHeight = 0;
-	}
-}
-
-void LTexture::setColor( Uint8 red, Uint8 green, Uint8 blue )
-{
-	//Modulate texture rgb
-	SDL_SetTextureColorMod( mTexture, red, green, blue );
-}
-
-void LTexture::setBlendMode( SDL_BlendMode blending )
-{
-	//Set blending function
-	SDL_SetTextureBlendMode( mTexture, blending );
-}
-
-void LTexture::setAlpha( Uint8 alpha )
-{
-	//Modulate texture alpha
-	SDL_SetTextureAlphaMod( mTexture, alpha );
-}
-
-void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip )
-{
-	//Set rendering space and render to screen
-	SDL_Rect renderQuad = { x, y, mWidth, mHeight };
-
-	//Set clip rending dimensions
-	if( clip != NULL )
-	{
-		renderQuad.w = clip->w;
-		renderQuad.h = clip->h;
-	}
-
-	//Render to screen
-	SDL_RenderCopyEx( gRenderer, mTexture, clip, &renderQuad, angle, center, flip );
-}
-
-int LTexture::getWidth()
-{
-	return mWidth;
-}
-
-int LTexture::getHeight()
-{
-	return mHeight;
-}
-
 Dot::Dot()
 {
 	//Initailize the offset
 	mPosX = 0;
 	mPosY = 0;
+	mPrevX = 0;
+	mPrevY = 0;
 
 	//Initialize the velocity
 	mVelX = 0;
@@ -325,6 +110,10 @@ void Dot::handleEvent( SDL_Event& e )
 
 void Dot::move()
 {
+	//Remember where the step started for rendering
+	mPrevX = mPosX;
+	mPrevY = mPosY;
+
 	//Move the dot left or right
 	mPosX += mVelX;
 
@@ -346,10 +135,18 @@ void Dot::move()
 	}
 }
 
-void Dot::render()
+void Dot::render( double alpha )
+{
+	//Show dot between its last two steps
+	int x = (int)( interpolate( mPrevX, mPosX, alpha ) + 0.5 );
+	int y = (int)( interpolate( mPrevY, mPosY, alpha ) + 0.5 );
+	gDotTexture.render( x, y );
+}
+
+//Steps the dot passed as data
+void stepDot( void* data )
 {
-	//Show dot
-	gDotTexture.render( mPosX, mPosY );
+	( (Dot*)data )->move();
 }
 
 bool init()
@@ -371,7 +168,6 @@ bool init()
 			cout << "Warning: Linear texture filtering not enabled!" << endl;
 		}
 
-
 		//Create window
 		gWindow = SDL_CreateWindow( "SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN );
 		if( gWindow == NULL )
@@ -463,6 +259,10 @@ int main()
 			//The dot that will be moving around on the screen
 			Dot dot;
 
+			//Fixed step simulation driver
+			GameLoop loop( STEPS_PER_SECOND );
+			loop.start();
+
 			//While application is running
 			while( !quit )
 			{
@@ -479,20 +279,26 @@ int main()
 					dot.handleEvent( e );
 				}
 
-				//Move the dot
-				dot.move();
+				//Move the dot as many steps as real time has covered
+				loop.advance( stepDot, &dot );
 
 				//Clear screen
 				SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
 
 				SDL_RenderClear( gRenderer );
 
-				//Render objects
-				dot.render();
+				//Render objects between steps
+				dot.render( loop.getAlpha() );
 
 				//Update screen
 				SDL_RenderPresent( gRenderer );
 			}
+
+			//Report simulation cost
+			if( loop.getStepCount() > 0 )
+			{
+				cout << loop.getStepCount() << " steps, " << loop.getStepSeconds() / loop.getStepCount() * 1000000.0 << " us CPU per step, " << loop.getDroppedFrames() << " frames dropped time" << endl;
+			}
 		}
 	}
 
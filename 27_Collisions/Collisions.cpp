@@ -2,7 +2,11 @@
 #include <SDL2/SDL_image.h>
 #include <stdio.h>
 #include <string>
+#include <vector>
 #include <iostream>
+#include "../Engine/LTexture.h"
+#include "../Engine/SpatialHash.h"
+#include "../Engine/Sweep.h"
 
 using namespace std;
 
@@ -10,51 +14,8 @@ using namespace std;
 const int SCREEN_WIDTH = 640;
 const int SCREEN_HEIGHT = 480;
 
-//Texture wrapper class
-class LTexture
-{
-	public:
-		//Initializes variables
-		LTexture();
-
-		//Deallocates memory
-		~LTexture();
-
-		//Loads image at specified path
-		bool loadFromFile( string path );
-
-		#ifdef _SDL_TTF_H
-		//Creates image from font string
-		bool loadFromRenderedText( string textureText, SDL_Color textColor );
-		#endif
-
-		//Deallocates texture
-		void free();
-
-		//set color modulation
-		void setColor( Uint8 red, Uint8 green, Uint8 blue );
-
-		//Set Blending
-		void setBlendMode( SDL_BlendMode blending );
-
-		//Set alpha modulation
-		void setAlpha( Uint8 alpha );
-
-		//Renders texture at given point
-		void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
-
-		//Gets image dimensions
-		int getWidth();
-		int getHeight();
-
-	private:
-		//The actual hardware texture
-		SDL_Texture* mTexture;
-
-		//Image dimensions
-		int mWidth;
-		int mHeight;
-};
+//Broad phase cell size
+const int COLLISION_CELL_SIZE = 80;
 
 //The dot that will move around on the screen
 class Dot
@@ -73,8 +34,8 @@ class Dot
 		//Takes key presses and adjusts the dot's velocity
 		void handleEvent( SDL_Event& e );
 
-		//Moves the dot and checks collision
-		void move( SDL_Rect& wall );
+		//Moves the dot up to the first wall the broad phase finds in its way on each axis
+		void move( vector<SDL_Rect>& walls, SpatialHash& colliders );
 
 		//Shows the dot on the screen
 		void render();
@@ -99,8 +60,8 @@ bool loadMedia();
 //Frees media and shuts down SDL
 void close();
 
-//Box collision detector
-bool checkCollision( SDL_Rect a, SDL_Rect b );
+//Sweeps the box against the walls near its path, true with the earliest contact if it hits one
+bool sweepWalls( SDL_Rect box, int velX, int velY, vector<SDL_Rect>& walls, SpatialHash& colliders, SweepHit& hit );
 
 //The window we'll be rendering to
 SDL_Window* gWindow = NULL;
@@ -111,153 +72,6 @@ SDL_Renderer* gRenderer = NULL;
 //Scene textures
 LTexture gDotTexture;
 
-LTexture::LTexture()
-{
-	//Initialize
-	mTexture = NULL;
-	mWidth = 0;
-	mHeight = 0;
-}
-
-LTexture::~LTexture()
-{
-	//Deallocate
-	free();
-}
-
-bool LTexture::loadFromFile( string path )
-{
-	//Get rid of preexisting texture
-	free();
-
-	//The final texture
-	SDL_Texture* newTexture = NULL;
-
-	//Load image at specified path
-	SDL_Surface* loadedSurface = IMG_Load( path.c_str() );
-	if( loadedSurface == NULL )
-	{
-		cout << "Unable to load image %s! SDL_image Error: %s\n" << path.c_str() << IMG_GetError() << endl;
-	}
-	else
-	{
-		//Color key image
-		SDL_SetColorKey( loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ) );
-
-		//Create texture from surface pixels
-	newTexture = SDL_CreateTextureFromSurface( gRenderer, loadedSurface );
-		if( newTexture == NULL )
-		{
-			cout << "Unable to create texture from %s! SDL Error %s\n" << path.c_str() << SDL_GetError() << endl;
-		}
-		else
-		{
-			//Get image dimensions
-			mWidth = loadedSurface->w;
-			mHeight = loadedSurface->h;
-		}
-
-		//Get rid of old loaded surface
-		SDL_FreeSurface( loadedSurface );
-	}
-
-	//Return success
-	mTexture = newTexture;
-	return mTexture != NULL;
-}
-
-#ifdef _SDL_TTF_H
-bool LTexture::loadFromRenderedText( string textureText, SDL_Color textColor )
-{
-	//Get rid of preexisting texture
-	free();
-
-	//Render text surface
-	SDL_Surface* textSurface = TTF_RenderText_Solid( gFont, textureText.c_str(), textColor );
-	if( textSurface != NULL )
-	{
-		//Create texture from surface pixels
-	mTexture = SDL_CreateTextureFromSurface( gRenderer, textSurface );
-		if( mTexture == NULL )
-		{
-		cout << "Unable to create texture from rendered text! SDL Error: %s\n" << SDL_GetError() << endl;
-		}
-		else
-		{
-			//Get image dimensions
-			mWidth = textSurface->w;
-			mHeight = textSurface->h;
-		}
-
-		//Get rid of old surface
-		SDL_FreeSurface( textSurface );
-	}
-	else
-	{
-		cout << "Unable to render text Surface! SDL_ttf Error: %s\n" << TTF_GetError() << endl;
-	}
-
-	//Return success
-	return mTexture != NULL;
-}
-#endif
-
-void LTexture::free()
-{
-	//Free texture if it exists
-	if( mTexture != NULL )
-	{
-		SDL_DestroyTexture( mTexture );
-		mTexture = NULL;
-		mWidth = 0;
-		mHeight = 0;
-	}
-}
-
-void LTexture::setColor( Uint8 red, Uint8 green, Uint8 blue )
-{
-	//Modulate texture rgb
-	SDL_SetTextureColorMod( mTexture, red, green, blue );
-}
-
-void LTexture::setBlendMode( SDL_BlendMode blending )
-{
-	//Set blending function
-	SDL_SetTextureBlendMode( mTexture, blending );
-}
-
-void LTexture::setAlpha( Uint8 alpha )
-{
-	//Modulate texture alpha
-	SDL_SetTextureAlphaMod( mTexture, alpha );
-}
-
-void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip )
-{
-	//Set rendering space and render to screen
-	SDL_Rect renderQuad = { x, y, mWidth, mHeight };
-
-	//Set clip rending dimensions
-	if( clip != NULL )
-	{
-		renderQuad.w = clip->w;
-		renderQuad.h = clip->h;
-	}
-
-	//Render to screen
-	SDL_RenderCopyEx( gRenderer, mTexture, clip, &renderQuad, angle, center, flip );
-}
-
-int LTexture::getWidth()
-{
-	return mWidth;
-}
-
-int LTexture::getHeight()
-{
-	return mHeight;
-}
-
 Dot::Dot()
 {
 	//Initailize the offset
@@ -268,6 +82,10 @@ Dot::Dot()
 		mCollider.w = DOT_WIDTH;
 		mCollider.h = DOT_HEIGHT;
 
+	//Start the collision box on the dot, moves sweep from it
+	mCollider.x = mPosX;
+	mCollider.y = mPosY;
+
 	//Initialize the velocity
 	mVelX = 0;
 	mVelY = 0;
@@ -301,31 +119,36 @@ void Dot::handleEvent( SDL_Event& e )
 	}
 }
 
-void Dot::move( SDL_Rect& wall )
+void Dot::move( vector<SDL_Rect>& walls, SpatialHash& colliders )
 {
-	//Move the dot left or right
-	mPosX += mVelX;
-		mCollider.x = mPosX;
+	//Move the dot left or right, stopping against a wall instead of short of it
+	SweepHit hit;
+	mPosX += sweepWalls( mCollider, mVelX, 0, walls, colliders, hit ) ? getSweepTravel( mVelX, hit ) : mVelX;
 
-	//If the dot went too far left or right
-	if( (mPosX < 0 ) || (mPosX + DOT_WIDTH > SCREEN_WIDTH ) || checkCollision( mCollider, wall ) )
+	//Keep the dot on the screen
+	if( mPosX < 0 )
 	{
-		//Move back
-		mPosX -= mVelX;
-			mCollider.x = mPosX;
+		mPosX = 0;
 	}
+	else if( mPosX + DOT_WIDTH > SCREEN_WIDTH )
+	{
+		mPosX = SCREEN_WIDTH - DOT_WIDTH;
+	}
+	mCollider.x = mPosX;
 
 	//Move the dot up or down
-	mPosY += mVelY;
-		mCollider.y = mPosY;
+	mPosY += sweepWalls( mCollider, 0, mVelY, walls, colliders, hit ) ? getSweepTravel( mVelY, hit ) : mVelY;
 
-	//If the dot went too far up or down
-	if( ( mPosY < 0 ) || ( mPosY + DOT_HEIGHT > SCREEN_HEIGHT ) || checkCollision( mCollider, wall ) )
+	//Keep the dot on the screen
+	if( mPosY < 0 )
+	{
+		mPosY = 0;
+	}
+	else if( mPosY + DOT_HEIGHT > SCREEN_HEIGHT )
 	{
-		//Move back
-		mPosY -= mVelY;
-			mCollider.y = mPosY;
+		mPosY = SCREEN_HEIGHT - DOT_HEIGHT;
 	}
+	mCollider.y = mPosY;
 }
 
 void Dot::render()
@@ -353,7 +176,6 @@ bool init()
 			cout << "Warning: Linear texture filtering not enabled!" << endl;
 		}
 
-
 		//Create window
 		gWindow = SDL_CreateWindow( "SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN );
 		if( gWindow == NULL )
@@ -420,49 +242,25 @@ void close()
 	SDL_Quit();
 }
 
-bool checkCollision( SDL_Rect a, SDL_Rect b )
+bool sweepWalls( SDL_Rect box, int velX, int velY, vector<SDL_Rect>& walls, SpatialHash& colliders, SweepHit& hit )
 {
-	//The sides of the rectangles
-	int leftA, leftB;
-	int rightA, rightB;
-	int topA, topB;
-	int bottomA, bottomB;
-
-	//Calculate the side of rect a
-	leftA = a.x;
-	rightA = a.x + a.w;
-	topA = a.y;
-	bottomA = a.y + a.h;
-
-	//Calculate the sides of rect B
-	leftB = b.x;
-	rightB = b.x + b.w;
-	topB = b.y;
-	bottomB = b.y + b.h;
-
-	//If any of the sides from A are outside of B
-	if( bottomA <= topB )
-	{
-		return false;
-	}
-
-	if( topA >= bottomB )
-	{
-		return false;
-	}
-
-	if( rightA <= leftB )
-	{
-		return false;
-	}
+	//Only walls near the path reach the sweep, however fast the box goes
+	static vector<int> nearby;
+	colliders.query( getSweepBounds( box, velX, velY ), nearby );
 
-	if( leftA >= rightB )
+	//Keep the earliest contact
+	bool found = false;
+	for( int i = 0; i < (int)nearby.size(); ++i )
 	{
-		return false;
+		SweepHit contact;
+		if( sweepBox( box, velX, velY, walls[ nearby[ i ] ], contact ) && ( !found || contact.time < hit.time ) )
+		{
+			hit = contact;
+			found = true;
+		}
 	}
 
-	//If none of the sides from A are outside B
-	return true;
+	return found;
 }
 
 int main()
@@ -497,6 +295,15 @@ int main()
 			wall.w = 40;
 			wall.h = 400;
 
+			//Walls never move, so they go into the broad phase once
+			vector<SDL_Rect> walls;
+			walls.push_back( wall );
+			SpatialHash colliders( COLLISION_CELL_SIZE );
+			for( int i = 0; i < (int)walls.size(); ++i )
+			{
+				colliders.insert( i, walls[ i ] );
+			}
+
 			//While application is running
 			while( !quit )
 			{
@@ -514,7 +321,7 @@ int main()
 				}
 
 				//Move the dot and check collision
-				dot.move( wall );
+				dot.move( walls, colliders );
 
 				//Clear screen
 				SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
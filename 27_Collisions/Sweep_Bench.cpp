@@ -0,0 +1,310 @@
+#include <SDL2/SDL.h>
+#include <vector>
+#include <iostream>
+#include "../Engine/SpatialHash.h"
+#include "../Engine/Sweep.h"
+#include "../Engine/BenchUtil.h"
+
+using namespace std;
+
+//Square level walled in, with a short vertical and horizontal wall in every cell
+const int LEVEL_SIZE = 2048;
+const int WALL_CELL = 64;
+const int WALL_LENGTH = 48;
+const int WALL_THICKNESS = 4;
+
+//Same dots as the sample, moving much faster
+const int DOT_SIZE = 20;
+const int MAX_DOT_VEL = 40;
+
+//Dots and frames per run
+const int BENCH_DOTS = 1000;
+const int BENCH_FRAMES = 200;
+
+//Ways to move dots
+enum MoveMode
+{
+	MOVE_BOX_UNDO,
+	MOVE_BOX_SWEEP,
+	MOVE_CIRCLE_UNDO,
+	MOVE_CIRCLE_SWEEP,
+	TOTAL_MOVE_MODES
+};
+
+//Mode display names
+const char* MOVE_MODE_NAMES[] = { "box undo", "box sweep", "circle undo", "circle sweep" };
+
+//A moving dot
+struct Mover
+{
+	SDL_Rect box;
+	int velX, velY;
+};
+
+//What a run did
+struct MoveStats
+{
+	//Axis moves tried
+	long moves;
+
+	//Moves stopped by a wall
+	long blocked;
+
+	//Moves that jumped over a wall, and blocked moves that stopped before reaching the wall
+	long tunneled;
+	long stoppedShort;
+
+	//Moves that ended inside a wall
+	long overlapping;
+};
+
+//Box collision detector, as in the sample
+bool checkCollision( SDL_Rect a, SDL_Rect b )
+{
+	return !( a.y + a.h <= b.y || a.y >= b.y + b.h || a.x + a.w <= b.x || a.x >= b.x + b.w );
+}
+
+//Box or circle inside box against a wall
+bool touches( bool circle, SDL_Rect& box, SDL_Rect& wall )
+{
+	if( !circle )
+	{
+		return checkCollision( box, wall );
+	}
+
+	//Circle/Box collision detector, as in the circular collision sample
+	int r = box.w / 2;
+	int x = box.x + r;
+	int y = box.y + r;
+	int cX = x < wall.x ? wall.x : ( x > wall.x + wall.w ? wall.x + wall.w : x );
+	int cY = y < wall.y ? wall.y : ( y > wall.y + wall.h ? wall.y + wall.h : y );
+	return ( x - cX ) * ( x - cX ) + ( y - cY ) * ( y - cY ) < r * r;
+}
+
+//Sweeps a box or the circle inside it against a wall
+bool sweepShape( bool circle, SDL_Rect& box, int velX, int velY, SDL_Rect& wall, SweepHit& hit )
+{
+	if( !circle )
+	{
+		return sweepBox( box, velX, velY, wall, hit );
+	}
+
+	int r = box.w / 2;
+	return sweepCircle( box.x + r, box.y + r, r, velX, velY, wall, hit );
+}
+
+//Same starting dots for every run
+vector<Mover> makeMovers( vector<SDL_Rect>& walls )
+{
+	vector<Mover> movers;
+	Uint32 random = 1;
+	while( (int)movers.size() < BENCH_DOTS )
+	{
+		Mover mover;
+		mover.box.x = (int)( nextRandom( random ) % ( LEVEL_SIZE - DOT_SIZE ) );
+		mover.box.y = (int)( nextRandom( random ) % ( LEVEL_SIZE - DOT_SIZE ) );
+		mover.box.w = DOT_SIZE;
+		mover.box.h = DOT_SIZE;
+		mover.velX = (int)( nextRandom( random ) % ( MAX_DOT_VEL * 2 + 1 ) ) - MAX_DOT_VEL;
+		mover.velY = (int)( nextRandom( random ) % ( MAX_DOT_VEL * 2 + 1 ) ) - MAX_DOT_VEL;
+
+		//Start clear of every wall
+		bool clear = true;
+		for( int i = 0; i < (int)walls.size() && clear; ++i )
+		{
+			clear = !checkCollision( mover.box, walls[ i ] );
+		}
+		if( clear )
+		{
+			movers.push_back( mover );
+		}
+	}
+	return movers;
+}
+
+//Earliest wall contact along a move
+bool sweepWalls( bool circle, SDL_Rect box, int velX, int velY, vector<SDL_Rect>& walls, SpatialHash& colliders, vector<int>& nearby, SweepHit& hit )
+{
+	colliders.query( getSweepBounds( box, velX, velY ), nearby );
+	bool found = false;
+	for( int i = 0; i < (int)nearby.size(); ++i )
+	{
+		SweepHit contact;
+		if( sweepShape( circle, box, velX, velY, walls[ nearby[ i ] ], contact ) && ( !found || contact.time < hit.time ) )
+		{
+			hit = contact;
+			found = true;
+		}
+	}
+	return found;
+}
+
+//Steps a move one pixel at a time against the walls near it, the reference the other modes are audited with
+//Returns whether the move runs into a wall, travel is how many pixels of it are clear
+bool stepWalls( bool circle, SDL_Rect box, int velX, int velY, vector<SDL_Rect>& walls, SpatialHash& colliders, vector<int>& nearby, int& travel )
+{
+	int speed = velX != 0 ? ( velX < 0 ? -velX : velX ) : ( velY < 0 ? -velY : velY );
+	int stepX = velX < 0 ? -1 : ( velX > 0 ? 1 : 0 );
+	int stepY = velY < 0 ? -1 : ( velY > 0 ? 1 : 0 );
+
+	//Walls anywhere between the start and the end of the move
+	SDL_Rect bounds = { box.x + ( velX < 0 ? velX : 0 ), box.y + ( velY < 0 ? velY : 0 ), box.w + ( velX < 0 ? -velX : velX ), box.h + ( velY < 0 ? -velY : velY ) };
+	colliders.query( bounds, nearby );
+
+	//Walls overlapped from the start are ignored, as the sweeps do
+	vector<bool> ignored( nearby.size() );
+	for( int i = 0; i < (int)nearby.size(); ++i )
+	{
+		ignored[ i ] = touches( circle, box, walls[ nearby[ i ] ] );
+	}
+
+	for( travel = 0; travel < speed; ++travel )
+	{
+		box.x += stepX;
+		box.y += stepY;
+		for( int i = 0; i < (int)nearby.size(); ++i )
+		{
+			if( !ignored[ i ] && touches( circle, box, walls[ nearby[ i ] ] ) )
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+//Moves one axis the old way, full velocity then back if a wall is hit, returns whether it was blocked
+bool moveAndUndo( bool circle, int& position, int velocity, SDL_Rect& box, vector<SDL_Rect>& walls, SpatialHash& colliders, vector<int>& nearby )
+{
+	position += velocity;
+	colliders.query( box, nearby );
+	for( int i = 0; i < (int)nearby.size(); ++i )
+	{
+		if( touches( circle, box, walls[ nearby[ i ] ] ) )
+		{
+			position -= velocity;
+			return true;
+		}
+	}
+	return false;
+}
+
+//Runs every dot for every frame, audit checks each move against stepping it pixel by pixel which is left out of timing runs
+MoveStats run( MoveMode mode, bool audit, vector<SDL_Rect>& walls, SpatialHash& colliders )
+{
+	MoveStats stats = { 0, 0, 0, 0, 0 };
+	bool circle = mode == MOVE_CIRCLE_UNDO || mode == MOVE_CIRCLE_SWEEP;
+	bool sweep = mode == MOVE_BOX_SWEEP || mode == MOVE_CIRCLE_SWEEP;
+	vector<Mover> movers = makeMovers( walls );
+	vector<int> nearby;
+
+	for( int frame = 0; frame < BENCH_FRAMES; ++frame )
+	{
+		for( int i = 0; i < (int)movers.size(); ++i )
+		{
+			Mover& mover = movers[ i ];
+			for( int axis = 0; axis < 2; ++axis )
+			{
+				int& position = axis == 0 ? mover.box.x : mover.box.y;
+				int& velocity = axis == 0 ? mover.velX : mover.velY;
+				int velX = axis == 0 ? velocity : 0;
+				int velY = axis == 0 ? 0 : velocity;
+				++stats.moves;
+
+				//What the move should do
+				int clearTravel = 0;
+				bool shouldHit = audit && stepWalls( circle, mover.box, velX, velY, walls, colliders, nearby, clearTravel );
+
+				int startPosition = position;
+				bool blocked;
+				if( sweep )
+				{
+					SweepHit hit;
+					blocked = sweepWalls( circle, mover.box, velX, velY, walls, colliders, nearby, hit );
+					position += blocked ? getSweepTravel( velocity, hit ) : velocity;
+				}
+				else
+				{
+					blocked = moveAndUndo( circle, position, velocity, mover.box, walls, colliders, nearby );
+				}
+
+				if( audit )
+				{
+					if( shouldHit && !blocked )
+					{
+						++stats.tunneled;
+					}
+					int travel = position - startPosition;
+					if( shouldHit && blocked && ( travel < 0 ? -travel : travel ) < clearTravel )
+					{
+						++stats.stoppedShort;
+					}
+					for( int w = 0; w < (int)walls.size(); ++w )
+					{
+						if( touches( circle, mover.box, walls[ w ] ) )
+						{
+							++stats.overlapping;
+							break;
+						}
+					}
+				}
+
+				//Blocked dots head back the way they came
+				if( blocked )
+				{
+					++stats.blocked;
+					velocity = -velocity;
+				}
+			}
+		}
+	}
+
+	return stats;
+}
+
+int main( int argc, char* args[] )
+{
+	//Walls in a grid, inserted once since they never move
+	vector<SDL_Rect> walls;
+	SDL_Rect left = { -WALL_CELL, 0, WALL_CELL, LEVEL_SIZE };
+	SDL_Rect right = { LEVEL_SIZE, 0, WALL_CELL, LEVEL_SIZE };
+	SDL_Rect top = { 0, -WALL_CELL, LEVEL_SIZE, WALL_CELL };
+	SDL_Rect bottom = { 0, LEVEL_SIZE, LEVEL_SIZE, WALL_CELL };
+	walls.push_back( left );
+	walls.push_back( right );
+	walls.push_back( top );
+	walls.push_back( bottom );
+	for( int y = 0; y < LEVEL_SIZE; y += WALL_CELL )
+	{
+		for( int x = 0; x < LEVEL_SIZE; x += WALL_CELL )
+		{
+			SDL_Rect vertical = { x, y, WALL_THICKNESS, WALL_LENGTH };
+			SDL_Rect horizontal = { x + WALL_CELL - WALL_LENGTH, y + WALL_CELL - WALL_THICKNESS, WALL_LENGTH, WALL_THICKNESS };
+			walls.push_back( vertical );
+			walls.push_back( horizontal );
+		}
+	}
+	SpatialHash colliders( WALL_CELL );
+	for( int i = 0; i < (int)walls.size(); ++i )
+	{
+		colliders.insert( i, walls[ i ] );
+	}
+
+	cout << "mode\tMmoves/s\tblocked\ttunneled\tstopped short\toverlapping" << endl;
+
+	for( int m = 0; m < TOTAL_MOVE_MODES; ++m )
+	{
+		MoveMode mode = (MoveMode)m;
+
+		//Timed run, then the same moves again checked pixel by pixel
+		Uint64 start = SDL_GetPerformanceCounter();
+		MoveStats timed = run( mode, false, walls, colliders );
+		double seconds = getSeconds( start );
+		MoveStats audited = run( mode, true, walls, colliders );
+
+		cout << MOVE_MODE_NAMES[ mode ] << "\t" << timed.moves / seconds / 1000000.0 << "\t" << timed.blocked << "\t";
+		cout << audited.tunneled << "\t" << audited.stoppedShort << "\t" << audited.overlapping << endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,190 @@
+#include "ColliderSet.h"
+
+#ifdef CPU_HAS_X86
+#include <immintrin.h>
+#endif
+
+//Pointers to the side lanes of a set
+struct BoxLanes
+{
+	const Sint32* left;
+	const Sint32* right;
+	const Sint32* top;
+	const Sint32* bottom;
+
+	//Real boxes, and boxes including padding
+	int count;
+	int paddedCount;
+};
+
+//A boxes are moved by deltaX, deltaY into B's frame, B lanes are read as they are
+static bool collidesScalar( const BoxLanes& a, int deltaX, int deltaY, const BoxLanes& b )
+{
+	for( int i = 0; i < a.count; ++i )
+	{
+		Sint32 leftA = a.left[ i ] + deltaX;
+		Sint32 rightA = a.right[ i ] + deltaX;
+		Sint32 topA = a.top[ i ] + deltaY;
+		Sint32 bottomA = a.bottom[ i ] + deltaY;
+
+		for( int j = 0; j < b.count; ++j )
+		{
+			//If no sides from A are outside of B
+			if( bottomA > b.top[ j ] && topA < b.bottom[ j ] && rightA > b.left[ j ] && leftA < b.right[ j ] )
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+#ifdef CPU_HAS_X86
+CPU_TARGET_SSE2 static bool collidesSSE2( const BoxLanes& a, int deltaX, int deltaY, const BoxLanes& b )
+{
+	for( int i = 0; i < a.count; ++i )
+	{
+		__m128i leftA = _mm_set1_epi32( a.left[ i ] + deltaX );
+		__m128i rightA = _mm_set1_epi32( a.right[ i ] + deltaX );
+		__m128i topA = _mm_set1_epi32( a.top[ i ] + deltaY );
+		__m128i bottomA = _mm_set1_epi32( a.bottom[ i ] + deltaY );
+
+		//Four B boxes at a time, padding boxes never overlap
+		for( int j = 0; j < b.paddedCount; j += 4 )
+		{
+			__m128i hit = _mm_cmpgt_epi32( bottomA, _mm_loadu_si128( (const __m128i*)( b.top + j ) ) );
+			hit = _mm_and_si128( hit, _mm_cmpgt_epi32( _mm_loadu_si128( (const __m128i*)( b.bottom + j ) ), topA ) );
+			hit = _mm_and_si128( hit, _mm_cmpgt_epi32( rightA, _mm_loadu_si128( (const __m128i*)( b.left + j ) ) ) );
+			hit = _mm_and_si128( hit, _mm_cmpgt_epi32( _mm_loadu_si128( (const __m128i*)( b.right + j ) ), leftA ) );
+			if( _mm_movemask_epi8( hit ) != 0 )
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+CPU_TARGET_AVX2 static bool collidesAVX2( const BoxLanes& a, int deltaX, int deltaY, const BoxLanes& b )
+{
+	for( int i = 0; i < a.count; ++i )
+	{
+		__m256i leftA = _mm256_set1_epi32( a.left[ i ] + deltaX );
+		__m256i rightA = _mm256_set1_epi32( a.right[ i ] + deltaX );
+		__m256i topA = _mm256_set1_epi32( a.top[ i ] + deltaY );
+		__m256i bottomA = _mm256_set1_epi32( a.bottom[ i ] + deltaY );
+
+		//Eight B boxes at a time, padding boxes never overlap
+		for( int j = 0; j < b.paddedCount; j += 8 )
+		{
+			__m256i hit = _mm256_cmpgt_epi32( bottomA, _mm256_loadu_si256( (const __m256i*)( b.top + j ) ) );
+			hit = _mm256_and_si256( hit, _mm256_cmpgt_epi32( _mm256_loadu_si256( (const __m256i*)( b.bottom + j ) ), topA ) );
+			hit = _mm256_and_si256( hit, _mm256_cmpgt_epi32( rightA, _mm256_loadu_si256( (const __m256i*)( b.left + j ) ) ) );
+			hit = _mm256_and_si256( hit, _mm256_cmpgt_epi32( _mm256_loadu_si256( (const __m256i*)( b.right + j ) ), leftA ) );
+			if( _mm256_movemask_epi8( hit ) != 0 )
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+#endif
+
+bool isCollisionKernelSupported( CollisionKernel kernel )
+{
+	return isCpuLevelSupported( kernel );
+}
+
+CollisionKernel getBestCollisionKernel()
+{
+	return (CollisionKernel)getBestCpuLevel();
+}
+
+const char* getCollisionKernelName( CollisionKernel kernel )
+{
+	return getCpuLevelName( kernel );
+}
+
+ColliderSet::ColliderSet()
+{
+	//Initialize
+	mCount = 0;
+	mBounds.x = 0;
+	mBounds.y = 0;
+	mBounds.w = 0;
+	mBounds.h = 0;
+}
+
+void ColliderSet::setBoxes( std::vector<SDL_Rect>& boxes, int originX, int originY )
+{
+	mCount = (int)boxes.size();
+
+	//Padding boxes are inside out so no comparison against them passes
+	int paddedCount = ( mCount + LANE_WIDTH - 1 ) / LANE_WIDTH * LANE_WIDTH;
+	mLeft.assign( paddedCount, SDL_MAX_SINT32 );
+	mRight.assign( paddedCount, SDL_MIN_SINT32 );
+	mTop.assign( paddedCount, SDL_MAX_SINT32 );
+	mBottom.assign( paddedCount, SDL_MIN_SINT32 );
+
+	int left = SDL_MAX_SINT32, right = SDL_MIN_SINT32;
+	int top = SDL_MAX_SINT32, bottom = SDL_MIN_SINT32;
+	for( int i = 0; i < mCount; ++i )
+	{
+		mLeft[ i ] = boxes[ i ].x - originX;
+		mRight[ i ] = boxes[ i ].x + boxes[ i ].w - originX;
+		mTop[ i ] = boxes[ i ].y - originY;
+		mBottom[ i ] = boxes[ i ].y + boxes[ i ].h - originY;
+
+		left = mLeft[ i ] < left ? mLeft[ i ] : left;
+		right = mRight[ i ] > right ? mRight[ i ] : right;
+		top = mTop[ i ] < top ? mTop[ i ] : top;
+		bottom = mBottom[ i ] > bottom ? mBottom[ i ] : bottom;
+	}
+
+	if( mCount > 0 )
+	{
+		mBounds.x = left;
+		mBounds.y = top;
+		mBounds.w = right - left;
+		mBounds.h = bottom - top;
+	}
+}
+
+bool ColliderSet::collides( int x, int y, ColliderSet& other, int otherX, int otherY, CollisionKernel kernel )
+{
+	//Sets whose bounds do not overlap cannot have overlapping boxes
+	int deltaX = x - otherX;
+	int deltaY = y - otherY;
+	if( mCount == 0 || other.mCount == 0 ||
+		mBounds.y + mBounds.h + deltaY <= other.mBounds.y || mBounds.y + deltaY >= other.mBounds.y + other.mBounds.h ||
+		mBounds.x + mBounds.w + deltaX <= other.mBounds.x || mBounds.x + deltaX >= other.mBounds.x + other.mBounds.w )
+	{
+		return false;
+	}
+
+	BoxLanes a = { &mLeft[ 0 ], &mRight[ 0 ], &mTop[ 0 ], &mBottom[ 0 ], mCount, (int)mLeft.size() };
+	BoxLanes b = { &other.mLeft[ 0 ], &other.mRight[ 0 ], &other.mTop[ 0 ], &other.mBottom[ 0 ], other.mCount, (int)other.mLeft.size() };
+
+	switch( getRunnableCpuLevel( kernel ) )
+	{
+		#ifdef CPU_HAS_X86
+		case COLLISION_SSE2: return collidesSSE2( a, deltaX, deltaY, b );
+		case COLLISION_AVX2: return collidesAVX2( a, deltaX, deltaY, b );
+		#endif
+		default: return collidesScalar( a, deltaX, deltaY, b );
+	}
+}
+
+int ColliderSet::getCount()
+{
+	return mCount;
+}
+
+SDL_Rect ColliderSet::getBounds()
+{
+	return mBounds;
+}
@@ -0,0 +1,63 @@
+#ifndef COLLIDER_SET_H
+#define COLLIDER_SET_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+#include "../Engine/CpuDispatch.h"
+
+//Instruction sets the box set test can run on
+enum CollisionKernel
+{
+	COLLISION_SCALAR = CPU_SCALAR,
+	COLLISION_SSE2 = CPU_SSE2,
+	COLLISION_AVX2 = CPU_AVX2,
+	TOTAL_COLLISION_KERNELS = TOTAL_CPU_LEVELS
+};
+
+//Checks whether the kernel can run on this machine
+bool isCollisionKernelSupported( CollisionKernel kernel );
+
+//Picks the widest supported kernel
+CollisionKernel getBestCollisionKernel();
+
+//Gets kernel display name
+const char* getCollisionKernelName( CollisionKernel kernel );
+
+//Collision boxes stored as lanes of sides relative to their owner's position
+class ColliderSet
+{
+	public:
+		//Lanes are padded with empty boxes to a multiple of the widest kernel
+		static const int LANE_WIDTH = 8;
+
+		//Initializes an empty set
+		ColliderSet();
+
+		//Copies boxes, storing them relative to the given origin
+		void setBoxes( std::vector<SDL_Rect>& boxes, int originX, int originY );
+
+		//Whether any box of this set placed at x, y overlaps any box of other placed at otherX, otherY
+		//Stops at the first overlap, unsupported kernels fall back to scalar
+		bool collides( int x, int y, ColliderSet& other, int otherX, int otherY, CollisionKernel kernel );
+
+		//Gets the number of boxes
+		int getCount();
+
+		//Gets the box around every box, relative to the origin
+		SDL_Rect getBounds();
+
+	private:
+		//Box sides, one lane per side
+		std::vector<Sint32> mLeft;
+		std::vector<Sint32> mRight;
+		std::vector<Sint32> mTop;
+		std::vector<Sint32> mBottom;
+
+		//Boxes before padding
+		int mCount;
+
+		//Box around every box
+		SDL_Rect mBounds;
+};
+
+#endif
@@ -0,0 +1,250 @@
+#include <SDL2/SDL.h>
+#include <vector>
+#include <iostream>
+#include "ColliderSet.h"
+#include "../Engine/CollisionMask.h"
+#include "../Engine/BenchUtil.h"
+
+using namespace std;
+
+//Same dot as the sample
+const int DOT_WIDTH = 20;
+const int DOT_HEIGHT = 20;
+
+//Distinct dot placements, each one shifted box set is kept like the sample keeps mColliders
+const int BENCH_PLACEMENTS = 1 << 16;
+
+//Passes over every placement
+const int BENCH_PASSES = 32;
+
+//Side of the large sprite the masks are also timed on
+const int LARGE_SPRITE_SIZE = 128;
+
+//Collision box widths and heights from the sample's Dot constructor
+const int BOX_WIDTHS[] = { 6, 10, 14, 16, 18, 20, 18, 16, 14, 10, 6 };
+const int BOX_HEIGHTS[] = { 1, 1, 1, 2, 2, 6, 2, 2, 1, 1, 1 };
+const int TOTAL_BOXES = 11;
+
+//Box set collision detector, as in the sample
+bool checkCollision( vector<SDL_Rect>& a, vector<SDL_Rect>& b )
+{
+	for( int Abox = 0; Abox < (int)a.size(); Abox++ )
+	{
+		for( int Bbox = 0; Bbox < (int)b.size(); Bbox++ )
+		{
+			if( ( ( a[ Abox ].y + a[ Abox ].h <= b[ Bbox ].y ) || ( a[ Abox ].y >= b[ Bbox ].y + b[ Bbox ].h ) ||
+				( a[ Abox ].x + a[ Abox ].w <= b[ Bbox ].x ) || ( a[ Abox ].x >= b[ Bbox ].x + b[ Bbox ].w ) ) == false )
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+//The sample's collision boxes for a dot at x, y
+vector<SDL_Rect> makeColliders( int x, int y )
+{
+	vector<SDL_Rect> boxes( TOTAL_BOXES );
+	int r = 0;
+	for( int i = 0; i < TOTAL_BOXES; ++i )
+	{
+		boxes[ i ].w = BOX_WIDTHS[ i ];
+		boxes[ i ].h = BOX_HEIGHTS[ i ];
+		boxes[ i ].x = x + ( DOT_WIDTH - boxes[ i ].w ) / 2;
+		boxes[ i ].y = y + r;
+		r += boxes[ i ].h;
+	}
+	return boxes;
+}
+
+//Prints one result row, mismatches is how many placements disagreed with the mode's reference
+void report( const char* sprite, const char* mode, double seconds, long hits, int mismatches )
+{
+	double tests = (double)BENCH_PLACEMENTS * BENCH_PASSES;
+	cout << sprite << "\t" << mode << "\t" << seconds * 1000000000.0 / tests << "\t" << hits / BENCH_PASSES << "\t" << mismatches << endl;
+}
+
+//Builds the mask of a round sprite of the given size from its alpha channel
+bool buildCircleMask( CollisionMask& mask, int size )
+{
+	vector<Uint32> pixels( size * size );
+	for( int y = 0; y < size; ++y )
+	{
+		for( int x = 0; x < size; ++x )
+		{
+			int dx = x * 2 + 1 - size;
+			int dy = y * 2 + 1 - size;
+			pixels[ y * size + x ] = dx * dx + dy * dy <= size * size ? 0x000000FF : 0x00000000;
+		}
+	}
+
+	SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormatFrom( &pixels[ 0 ], size, size, 32, size * 4, SDL_PIXELFORMAT_RGBA8888 );
+	if( surface == NULL )
+	{
+		return false;
+	}
+	bool success = mask.build( surface );
+	SDL_FreeSurface( surface );
+	return success;
+}
+
+//Checks every pixel the two sprites share one by one, the reference the bitmask must match
+bool collidesPerPixel( CollisionMask& a, int x, int y, CollisionMask& b, int otherX, int otherY )
+{
+	int left = x > otherX ? x : otherX;
+	int top = y > otherY ? y : otherY;
+	int right = x + a.getWidth() < otherX + b.getWidth() ? x + a.getWidth() : otherX + b.getWidth();
+	int bottom = y + a.getHeight() < otherY + b.getHeight() ? y + a.getHeight() : otherY + b.getHeight();
+	for( int screenY = top; screenY < bottom; ++screenY )
+	{
+		for( int screenX = left; screenX < right; ++screenX )
+		{
+			if( a.isSolid( screenX - x, screenY - y ) && b.isSolid( screenX - otherX, screenY - otherY ) )
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+//Times the per pixel reference against the bitmask over placements scaled to the sprite, returns placements they disagree on
+int benchMasks( const char* sprite, CollisionMask& mask, vector<SDL_Point>& placements, int scale )
+{
+	//The bitmask has to give the reference's answer for every placement
+	int mismatches = 0;
+	for( int i = 0; i < BENCH_PLACEMENTS; ++i )
+	{
+		int x = placements[ i ].x * scale;
+		int y = placements[ i ].y * scale;
+		if( collidesPerPixel( mask, x, y, mask, 0, 0 ) != mask.collides( x, y, mask, 0, 0 ) )
+		{
+			++mismatches;
+		}
+	}
+
+	for( int mode = 0; mode < 2; ++mode )
+	{
+		long hits = 0;
+		Uint64 start = SDL_GetPerformanceCounter();
+		for( int pass = 0; pass < BENCH_PASSES; ++pass )
+		{
+			for( int i = 0; i < BENCH_PLACEMENTS; ++i )
+			{
+				int x = placements[ i ].x * scale;
+				int y = placements[ i ].y * scale;
+				bool hit = mode == 0 ? collidesPerPixel( mask, x, y, mask, 0, 0 ) : mask.collides( x, y, mask, 0, 0 );
+				if( hit )
+				{
+					++hits;
+				}
+			}
+		}
+		report( sprite, mode == 0 ? "pixels" : "bitmask", getSeconds( start ), hits, mode == 0 ? 0 : mismatches );
+	}
+
+	return mismatches;
+}
+
+int main( int argc, char* args[] )
+{
+	//Dots placed around a dot at the origin, close enough that their bounds nearly always overlap
+	vector<SDL_Point> placements( BENCH_PLACEMENTS );
+	vector< vector<SDL_Rect> > shifted( BENCH_PLACEMENTS );
+	Uint32 random = 1;
+	for( int i = 0; i < BENCH_PLACEMENTS; ++i )
+	{
+		placements[ i ].x = (int)( nextRandom( random ) % ( DOT_WIDTH * 2 + 1 ) ) - DOT_WIDTH;
+		placements[ i ].y = (int)( nextRandom( random ) % ( DOT_HEIGHT * 2 + 1 ) ) - DOT_HEIGHT;
+		shifted[ i ] = makeColliders( placements[ i ].x, placements[ i ].y );
+	}
+	vector<SDL_Rect> still = makeColliders( 0, 0 );
+
+	//Batched copy of the same boxes
+	ColliderSet set;
+	set.setBoxes( still, 0, 0 );
+
+	//Round dot and a large round sprite, masked from their alpha
+	CollisionMask mask;
+	CollisionMask largeMask;
+	if( !buildCircleMask( mask, DOT_WIDTH ) || !buildCircleMask( largeMask, LARGE_SPRITE_SIZE ) )
+	{
+		cout << "Failed to build the sprite masks!" << endl;
+		return 1;
+	}
+
+	cout << "sprite\tmode\tns/test\thits\tmismatches" << endl;
+
+	//Box against box like the sample did, the reference the batched sets must match
+	vector<bool> reference( BENCH_PLACEMENTS );
+	for( int i = 0; i < BENCH_PLACEMENTS; ++i )
+	{
+		reference[ i ] = checkCollision( shifted[ i ], still );
+	}
+	int mismatches = 0;
+
+	long hits = 0;
+	Uint64 start = SDL_GetPerformanceCounter();
+	for( int pass = 0; pass < BENCH_PASSES; ++pass )
+	{
+		for( int i = 0; i < BENCH_PLACEMENTS; ++i )
+		{
+			if( checkCollision( shifted[ i ], still ) )
+			{
+				++hits;
+			}
+		}
+	}
+	report( "dot", "boxes", getSeconds( start ), hits, 0 );
+
+	//Batched boxes on every kernel
+	for( int k = 0; k < TOTAL_COLLISION_KERNELS; ++k )
+	{
+		CollisionKernel kernel = (CollisionKernel)k;
+		if( !isCollisionKernelSupported( kernel ) )
+		{
+			cout << "dot\t" << getCollisionKernelName( kernel ) << "\tunsupported" << endl;
+			continue;
+		}
+
+		int kernelMismatches = 0;
+		for( int i = 0; i < BENCH_PLACEMENTS; ++i )
+		{
+			if( set.collides( placements[ i ].x, placements[ i ].y, set, 0, 0, kernel ) != reference[ i ] )
+			{
+				++kernelMismatches;
+			}
+		}
+		mismatches += kernelMismatches;
+
+		hits = 0;
+		start = SDL_GetPerformanceCounter();
+		for( int pass = 0; pass < BENCH_PASSES; ++pass )
+		{
+			for( int i = 0; i < BENCH_PLACEMENTS; ++i )
+			{
+				if( set.collides( placements[ i ].x, placements[ i ].y, set, 0, 0, kernel ) )
+				{
+					++hits;
+				}
+			}
+		}
+		report( "dot", getCollisionKernelName( kernel ), getSeconds( start ), hits, kernelMismatches );
+	}
+
+	//Exact shape, checked against the per pixel reference rather than the boxes, which only approximate the circle
+	mismatches += benchMasks( "dot", mask, placements, 1 );
+
+	//Larger sprites are where testing pixel by pixel falls behind
+	mismatches += benchMasks( "large", largeMask, placements, LARGE_SPRITE_SIZE / DOT_WIDTH );
+
+	if( mismatches > 0 )
+	{
+		cout << "Narrow phases disagree with their references!" << endl;
+		return 1;
+	}
+
+	return 0;
+}
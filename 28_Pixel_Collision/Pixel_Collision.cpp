@@ -4,6 +4,10 @@
 #include <string>
 #include <vector>
 #include <iostream>
+#include "../Engine/LTexture.h"
+#include "../Engine/SpatialHash.h"
+#include "../Engine/CollisionMask.h"
+#include "ColliderSet.h"
 
 using namespace std;
 
@@ -11,50 +15,15 @@ using namespace std;
 const int SCREEN_WIDTH = 640;
 const int SCREEN_HEIGHT = 480;
 
-//Texture wrapper class
-class LTexture
-{
-	public:
-		//Initializes variables
-		LTexture();
-
-		//Deallocates memory
-		~LTexture();
-
-		//Loads image at specified path
-		bool loadFromFile( string path );
-
-		#ifdef _SDL_TTF_H
-		//Creates image from font string
-		bool loadFromRenderedText( string textureText, SDL_Color textColor );
-		#endif
-
-		//Deallocates texture
-		void free();
-
-		//set color modulation
-		void setColor( Uint8 red, Uint8 green, Uint8 blue );
-
-		//Set Blending
-		void setBlendMode( SDL_BlendMode blending );
+//Broad phase cell size
+const int COLLISION_CELL_SIZE = 40;
 
-		//Set alpha modulation
-		void setAlpha( Uint8 alpha );
-
-		//Renders texture at given point
-		void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
-
-		//Gets image dimensions
-		int getWidth();
-		int getHeight();
-
-	private:
-		//The actual hardware texture
-		SDL_Texture* mTexture;
-
-		//Image dimensions
-		int mWidth;
-		int mHeight;
+//Narrow phase tests dots can use
+enum CollisionMode
+{
+	COLLIDE_BOXES,
+	COLLIDE_BATCH,
+	COLLIDE_MASK
 };
 
 //The dot that will move around on the screen
@@ -74,8 +43,8 @@ class Dot
 		//Takes key presses and adjusts the dot's velocity
 		void handleEvent( SDL_Event& e );
 
-		//Moves the dot and checks collision
-		void move( vector<SDL_Rect>& otherColliders );
+		//Moves the dot and checks collision against the dots the broad phase finds near it
+		void move( vector<Dot*>& dots, SpatialHash& colliders );
 
 		//Shows the dot on the screen
 		void render();
@@ -83,6 +52,9 @@ class Dot
 		//Gets the collision boxes
 		vector<SDL_Rect>& getColliders();
 
+		//Gets the box around every collision box
+		SDL_Rect getBox();
+
 	private:
 		//The X and Y offsets of the dot
 		int mPosX, mPosY;
@@ -95,6 +67,15 @@ class Dot
 
 		//Moves the collision boxes relative to the dot's offset
 		void shiftColliders();
+
+		//Collision boxes as lanes relative to the dot's offset
+		ColliderSet mColliderSet;
+
+		//Checks the collision boxes against every other dot near them
+		bool touchesDot( vector<Dot*>& dots, SpatialHash& colliders );
+
+		//Checks this dot against one other dot with the current collision mode
+		bool touches( Dot& other );
 };
 
 //Starts up SDL and creates window
@@ -118,152 +99,12 @@ SDL_Renderer* gRenderer = NULL;
 //Scene textures
 LTexture gDotTexture;
 
-LTexture::LTexture()
-{
-	//Initialize
-	mTexture = NULL;
-	mWidth = 0;
-	mHeight = 0;
-}
-
-LTexture::~LTexture()
-{
-	//Deallocate
-	free();
-}
-
-bool LTexture::loadFromFile( string path )
-{
-	//Get rid of preexisting texture
-	free();
+//Solid pixels of the dot texture
+CollisionMask gDotMask;
 
-	//The final texture
-	SDL_Texture* newTexture = NULL;
-
-	//Load image at specified path
-	SDL_Surface* loadedSurface = IMG_Load( path.c_str() );
-	if( loadedSurface == NULL )
-	{
-		cout << "Unable to load image %s! SDL_image Error: %s\n" << path.c_str() << IMG_GetError() << endl;
-	}
-	else
-	{
-		//Color key image
-		SDL_SetColorKey( loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ) );
-
-		//Create texture from surface pixels
-	newTexture = SDL_CreateTextureFromSurface( gRenderer, loadedSurface );
-		if( newTexture == NULL )
-		{
-			cout << "Unable to create texture from %s! SDL Error %s\n" << path.c_str() << SDL_GetError() << endl;
-		}
-		else
-		{
-			//Get image dimensions
-			mWidth = loadedSurface->w;
-			mHeight = loadedSurface->h;
-		}
-
-		//Get rid of old loaded surface
-		SDL_FreeSurface( loadedSurface );
-	}
-
-	//Return success
-	mTexture = newTexture;
-	return mTexture != NULL;
-}
-
-#ifdef _SDL_TTF_H
-bool LTexture::loadFromRenderedText( string textureText, SDL_Color textColor )
-{
-	//Get rid of preexisting texture
-	free();
-
-	//Render text surface
-	SDL_Surface* textSurface = TTF_RenderText_Solid( gFont, textureText.c_str(), textColor );
-	if( textSurface != NULL )
-	{
-		//Create texture from surface pixels
-	mTexture = SDL_CreateTextureFromSurface( gRenderer, textSurface );
-		if( mTexture == NULL )
-		{
-		cout << "Unable to create texture from rendered text! SDL Error: %s\n" << SDL_GetError() << endl;
-		}
-		else
-		{
-			//Get image dimensions
-			mWidth = textSurface->w;
-			mHeight = textSurface->h;
-		}
-
-		//Get rid of old surface
-		SDL_FreeSurface( textSurface );
-	}
-	else
-	{
-		cout << "Unable to render text Surface! SDL_ttf Error: %s\n" << TTF_GetError() << endl;
-	}
-
-	//Return success
-	return mTexture != NULL;
-}
-#endif
-
-void LTexture::free()
-{
-	//Free texture if it exists
-	if( mTexture != NULL )
-	{
-		SDL_DestroyTexture( mTexture );
-		mTexture = NULL;
-		mWidth = 0;
-		mHeight = 0;
-	}
-}
-
-void LTexture::setColor( Uint8 red, Uint8 green, Uint8 blue )
-{
-	//Modulate texture rgb
-	SDL_SetTextureColorMod( mTexture, red, green, blue );
-}
-
-void LTexture::setBlendMode( SDL_BlendMode blending )
-{
-	//Set blending function
-	SDL_SetTextureBlendMode( mTexture, blending );
-}
-
-void LTexture::setAlpha( Uint8 alpha )
-{
-	//Modulate texture alpha
-	SDL_SetTextureAlphaMod( mTexture, alpha );
-}
-
-void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip )
-{
-	//Set rendering space and render to screen
-	SDL_Rect renderQuad = { x, y, mWidth, mHeight };
-
-	//Set clip rending dimensions
-	if( clip != NULL )
-	{
-		renderQuad.w = clip->w;
-		renderQuad.h = clip->h;
-	}
-
-	//Render to screen
-	SDL_RenderCopyEx( gRenderer, mTexture, clip, &renderQuad, angle, center, flip );
-}
-
-int LTexture::getWidth()
-{
-	return mWidth;
-}
-
-int LTexture::getHeight()
-{
-	return mHeight;
-}
+//Narrow phase in use and the instruction set batched boxes run on
+CollisionMode gCollisionMode = COLLIDE_MASK;
+CollisionKernel gCollisionKernel = COLLISION_SCALAR;
 
 Dot::Dot( int x, int y)
 {
@@ -314,6 +155,9 @@ Dot::Dot( int x, int y)
 
 		//Initialize colliders relative to position
 		shiftColliders();
+
+	//Batched copy of the boxes
+	mColliderSet.setBoxes( mColliders, mPosX, mPosY );
 }
 
 void Dot::handleEvent( SDL_Event& e )
@@ -344,14 +188,14 @@ void Dot::handleEvent( SDL_Event& e )
 	}
 }
 
-void Dot::move( vector<SDL_Rect>& otherColliders )
+void Dot::move( vector<Dot*>& dots, SpatialHash& colliders )
 {
 	//Move the dot left or right
 	mPosX += mVelX;
 	shiftColliders();
 
 	//If the dot collided or went too far left or right
-	if( (mPosX < 0 ) || (mPosX + DOT_WIDTH > SCREEN_WIDTH ) || checkCollision( mColliders, otherColliders ) )
+	if( (mPosX < 0 ) || (mPosX + DOT_WIDTH > SCREEN_WIDTH ) || touchesDot( dots, colliders ) )
 	{
 		//Move back
 		mPosX -= mVelX;
@@ -363,7 +207,7 @@ void Dot::move( vector<SDL_Rect>& otherColliders )
 		shiftColliders();
 
 	//If the dot collided or went too far up or down
-	if( ( mPosY < 0 ) || ( mPosY + DOT_HEIGHT > SCREEN_HEIGHT ) || checkCollision( mColliders, otherColliders ) )
+	if( ( mPosY < 0 ) || ( mPosY + DOT_HEIGHT > SCREEN_HEIGHT ) || touchesDot( dots, colliders ) )
 	{
 		//Move back
 		mPosY -= mVelY;
@@ -401,6 +245,39 @@ vector<SDL_Rect>& Dot::getColliders()
 	return mColliders;
 }
 
+SDL_Rect Dot::getBox()
+{
+	SDL_Rect box = { mPosX, mPosY, DOT_WIDTH, DOT_HEIGHT };
+	return box;
+}
+
+bool Dot::touchesDot( vector<Dot*>& dots, SpatialHash& colliders )
+{
+	//Only dots near this one reach the per box check
+	static vector<int> nearby;
+	colliders.query( getBox(), nearby );
+	for( int i = 0; i < (int)nearby.size(); ++i )
+	{
+		Dot* other = dots[ nearby[ i ] ];
+		if( other != this && touches( *other ) )
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool Dot::touches( Dot& other )
+{
+	switch( gCollisionMode )
+	{
+		case COLLIDE_BATCH: return mColliderSet.collides( mPosX, mPosY, other.mColliderSet, other.mPosX, other.mPosY, gCollisionKernel );
+		case COLLIDE_MASK: return gDotMask.collides( mPosX, mPosY, gDotMask, other.mPosX, other.mPosY );
+		default: return checkCollision( mColliders, other.getColliders() );
+	}
+}
+
 bool init()
 {
 	//Initialization flag
@@ -420,7 +297,6 @@ bool init()
 			cout << "Warning: Linear texture filtering not enabled!" << endl;
 		}
 
-
 		//Create window
 		gWindow = SDL_CreateWindow( "SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN );
 		if( gWindow == NULL )
@@ -461,8 +337,8 @@ bool loadMedia()
 	//Loading success flag
 	bool success = true;
 
-	//Open dot texture
-	if( !gDotTexture.loadFromFile( "dot.bmp" ) )
+	//Open dot texture along with its collision mask
+	if( !gDotTexture.loadFromFile( "dot.bmp", gDotMask ) )
 	{
 		cout << "failed to load dot texture\n" << endl;
 		success = false;
@@ -475,6 +351,7 @@ void close()
 {
 	//Free loaded image
 	gDotTexture.free();
+	gDotMask.free();
 
 	//Destroy window
 	SDL_DestroyRenderer( gRenderer );
@@ -527,8 +404,22 @@ bool checkCollision( vector<SDL_Rect>& a, vector<SDL_Rect>& b )
 	return false;
 }
 
-int main()
+int main( int argc, char* args[] )
 {
+	//Solid pixels decide collisions, pass boxes to test box against box like before or batch for batched boxes
+	gCollisionKernel = getBestCollisionKernel();
+	for( int i = 1; i < argc; ++i )
+	{
+		if( string( args[ i ] ) == "boxes" )
+		{
+			gCollisionMode = COLLIDE_BOXES;
+		}
+		else if( string( args[ i ] ) == "batch" )
+		{
+			gCollisionMode = COLLIDE_BATCH;
+		}
+	}
+
 	//Start up SDL and create window
 	if( !init() )
 	{
@@ -555,6 +446,12 @@ int main()
 			//The dot that will be collided against
 			Dot otherDot( SCREEN_WIDTH / 4, SCREEN_HEIGHT / 4);
 
+			//Every dot, indexed by broad phase id
+			vector<Dot*> dots;
+			dots.push_back( &dot );
+			dots.push_back( &otherDot );
+			SpatialHash colliders( COLLISION_CELL_SIZE );
+
 			//While application is running
 			while( !quit )
 			{
@@ -571,8 +468,15 @@ int main()
 					dot.handleEvent( e );
 				}
 
+				//Dots insert where they are this frame
+				colliders.clear();
+				for( int i = 0; i < (int)dots.size(); ++i )
+				{
+					colliders.insert( i, dots[ i ]->getBox() );
+				}
+
 				//Move the dot and check collision
-				dot.move( otherDot.getColliders() );
+				dot.move( dots, colliders );
 
 				//Clear screen
 				SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
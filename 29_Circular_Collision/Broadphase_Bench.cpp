@@ -0,0 +1,186 @@
+#include <SDL2/SDL.h>
+#include <vector>
+#include <iostream>
+#include "../Engine/SpatialHash.h"
+#include "../Engine/BenchUtil.h"
+
+using namespace std;
+
+//Dot populations to compare
+const int BENCH_SIZES[] = { 100, 1000, 10000, 100000 };
+const int TOTAL_BENCH_SIZES = 4;
+
+//Brute force is skipped above this, it would take minutes
+const int MAX_BRUTE_FORCE = 20000;
+
+//Same dots as the sample
+const int DOT_SIZE = 20;
+
+//Screen area of level per dot, keeps the crowd equally dense at every size
+const int AREA_PER_DOT = 60 * 60;
+
+//Frames per run
+const int BENCH_FRAMES = 10;
+
+//A circle structure
+struct Circle
+{
+	int x, y;
+	int r;
+};
+
+//Circle/Circle collision detector, as in the sample
+bool checkCollision( Circle& a, Circle& b )
+{
+	int totalRadiusSquared = a.r + b.r;
+	totalRadiusSquared = totalRadiusSquared * totalRadiusSquared;
+	int deltaX = b.x - a.x;
+	int deltaY = b.y - a.y;
+	return deltaX * deltaX + deltaY * deltaY < totalRadiusSquared;
+}
+
+//Box collision detector, as in the sample
+bool checkCollision( SDL_Rect& a, SDL_Rect& b )
+{
+	return !( a.y + a.h <= b.y || a.y >= b.y + b.h || a.x + a.w <= b.x || a.x >= b.x + b.w );
+}
+
+//Every pair tested, returns how many collide
+template< typename Shape >
+long bruteForce( vector< Shape >& shapes )
+{
+	long hits = 0;
+	for( int i = 0; i < (int)shapes.size(); ++i )
+	{
+		for( int j = i + 1; j < (int)shapes.size(); ++j )
+		{
+			if( checkCollision( shapes[ i ], shapes[ j ] ) )
+			{
+				++hits;
+			}
+		}
+	}
+	return hits;
+}
+
+//Broad phase pairs fed to the narrow phase, returns how many collide
+template< typename Shape >
+long narrowPhase( vector< Shape >& shapes, vector< CollisionPair >& pairs )
+{
+	long hits = 0;
+	for( int i = 0; i < (int)pairs.size(); ++i )
+	{
+		if( checkCollision( shapes[ pairs[ i ].a ], shapes[ pairs[ i ].b ] ) )
+		{
+			++hits;
+		}
+	}
+	return hits;
+}
+
+int main( int argc, char* args[] )
+{
+	vector< CollisionPair > pairs;
+
+	cout << "dots\tshape\tbrute ms\thash ms\thits\tmatches brute" << endl;
+
+	//Rows where the hash found different hits than brute force
+	int mismatches = 0;
+
+	for( int s = 0; s < TOTAL_BENCH_SIZES; ++s )
+	{
+		int count = BENCH_SIZES[ s ];
+		int side = 1;
+		while( side * side < count * AREA_PER_DOT )
+		{
+			side *= 2;
+		}
+
+		//About two buckets per dot
+		SpatialHash grid( DOT_SIZE * 2, count * 2 );
+
+		//Scatter dots, the same positions as circles and as boxes
+		vector< Circle > circles( count );
+		vector< SDL_Rect > boxes( count );
+		Uint32 random = 1;
+		for( int i = 0; i < count; ++i )
+		{
+			circles[ i ].x = (int)( nextRandom( random ) % side );
+			circles[ i ].y = (int)( nextRandom( random ) % side );
+			circles[ i ].r = DOT_SIZE / 2;
+			SDL_Rect box = { circles[ i ].x - DOT_SIZE / 2, circles[ i ].y - DOT_SIZE / 2, DOT_SIZE, DOT_SIZE };
+			boxes[ i ] = box;
+		}
+
+		for( int shape = 0; shape < 2; ++shape )
+		{
+			bool useCircles = shape == 0;
+
+			//Brute force reference
+			long bruteHits = -1;
+			double bruteMs = -1.0;
+			if( count <= MAX_BRUTE_FORCE )
+			{
+				Uint64 start = SDL_GetPerformanceCounter();
+				for( int frame = 0; frame < BENCH_FRAMES; ++frame )
+				{
+					bruteHits = useCircles ? bruteForce( circles ) : bruteForce( boxes );
+				}
+				bruteMs = getSeconds( start ) * 1000.0 / BENCH_FRAMES;
+			}
+
+			//Insert every frame like moving dots do, then test candidate pairs
+			long hashHits = 0;
+			Uint64 start = SDL_GetPerformanceCounter();
+			for( int frame = 0; frame < BENCH_FRAMES; ++frame )
+			{
+				grid.clear();
+				for( int i = 0; i < count; ++i )
+				{
+					if( useCircles )
+					{
+						grid.insert( i, circles[ i ].x, circles[ i ].y, circles[ i ].r );
+					}
+					else
+					{
+						grid.insert( i, boxes[ i ] );
+					}
+				}
+				grid.findPairs( pairs );
+				hashHits = useCircles ? narrowPhase( circles, pairs ) : narrowPhase( boxes, pairs );
+			}
+			double hashMs = getSeconds( start ) * 1000.0 / BENCH_FRAMES;
+
+			cout << count << "\t" << ( useCircles ? "circle" : "box" ) << "\t";
+			if( bruteHits < 0 )
+			{
+				cout << "-";
+			}
+			else
+			{
+				cout << bruteMs;
+			}
+			cout << "\t" << hashMs << "\t" << hashHits << "\t";
+			if( bruteHits < 0 )
+			{
+				cout << "-" << endl;
+			}
+			else
+			{
+				cout << ( bruteHits == hashHits ? "yes" : "no" ) << endl;
+				if( bruteHits != hashHits )
+				{
+					++mismatches;
+				}
+			}
+		}
+	}
+
+	if( mismatches > 0 )
+	{
+		cout << "Spatial hash hits disagree with brute force!" << endl;
+		return 1;
+	}
+
+	return 0;
+}
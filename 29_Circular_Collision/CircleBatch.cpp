@@ -0,0 +1,312 @@
+#include "CircleBatch.h"
+#include <string.h>
+
+#ifdef CPU_HAS_X86
+#include <immintrin.h>
+#endif
+
+//Circles in [begin, count) one at a time
+static bool circleHitsScalar( const CircleSpan& circles, int begin, int x, int y, int r, Uint32* hits )
+{
+	bool any = false;
+	for( int i = begin; i < circles.count; ++i )
+	{
+		int totalRadius = r + circles.r[ i ];
+		int deltaX = circles.x[ i ] - x;
+		int deltaY = circles.y[ i ] - y;
+
+		//Tests are combined without branching since most circles miss
+		//Squares of centers far apart on an axis wrap around, the axis tests mask them out
+		Uint32 hit = ( deltaX < totalRadius ) & ( -deltaX < totalRadius ) & ( deltaY < totalRadius ) & ( -deltaY < totalRadius ) &
+			( (Uint32)deltaX * (Uint32)deltaX + (Uint32)deltaY * (Uint32)deltaY < (Uint32)( totalRadius * totalRadius ) );
+		hits[ i / 32 ] |= hit << ( i % 32 );
+		any |= hit != 0;
+	}
+
+	return any;
+}
+
+//Boxes in [begin, count) one at a time
+static bool boxHitsScalar( const BoxSpan& boxes, int begin, int x, int y, int r, Uint32* hits )
+{
+	bool any = false;
+	for( int i = begin; i < boxes.count; ++i )
+	{
+		//Distance from the center to the closest point on the box
+		int deltaX = boxes.x[ i ] - x;
+		if( x - boxes.x[ i ] - boxes.w[ i ] > deltaX )
+		{
+			deltaX = x - boxes.x[ i ] - boxes.w[ i ];
+		}
+		deltaX = deltaX > 0 ? deltaX : 0;
+
+		int deltaY = boxes.y[ i ] - y;
+		if( y - boxes.y[ i ] - boxes.h[ i ] > deltaY )
+		{
+			deltaY = y - boxes.y[ i ] - boxes.h[ i ];
+		}
+		deltaY = deltaY > 0 ? deltaY : 0;
+
+		Uint32 hit = ( deltaX < r ) & ( deltaY < r ) & ( (Uint32)deltaX * (Uint32)deltaX + (Uint32)deltaY * (Uint32)deltaY < (Uint32)( r * r ) );
+		hits[ i / 32 ] |= hit << ( i % 32 );
+		any |= hit != 0;
+	}
+
+	return any;
+}
+
+#ifdef CPU_HAS_X86
+//SSE2 has no 32 bit multiply or max, these build them from what it has
+CPU_TARGET_SSE2 static inline __m128i multiplySSE2( __m128i a, __m128i b )
+{
+	__m128i even = _mm_mul_epu32( a, b );
+	__m128i odd = _mm_mul_epu32( _mm_srli_epi64( a, 32 ), _mm_srli_epi64( b, 32 ) );
+	return _mm_unpacklo_epi32( _mm_shuffle_epi32( even, _MM_SHUFFLE( 0, 0, 2, 0 ) ), _mm_shuffle_epi32( odd, _MM_SHUFFLE( 0, 0, 2, 0 ) ) );
+}
+
+CPU_TARGET_SSE2 static inline __m128i maxSSE2( __m128i a, __m128i b )
+{
+	__m128i greater = _mm_cmpgt_epi32( a, b );
+	return _mm_or_si128( _mm_and_si128( greater, a ), _mm_andnot_si128( greater, b ) );
+}
+
+CPU_TARGET_SSE2 static bool circleHitsSSE2( const CircleSpan& circles, int x, int y, int r, Uint32* hits )
+{
+	__m128i centerX = _mm_set1_epi32( x );
+	__m128i centerY = _mm_set1_epi32( y );
+	__m128i radius = _mm_set1_epi32( r );
+	__m128i zero = _mm_setzero_si128();
+	int any = 0;
+
+	//Four circles at a time
+	int i = 0;
+	for( ; i + 4 <= circles.count; i += 4 )
+	{
+		__m128i totalRadius = _mm_add_epi32( radius, _mm_loadu_si128( (const __m128i*)( circles.r + i ) ) );
+		__m128i deltaX = _mm_sub_epi32( _mm_loadu_si128( (const __m128i*)( circles.x + i ) ), centerX );
+		__m128i deltaY = _mm_sub_epi32( _mm_loadu_si128( (const __m128i*)( circles.y + i ) ), centerY );
+
+		//Lanes far apart on an axis may overflow when squared, the axis test masks them out
+		__m128i hit = _mm_and_si128( _mm_cmpgt_epi32( totalRadius, deltaX ), _mm_cmpgt_epi32( totalRadius, _mm_sub_epi32( zero, deltaX ) ) );
+		hit = _mm_and_si128( hit, _mm_cmpgt_epi32( totalRadius, deltaY ) );
+		hit = _mm_and_si128( hit, _mm_cmpgt_epi32( totalRadius, _mm_sub_epi32( zero, deltaY ) ) );
+		__m128i distance = _mm_add_epi32( multiplySSE2( deltaX, deltaX ), multiplySSE2( deltaY, deltaY ) );
+		hit = _mm_and_si128( hit, _mm_cmpgt_epi32( multiplySSE2( totalRadius, totalRadius ), distance ) );
+
+		int bits = _mm_movemask_ps( _mm_castsi128_ps( hit ) );
+		hits[ i / 32 ] |= (Uint32)bits << ( i % 32 );
+		any |= bits;
+	}
+
+	//Leftover circles
+	return circleHitsScalar( circles, i, x, y, r, hits ) || any != 0;
+}
+
+CPU_TARGET_SSE2 static bool boxHitsSSE2( const BoxSpan& boxes, int x, int y, int r, Uint32* hits )
+{
+	__m128i centerX = _mm_set1_epi32( x );
+	__m128i centerY = _mm_set1_epi32( y );
+	__m128i radius = _mm_set1_epi32( r );
+	__m128i radiusSquared = _mm_set1_epi32( r * r );
+	__m128i zero = _mm_setzero_si128();
+	int any = 0;
+
+	//Four boxes at a time
+	int i = 0;
+	for( ; i + 4 <= boxes.count; i += 4 )
+	{
+		__m128i left = _mm_loadu_si128( (const __m128i*)( boxes.x + i ) );
+		__m128i top = _mm_loadu_si128( (const __m128i*)( boxes.y + i ) );
+		__m128i right = _mm_add_epi32( left, _mm_loadu_si128( (const __m128i*)( boxes.w + i ) ) );
+		__m128i bottom = _mm_add_epi32( top, _mm_loadu_si128( (const __m128i*)( boxes.h + i ) ) );
+
+		//Distance from the center to the closest point on the box
+		__m128i deltaX = maxSSE2( maxSSE2( _mm_sub_epi32( left, centerX ), _mm_sub_epi32( centerX, right ) ), zero );
+		__m128i deltaY = maxSSE2( maxSSE2( _mm_sub_epi32( top, centerY ), _mm_sub_epi32( centerY, bottom ) ), zero );
+
+		__m128i hit = _mm_and_si128( _mm_cmpgt_epi32( radius, deltaX ), _mm_cmpgt_epi32( radius, deltaY ) );
+		__m128i distance = _mm_add_epi32( multiplySSE2( deltaX, deltaX ), multiplySSE2( deltaY, deltaY ) );
+		hit = _mm_and_si128( hit, _mm_cmpgt_epi32( radiusSquared, distance ) );
+
+		int bits = _mm_movemask_ps( _mm_castsi128_ps( hit ) );
+		hits[ i / 32 ] |= (Uint32)bits << ( i % 32 );
+		any |= bits;
+	}
+
+	//Leftover boxes
+	return boxHitsScalar( boxes, i, x, y, r, hits ) || any != 0;
+}
+
+CPU_TARGET_AVX2 static bool circleHitsAVX2( const CircleSpan& circles, int x, int y, int r, Uint32* hits )
+{
+	__m256i centerX = _mm256_set1_epi32( x );
+	__m256i centerY = _mm256_set1_epi32( y );
+	__m256i radius = _mm256_set1_epi32( r );
+	int any = 0;
+
+	//Eight circles at a time
+	int i = 0;
+	for( ; i + 8 <= circles.count; i += 8 )
+	{
+		__m256i totalRadius = _mm256_add_epi32( radius, _mm256_loadu_si256( (const __m256i*)( circles.r + i ) ) );
+		__m256i deltaX = _mm256_abs_epi32( _mm256_sub_epi32( _mm256_loadu_si256( (const __m256i*)( circles.x + i ) ), centerX ) );
+		__m256i deltaY = _mm256_abs_epi32( _mm256_sub_epi32( _mm256_loadu_si256( (const __m256i*)( circles.y + i ) ), centerY ) );
+
+		//Lanes far apart on an axis may overflow when squared, the axis test masks them out
+		__m256i hit = _mm256_and_si256( _mm256_cmpgt_epi32( totalRadius, deltaX ), _mm256_cmpgt_epi32( totalRadius, deltaY ) );
+		__m256i distance = _mm256_add_epi32( _mm256_mullo_epi32( deltaX, deltaX ), _mm256_mullo_epi32( deltaY, deltaY ) );
+		hit = _mm256_and_si256( hit, _mm256_cmpgt_epi32( _mm256_mullo_epi32( totalRadius, totalRadius ), distance ) );
+
+		int bits = _mm256_movemask_ps( _mm256_castsi256_ps( hit ) );
+		hits[ i / 32 ] |= (Uint32)bits << ( i % 32 );
+		any |= bits;
+	}
+
+	//Leftover circles
+	return circleHitsScalar( circles, i, x, y, r, hits ) || any != 0;
+}
+
+CPU_TARGET_AVX2 static bool boxHitsAVX2( const BoxSpan& boxes, int x, int y, int r, Uint32* hits )
+{
+	__m256i centerX = _mm256_set1_epi32( x );
+	__m256i centerY = _mm256_set1_epi32( y );
+	__m256i radius = _mm256_set1_epi32( r );
+	__m256i radiusSquared = _mm256_set1_epi32( r * r );
+	__m256i zero = _mm256_setzero_si256();
+	int any = 0;
+
+	//Eight boxes at a time
+	int i = 0;
+	for( ; i + 8 <= boxes.count; i += 8 )
+	{
+		__m256i left = _mm256_loadu_si256( (const __m256i*)( boxes.x + i ) );
+		__m256i top = _mm256_loadu_si256( (const __m256i*)( boxes.y + i ) );
+		__m256i right = _mm256_add_epi32( left, _mm256_loadu_si256( (const __m256i*)( boxes.w + i ) ) );
+		__m256i bottom = _mm256_add_epi32( top, _mm256_loadu_si256( (const __m256i*)( boxes.h + i ) ) );
+
+		//Distance from the center to the closest point on the box
+		__m256i deltaX = _mm256_max_epi32( _mm256_max_epi32( _mm256_sub_epi32( left, centerX ), _mm256_sub_epi32( centerX, right ) ), zero );
+		__m256i deltaY = _mm256_max_epi32( _mm256_max_epi32( _mm256_sub_epi32( top, centerY ), _mm256_sub_epi32( centerY, bottom ) ), zero );
+
+		__m256i hit = _mm256_and_si256( _mm256_cmpgt_epi32( radius, deltaX ), _mm256_cmpgt_epi32( radius, deltaY ) );
+		__m256i distance = _mm256_add_epi32( _mm256_mullo_epi32( deltaX, deltaX ), _mm256_mullo_epi32( deltaY, deltaY ) );
+		hit = _mm256_and_si256( hit, _mm256_cmpgt_epi32( radiusSquared, distance ) );
+
+		int bits = _mm256_movemask_ps( _mm256_castsi256_ps( hit ) );
+		hits[ i / 32 ] |= (Uint32)bits << ( i % 32 );
+		any |= bits;
+	}
+
+	//Leftover boxes
+	return boxHitsScalar( boxes, i, x, y, r, hits ) || any != 0;
+}
+#endif
+
+bool isCircleKernelSupported( CircleKernel kernel )
+{
+	return isCpuLevelSupported( kernel );
+}
+
+CircleKernel getBestCircleKernel()
+{
+	return (CircleKernel)getBestCpuLevel();
+}
+
+const char* getCircleKernelName( CircleKernel kernel )
+{
+	return getCpuLevelName( kernel );
+}
+
+void CircleLanes::clear()
+{
+	mX.clear();
+	mY.clear();
+	mR.clear();
+}
+
+void CircleLanes::add( int x, int y, int r )
+{
+	mX.push_back( x );
+	mY.push_back( y );
+	mR.push_back( r );
+}
+
+CircleSpan CircleLanes::getSpan()
+{
+	CircleSpan span = { mX.empty() ? NULL : &mX[ 0 ], mY.empty() ? NULL : &mY[ 0 ], mR.empty() ? NULL : &mR[ 0 ], (int)mX.size() };
+	return span;
+}
+
+void BoxLanes::clear()
+{
+	mX.clear();
+	mY.clear();
+	mW.clear();
+	mH.clear();
+}
+
+void BoxLanes::add( SDL_Rect box )
+{
+	mX.push_back( box.x );
+	mY.push_back( box.y );
+	mW.push_back( box.w );
+	mH.push_back( box.h );
+}
+
+BoxSpan BoxLanes::getSpan()
+{
+	BoxSpan span = { mX.empty() ? NULL : &mX[ 0 ], mY.empty() ? NULL : &mY[ 0 ], mW.empty() ? NULL : &mW[ 0 ], mH.empty() ? NULL : &mH[ 0 ], (int)mX.size() };
+	return span;
+}
+
+int getHitWords( int count )
+{
+	return ( count + 31 ) / 32;
+}
+
+bool findCircleHits( CircleKernel kernel, const CircleSpan& circles, int x, int y, int r, Uint32* hits )
+{
+	memset( hits, 0, getHitWords( circles.count ) * sizeof( Uint32 ) );
+
+	switch( getRunnableCpuLevel( kernel ) )
+	{
+		#ifdef CPU_HAS_X86
+		case CIRCLE_SSE2: return circleHitsSSE2( circles, x, y, r, hits );
+		case CIRCLE_AVX2: return circleHitsAVX2( circles, x, y, r, hits );
+		#endif
+		default: return circleHitsScalar( circles, 0, x, y, r, hits );
+	}
+}
+
+bool findBoxHits( CircleKernel kernel, const BoxSpan& boxes, int x, int y, int r, Uint32* hits )
+{
+	memset( hits, 0, getHitWords( boxes.count ) * sizeof( Uint32 ) );
+
+	switch( getRunnableCpuLevel( kernel ) )
+	{
+		#ifdef CPU_HAS_X86
+		case CIRCLE_SSE2: return boxHitsSSE2( boxes, x, y, r, hits );
+		case CIRCLE_AVX2: return boxHitsAVX2( boxes, x, y, r, hits );
+		#endif
+		default: return boxHitsScalar( boxes, 0, x, y, r, hits );
+	}
+}
+
+int listContacts( const Uint32* hits, int count, int* contacts )
+{
+	int written = 0;
+	for( int word = 0; word < getHitWords( count ); ++word )
+	{
+		//Most words are empty
+		Uint32 bits = hits[ word ];
+		for( int bit = 0; bits != 0; ++bit, bits >>= 1 )
+		{
+			if( bits & 1 )
+			{
+				contacts[ written++ ] = word * 32 + bit;
+			}
+		}
+	}
+
+	return written;
+}
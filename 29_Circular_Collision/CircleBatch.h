@@ -0,0 +1,98 @@
+#ifndef CIRCLE_BATCH_H
+#define CIRCLE_BATCH_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+#include "../Engine/CpuDispatch.h"
+
+//Instruction sets the batch tests can run on
+enum CircleKernel
+{
+	CIRCLE_SCALAR = CPU_SCALAR,
+	CIRCLE_SSE2 = CPU_SSE2,
+	CIRCLE_AVX2 = CPU_AVX2,
+	TOTAL_CIRCLE_KERNELS = TOTAL_CPU_LEVELS
+};
+
+//Checks whether the kernel can run on this machine
+bool isCircleKernelSupported( CircleKernel kernel );
+
+//Picks the widest supported kernel
+CircleKernel getBestCircleKernel();
+
+//Gets kernel display name
+const char* getCircleKernelName( CircleKernel kernel );
+
+//A run of circles, one lane per coordinate
+struct CircleSpan
+{
+	const Sint32* x;
+	const Sint32* y;
+	const Sint32* r;
+	int count;
+};
+
+//A run of boxes, one lane per coordinate
+struct BoxSpan
+{
+	const Sint32* x;
+	const Sint32* y;
+	const Sint32* w;
+	const Sint32* h;
+	int count;
+};
+
+//Circle lanes that keep their memory between frames
+class CircleLanes
+{
+	public:
+		//Removes every circle
+		void clear();
+
+		//Adds a circle by its center and radius
+		void add( int x, int y, int r );
+
+		//Gets the circles added so far, valid until the next add
+		CircleSpan getSpan();
+
+	private:
+		std::vector<Sint32> mX;
+		std::vector<Sint32> mY;
+		std::vector<Sint32> mR;
+};
+
+//Box lanes that keep their memory between frames
+class BoxLanes
+{
+	public:
+		//Removes every box
+		void clear();
+
+		//Adds a box
+		void add( SDL_Rect box );
+
+		//Gets the boxes added so far, valid until the next add
+		BoxSpan getSpan();
+
+	private:
+		std::vector<Sint32> mX;
+		std::vector<Sint32> mY;
+		std::vector<Sint32> mW;
+		std::vector<Sint32> mH;
+};
+
+//Words a hit set needs for count shapes, bit i of word i / 32 is shape i
+int getHitWords( int count );
+
+//Tests use integer math only, radii and box sides must stay below 16384 so squares cannot overflow
+
+//Sets the hit bit of every circle overlapping the circle at x, y with radius r, true if any does
+bool findCircleHits( CircleKernel kernel, const CircleSpan& circles, int x, int y, int r, Uint32* hits );
+
+//Sets the hit bit of every box overlapping the circle at x, y with radius r, true if any does
+bool findBoxHits( CircleKernel kernel, const BoxSpan& boxes, int x, int y, int r, Uint32* hits );
+
+//Writes the index of every hit out of count shapes to contacts, returns how many were written
+int listContacts( const Uint32* hits, int count, int* contacts );
+
+#endif
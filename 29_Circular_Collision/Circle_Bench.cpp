@@ -0,0 +1,173 @@
+#include <SDL2/SDL.h>
+#include <vector>
+#include <iostream>
+#include "CircleBatch.h"
+#include "../Engine/BenchUtil.h"
+
+using namespace std;
+
+//Shape populations to compare
+const int BENCH_SIZES[] = { 1000, 10000, 100000, 1000000 };
+const int TOTAL_BENCH_SIZES = 4;
+
+//Circles tested against the whole population per run
+const int BENCH_PROBES = 64;
+
+//Same dots as the sample
+const int DOT_SIZE = 20;
+
+//Screen area of level per shape, keeps the crowd equally dense at every size
+const int AREA_PER_SHAPE = 60 * 60;
+
+//Level side limit, large populations get crowded past it
+const int MAX_SIDE = 32768;
+
+//A circle structure
+struct Circle
+{
+	int x, y;
+	int r;
+};
+
+//Calculates distance squared between two points, as the sample did
+double distanceSquared( int x1, int y1, int x2, int y2 )
+{
+	int deltaX = x2 - x1;
+	int deltaY = y2 - y1;
+	return deltaX*deltaX + deltaY*deltaY;
+}
+
+//Circle/Circle collision detector, as the sample did
+bool checkCollision( Circle& a, Circle& b )
+{
+	int totalRadiusSquared = a.r + b.r;
+	totalRadiusSquared = totalRadiusSquared * totalRadiusSquared;
+	return distanceSquared( a.x, a.y, b.x, b.y ) < totalRadiusSquared;
+}
+
+//Circle/Box collision detector, as the sample did
+bool checkCollision( Circle& a, SDL_Rect& b )
+{
+	int cX = a.x < b.x ? b.x : ( a.x > b.x + b.w ? b.x + b.w : a.x );
+	int cY = a.y < b.y ? b.y : ( a.y > b.y + b.h ? b.y + b.h : a.y );
+	return distanceSquared( a.x, a.y, cX, cY ) < a.r * a.r;
+}
+
+//Prints one result row, returns whether the hits match the reference
+bool report( int count, const char* shape, const char* mode, double seconds, long hits, long reference )
+{
+	double tests = (double)count * BENCH_PROBES;
+	cout << count << "\t" << shape << "\t" << mode << "\t" << tests / seconds / 1000000.0 << "\t" << hits << "\t" << ( hits == reference ? "yes" : "no" ) << endl;
+	return hits == reference;
+}
+
+//Hits in a hit set, counted through the contact list
+long countContacts( vector<Uint32>& hits, int count, vector<int>& contacts )
+{
+	return listContacts( &hits[ 0 ], count, &contacts[ 0 ] );
+}
+
+int main( int argc, char* args[] )
+{
+	cout << "shapes\tshape\tmode\tMtests/s\thits\tmatches double" << endl;
+
+	//Kernel rows that disagree with the double reference
+	int mismatches = 0;
+
+	for( int s = 0; s < TOTAL_BENCH_SIZES; ++s )
+	{
+		int count = BENCH_SIZES[ s ];
+		//The double path squares in int, so shapes stay close enough for it to be right
+		int side = 1;
+		while( (double)side * side < (double)count * AREA_PER_SHAPE && side < MAX_SIDE )
+		{
+			side *= 2;
+		}
+
+		//The same scatter as circles, boxes and their lanes
+		vector<Circle> circles( count );
+		vector<SDL_Rect> boxes( count );
+		CircleLanes circleLanes;
+		BoxLanes boxLanes;
+		Uint32 random = 1;
+		for( int i = 0; i < count; ++i )
+		{
+			circles[ i ].x = (int)( nextRandom( random ) % side );
+			circles[ i ].y = (int)( nextRandom( random ) % side );
+			circles[ i ].r = DOT_SIZE / 2;
+			SDL_Rect box = { circles[ i ].x - DOT_SIZE / 2, circles[ i ].y - DOT_SIZE / 2, DOT_SIZE, DOT_SIZE };
+			boxes[ i ] = box;
+			circleLanes.add( circles[ i ].x, circles[ i ].y, circles[ i ].r );
+			boxLanes.add( box );
+		}
+
+		//Probes spread over the same area
+		vector<Circle> probes( BENCH_PROBES );
+		for( int p = 0; p < BENCH_PROBES; ++p )
+		{
+			probes[ p ].x = (int)( nextRandom( random ) % side );
+			probes[ p ].y = (int)( nextRandom( random ) % side );
+			probes[ p ].r = DOT_SIZE / 2;
+		}
+
+		vector<Uint32> hits( getHitWords( count ) );
+		vector<int> contacts( count );
+
+		for( int shape = 0; shape < 2; ++shape )
+		{
+			bool useCircles = shape == 0;
+			const char* shapeName = useCircles ? "circle" : "box";
+
+			//One pair at a time in double, the reference
+			long reference = 0;
+			Uint64 start = SDL_GetPerformanceCounter();
+			for( int p = 0; p < BENCH_PROBES; ++p )
+			{
+				for( int i = 0; i < count; ++i )
+				{
+					if( useCircles ? checkCollision( probes[ p ], circles[ i ] ) : checkCollision( probes[ p ], boxes[ i ] ) )
+					{
+						++reference;
+					}
+				}
+			}
+			report( count, shapeName, "double", getSeconds( start ), reference, reference );
+
+			//Every kernel, contacts listed from the hit set
+			for( int k = 0; k < TOTAL_CIRCLE_KERNELS; ++k )
+			{
+				CircleKernel kernel = (CircleKernel)k;
+				if( !isCircleKernelSupported( kernel ) )
+				{
+					cout << count << "\t" << shapeName << "\t" << getCircleKernelName( kernel ) << "\tunsupported" << endl;
+					continue;
+				}
+
+				long total = 0;
+				start = SDL_GetPerformanceCounter();
+				for( int p = 0; p < BENCH_PROBES; ++p )
+				{
+					bool any = useCircles ?
+						findCircleHits( kernel, circleLanes.getSpan(), probes[ p ].x, probes[ p ].y, probes[ p ].r, &hits[ 0 ] ) :
+						findBoxHits( kernel, boxLanes.getSpan(), probes[ p ].x, probes[ p ].y, probes[ p ].r, &hits[ 0 ] );
+					if( any )
+					{
+						total += countContacts( hits, count, contacts );
+					}
+				}
+				if( !report( count, shapeName, getCircleKernelName( kernel ), getSeconds( start ), total, reference ) )
+				{
+					++mismatches;
+				}
+			}
+		}
+	}
+
+	if( mismatches > 0 )
+	{
+		cout << "Circle kernels disagree with the double reference!" << endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -2,7 +2,11 @@
 #include <SDL2/SDL_image.h>
 #include <stdio.h>
 #include <string>
+#include <vector>
 #include <iostream>
+#include "../Engine/LTexture.h"
+#include "../Engine/SpatialHash.h"
+#include "CircleBatch.h"
 
 using namespace std;
 
@@ -10,6 +14,9 @@ using namespace std;
 const int SCREEN_WIDTH = 640;
 const int SCREEN_HEIGHT = 480;
 
+//Broad phase cell size
+const int COLLISION_CELL_SIZE = 40;
+
 //A circle structure
 struct Circle
 {
@@ -17,52 +24,6 @@ struct Circle
 	int r;
 };
 
-//Texture wrapper class
-class LTexture
-{
-	public:
-		//Initializes variables
-		LTexture();
-
-		//Deallocates memory
-		~LTexture();
-
-		//Loads image at specified path
-		bool loadFromFile( string path );
-
-		#ifdef _SDL_TTF_H
-		//Creates image from font string
-		bool loadFromRenderedText( string textureText, SDL_Color textColor );
-		#endif
-
-		//Deallocates texture
-		void free();
-
-		//set color modulation
-		void setColor( Uint8 red, Uint8 green, Uint8 blue );
-
-		//Set Blending
-		void setBlendMode( SDL_BlendMode blending );
-
-		//Set alpha modulation
-		void setAlpha( Uint8 alpha );
-
-		//Renders texture at given point
-		void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
-
-		//Gets image dimensions
-		int getWidth();
-		int getHeight();
-
-	private:
-		//The actual hardware texture
-		SDL_Texture* mTexture;
-
-		//Image dimensions
-		int mWidth;
-		int mHeight;
-};
-
 //The dot that will move around on the screen
 class Dot
 {
@@ -80,8 +41,8 @@ class Dot
 		//Takes key presses and adjusts the dot's velocity
 		void handleEvent( SDL_Event& e );
 
-		//Moves the dot and checks collision
-		void move( SDL_Rect& square, Circle& circle );
+		//Moves the dot and checks collision against the walls and dots the broad phase finds near it
+		void move( vector<SDL_Rect>& walls, vector<Dot*>& dots, SpatialHash& colliders );
 
 		//Shows the dot on the screen
 		void render();
@@ -101,6 +62,9 @@ class Dot
 
 		//Moves the collision boxes relative to the dot's offset
 		void shiftColliders();
+
+		//Checks the collider against the walls and other dots near it
+		bool touchesAny( vector<SDL_Rect>& walls, vector<Dot*>& dots, SpatialHash& colliders );
 };
 
 //Starts up SDL and creates window
@@ -112,15 +76,6 @@ bool loadMedia();
 //Frees media and shuts down SDL
 void close();
 
-//Circle/Circle collision detector
-bool checkCollision( Circle& a, Circle& b );
-
-//Circle/Box set collision detector
-bool checkCollision( Circle& a, SDL_Rect& b );
-
-//Calculates distance squared between two points
-double distanceSquared( int x1, int y1, int x2, int y2 );
-
 //The window we'll be rendering to
 SDL_Window* gWindow = NULL;
 
@@ -130,152 +85,8 @@ SDL_Renderer* gRenderer = NULL;
 //Scene textures
 LTexture gDotTexture;
 
-LTexture::LTexture()
-{
-	//Initialize
-	mTexture = NULL;
-	mWidth = 0;
-	mHeight = 0;
-}
-
-LTexture::~LTexture()
-{
-	//Deallocate
-	free();
-}
-
-bool LTexture::loadFromFile( string path )
-{
-	//Get rid of preexisting texture
-	free();
-
-	//The final texture
-	SDL_Texture* newTexture = NULL;
-
-	//Load image at specified path
-	SDL_Surface* loadedSurface = IMG_Load( path.c_str() );
-	if( loadedSurface == NULL )
-	{
-		cout << "Unable to load image %s! SDL_image Error: %s\n" << path.c_str() << IMG_GetError() << endl;
-	}
-	else
-	{
-		//Color key image
-		SDL_SetColorKey( loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ) );
-
-		//Create texture from surface pixels
-	newTexture = SDL_CreateTextureFromSurface( gRenderer, loadedSurface );
-		if( newTexture == NULL )
-		{
-			cout << "Unable to create texture from %s! SDL Error %s\n" << path.c_str() << SDL_GetError() << endl;
-		}
-		else
-		{
-			//Get image dimensions
-			mWidth = loadedSurface->w;
-			mHeight = loadedSurface->h;
-		}
-
-		//Get rid of old loaded surface
-		SDL_FreeSurface( loadedSurface );
-	}
-
-	//Return success
-	mTexture = newTexture;
-	return mTexture != NULL;
-}
-
-#ifdef _SDL_TTF_H
-bool LTexture::loadFromRenderedText( string textureText, SDL_Color textColor )
-{
-	//Get rid of preexisting texture
-	free();
-
-	//Render text surface
-	SDL_Surface* textSurface = TTF_RenderText_Solid( gFont, textureText.c_str(), textColor );
-	if( textSurface != NULL )
-	{
-		//Create texture from surface pixels
-	mTexture = SDL_CreateTextureFromSurface( gRenderer, textSurface );
-		if( mTexture == NULL )
-		{
-		cout << "Unable to create texture from rendered text! SDL Error: %s\n" << SDL_GetError() << endl;
-		}
-		else
-		{
-			//Get image dimensions
-			mWidth = textSurface->w;
-			mHeight = textSurface->h;
-		}
-
-		//Get rid of old surface
-		SDL_FreeSurface( textSurface );
-	}
-	else
-	{
-		cout << "Unable to render text Surface! SDL_ttf Error: %s\n" << TTF_GetError() << endl;
-	}
-
-	//Return success
-	return mTexture != NULL;
-}
-#endif
-
-void LTexture::free()
-{
-	//Free texture if it exists
-	if( mTexture != NULL )
-	{
-		SDL_DestroyTexture( mTexture );
-		mTexture = NULL;
-		mWidth = 0;
-		mHeight = 0;
-	}
-}
-
-void LTexture::setColor( Uint8 red, Uint8 green, Uint8 blue )
-{
-	//Modulate texture rgb
-	SDL_SetTextureColorMod( mTexture, red, green, blue );
-}
-
-void LTexture::setBlendMode( SDL_BlendMode blending )
-{
-	//Set blending function
-	SDL_SetTextureBlendMode( mTexture, blending );
-}
-
-void LTexture::setAlpha( Uint8 alpha )
-{
-	//Modulate texture alpha
-	SDL_SetTextureAlphaMod( mTexture, alpha );
-}
-
-void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip )
-{
-	//Set rendering space and render to screen
-	SDL_Rect renderQuad = { x, y, mWidth, mHeight };
-
-	//Set clip rending dimensions
-	if( clip != NULL )
-	{
-		renderQuad.w = clip->w;
-		renderQuad.h = clip->h;
-	}
-
-	//Render to screen
-	SDL_RenderCopyEx( gRenderer, mTexture, clip, &renderQuad, angle, center, flip );
-}
-
-int LTexture::getWidth()
-{
-	return mWidth;
-}
-
-int LTexture::getHeight()
-{
-	return mHeight;
-}
+//Instruction set the batched circle tests run on
+CircleKernel gCircleKernel = CIRCLE_SCALAR;
 
 Dot::Dot( int x, int y)
 {
@@ -323,14 +134,14 @@ void Dot::handleEvent( SDL_Event& e )
 	}
 }
 
-void Dot::move( SDL_Rect& square, Circle& circle )
+void Dot::move( vector<SDL_Rect>& walls, vector<Dot*>& dots, SpatialHash& colliders )
 {
 	//Move the dot left or right
 	mPosX += mVelX;
 	shiftColliders();
 
 	//If the dot collided or went too far left or right
-	if( (mPosX - mCollider.r < 0 ) || (mPosX + mCollider.r > SCREEN_WIDTH ) || checkCollision( mCollider, square ) || checkCollision ( mCollider, circle ) )
+	if( (mPosX - mCollider.r < 0 ) || (mPosX + mCollider.r > SCREEN_WIDTH ) || touchesAny( walls, dots, colliders ) )
 	{
 		//Move back
 		mPosX -= mVelX;
@@ -342,7 +153,7 @@ void Dot::move( SDL_Rect& square, Circle& circle )
 		shiftColliders();
 
 	//If the dot collided or went too far up or down
-	if( ( mPosY - mCollider.r < 0 ) || ( mPosY + mCollider.r > SCREEN_HEIGHT ) || checkCollision( mCollider, square ) || checkCollision ( mCollider, circle ) )
+	if( ( mPosY - mCollider.r < 0 ) || ( mPosY + mCollider.r > SCREEN_HEIGHT ) || touchesAny( walls, dots, colliders ) )
 	{
 		//Move back
 		mPosY -= mVelY;
@@ -361,6 +172,42 @@ Circle& Dot::getCollider()
 	return mCollider;
 }
 
+bool Dot::touchesAny( vector<SDL_Rect>& walls, vector<Dot*>& dots, SpatialHash& colliders )
+{
+	//Lanes and hit bits are kept between calls so moving does not allocate
+	static vector<int> nearby;
+	static BoxLanes nearbyWalls;
+	static CircleLanes nearbyDots;
+	static vector<Uint32> hits;
+
+	//Walls have the ids before the dots
+	SDL_Rect box = { mCollider.x - mCollider.r, mCollider.y - mCollider.r, mCollider.r * 2, mCollider.r * 2 };
+	colliders.query( box, nearby );
+	nearbyWalls.clear();
+	nearbyDots.clear();
+	for( int i = 0; i < (int)nearby.size(); ++i )
+	{
+		int id = nearby[ i ];
+		if( id < (int)walls.size() )
+		{
+			nearbyWalls.add( walls[ id ] );
+		}
+		else
+		{
+			Dot* other = dots[ id - walls.size() ];
+			if( other != this )
+			{
+				nearbyDots.add( other->mCollider.x, other->mCollider.y, other->mCollider.r );
+			}
+		}
+	}
+
+	//Everything nearby in one batch per shape, the spare word keeps the buffer valid when nothing is near
+	hits.resize( getHitWords( (int)nearby.size() ) + 1 );
+	return findBoxHits( gCircleKernel, nearbyWalls.getSpan(), mCollider.x, mCollider.y, mCollider.r, &hits[ 0 ] ) ||
+		findCircleHits( gCircleKernel, nearbyDots.getSpan(), mCollider.x, mCollider.y, mCollider.r, &hits[ 0 ] );
+}
+
 void Dot::shiftColliders()
 {
 	//Align collider to center of dot
@@ -387,7 +234,6 @@ bool init()
 			cout << "Warning: Linear texture filtering not enabled!" << endl;
 		}
 
-
 		//Create window
 		gWindow = SDL_CreateWindow( "SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN );
 		if( gWindow == NULL )
@@ -454,76 +300,11 @@ void close()
 	SDL_Quit();
 }
 
-bool checkCollision( Circle& a, Circle& b )
-{
-	//Calculate total radius squared
-	int totalRadiusSquared = a.r + b.r;
-	totalRadiusSquared = totalRadiusSquared * totalRadiusSquared;
-
-	//If the distance between the centers of the circles is less than the sum of their radii
-	if( distanceSquared( a.x, a.y, b.x, b.y ) < ( totalRadiusSquared ) )
-	{
-		//The circle have collided
-		return true;
-	}
-
-	//If not
-	return false;
-}
-
-bool checkCollision( Circle& a, SDL_Rect& b )
-{
-	//Closest point on collision box
-	int cX, cY;
-
-	//Find closest x offset
-	if( a.x < b.x )
-	{
-		cX = b.x;
-	}
-	else if( a.x > b.x + b.w )
-	{
-		cX = b.x + b.w;
-	}
-	else
-	{
-		cX = a.x;
-	}
-
-	//Find closest y offset
-	if( a.y < b.y )
-	{
-		cY = b.y;
-	}
-	else if( a.y > b.y + b.h )
-	{
-		cY = b.y + b.h;
-	}
-	else
-	{
-		cY = a.y;
-	}
-
-	//If the closest point is inside the circle
-	if( distanceSquared( a.x, a.y, cX, cY ) < a.r * a.r )
-	{
-		//This box and circle have collided
-		return true;
-	}
-
-	//If the shapes have not collided
-	return false;
-}
-
-double distanceSquared( int x1, int y1, int x2, int y2 )
-{
-	int deltaX = x2 - x1;
-	int deltaY = y2 - y1;
-	return deltaX*deltaX + deltaY*deltaY;
-}
-
 int main()
 {
+	//Widest instruction set this machine has
+	gCircleKernel = getBestCircleKernel();
+
 	//Start up SDL and create window
 	if( !init() )
 	{
@@ -555,6 +336,14 @@ int main()
 			wall.w = 40;
 			wall.h = 400;
 
+			//Every wall and dot, indexed by broad phase id
+			vector<SDL_Rect> walls;
+			walls.push_back( wall );
+			vector<Dot*> dots;
+			dots.push_back( &dot );
+			dots.push_back( &otherDot );
+			SpatialHash colliders( COLLISION_CELL_SIZE );
+
 			//While application is running
 			while( !quit )
 			{
@@ -571,8 +360,20 @@ int main()
 					dot.handleEvent( e );
 				}
 
+				//Walls and dots insert where they are this frame
+				colliders.clear();
+				for( int i = 0; i < (int)walls.size(); ++i )
+				{
+					colliders.insert( i, walls[ i ] );
+				}
+				for( int i = 0; i < (int)dots.size(); ++i )
+				{
+					Circle& circle = dots[ i ]->getCollider();
+					colliders.insert( (int)walls.size() + i, circle.x, circle.y, circle.r );
+				}
+
 				//Move the dot and check collision
-				dot.move( wall, otherDot.getCollider() );
+				dot.move( walls, dots, colliders );
 
 				//Clear screen
 				SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
@@ -6,6 +6,7 @@
 #include <sstream>
 #include <iostream>
 #include <climits>
+#include "../Engine/LTexture.h"
 
 using namespace std;
 
@@ -16,52 +17,6 @@ const int SCREEN_HEIGHT = 480;
 //Number of data integers
 const int TOTAL_DATA = 10;
 
-//Texture wrapper class
-class LTexture
-{
-	public:
-		//Initializes variables
-		LTexture();
-
-		//Deallocates memory
-		~LTexture();
-
-		//Loads image at specified path
-		bool loadFromFile( string path );
-
-		#ifdef _SDL_TTF_H
-		//Creates image from font string
-		bool loadFromRenderedText( string textureText, SDL_Color textColor );
-		#endif
-
-		//Deallocates texture
-		void free();
-
-		//Set color modulation
-		void setColor( Uint8 red, Uint8 green, Uint8 blue );
-
-		//Set blending
-		void setBlendMode( SDL_BlendMode blending );
-
-		//Set alpha modulation
-		void setAlpha( Uint8 alpha );
-
-		//Renders texture at given point
-		void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
-
-		//Gets image dimensions
-		int getWidth();
-		int getHeight();
-
-	private:
-		//The actual hardware texture
-		SDL_Texture* mTexture;
-
-		//Image dimensions
-		int mWidth;
-		int mHeight;
-};
-
 //Starts up SDL and creates window
 bool init();
 
@@ -87,154 +42,6 @@ LTexture gDataTextures[ TOTAL_DATA ];
 //Data points
 Sint32 gData[ TOTAL_DATA ];
 
-LTexture::LTexture()
-{
-	//Initialize
-	mTexture = NULL;
-	mWidth = 0;
-	mHeight = 0;
-}
-
-LTexture::~LTexture()
-{
-	//Deallocate
-	free();
-}
-
-bool LTexture::loadFromFile( string path )
-{
-	//Get rid of preexisting texture
-	free();
-
-	//The final texture
-	SDL_Texture* newTexture = NULL;
-
-	//Load image at specified path
-	SDL_Surface* loadedSurface = IMG_Load( path.c_str() );
-	if( loadedSurface == NULL )
-	{
-		cout << "Unable to load image %s! SDL_image Error: %s\n" << path.c_str() << IMG_GetError() << endl;
-	}
-	else
-	{
-		//Color key image
-		SDL_SetColorKey( loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ) );
-
-		//Create texture from surface pixels
-        newTexture = SDL_CreateTextureFromSurface( gRenderer, loadedSurface );
-		if( newTexture == NULL )
-		{
-			cout << "Unable to create texture from %s! SDL Error: %s\n" << path.c_str() << SDL_GetError() << endl;
-		}
-		else
-		{
-			//Get image dimensions
-			mWidth = loadedSurface->w;
-			mHeight = loadedSurface->h;
-		}
-
-		//Get rid of old loaded surface
-		SDL_FreeSurface( loadedSurface );
-	}
-
-	//Return success
-	mTexture = newTexture;
-	return mTexture != NULL;
-}
-
-#ifdef _SDL_TTF_H
-bool LTexture::loadFromRenderedText( string textureText, SDL_Color textColor )
-{
-	//Get rid of preexisting texture
-	free();
-
-	//Render text surface
-	SDL_Surface* textSurface = TTF_RenderText_Solid( gFont, textureText.c_str(), textColor );
-	if( textSurface != NULL )
-	{
-		//Create texture from surface pixels
-        mTexture = SDL_CreateTextureFromSurface( gRenderer, textSurface );
-		if( mTexture == NULL )
-		{
-			cout << "Unable to create texture from rendered text! SDL Error: %s\n" << SDL_GetError() << endl;
-		}
-		else
-		{
-			//Get image dimensions
-			mWidth = textSurface->w;
-			mHeight = textSurface->h;
-		}
-
-		//Get rid of old surface
-		SDL_FreeSurface( textSurface );
-	}
-	else
-	{
-		cout << "Unable to render text surface! SDL_ttf Error: %s\n" << TTF_GetError() << endl;
-	}
-
-
-	//Return success
-	return mTexture != NULL;
-}
-#endif
-
-void LTexture::free()
-{
-	//Free texture if it exists
-	if( mTexture != NULL )
-	{
-		SDL_DestroyTexture( mTexture );
-		mTexture = NULL;
-		mWidth = 0;
-		mHeight = 0;
-	}
-}
-
-void LTexture::setColor( Uint8 red, Uint8 green, Uint8 blue )
-{
-	//Modulate texture rgb
-	SDL_SetTextureColorMod( mTexture, red, green, blue );
-}
-
-void LTexture::setBlendMode( SDL_BlendMode blending )
-{
-	//Set blending function
-	SDL_SetTextureBlendMode( mTexture, blending );
-}
-
-void LTexture::setAlpha( Uint8 alpha )
-{
-	//Modulate texture alpha
-	SDL_SetTextureAlphaMod( mTexture, alpha );
-}
-
-void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip )
-{
-	//Set rendering space and render to screen
-	SDL_Rect renderQuad = { x, y, mWidth, mHeight };
-
-	//Set clip rendering dimensions
-	if( clip != NULL )
-	{
-		renderQuad.w = clip->w;
-		renderQuad.h = clip->h;
-	}
-
-	//Render to screen
-	SDL_RenderCopyEx( gRenderer, mTexture, clip, &renderQuad, angle, center, flip );
-}
-
-int LTexture::getWidth()
-{
-	return mWidth;
-}
-
-int LTexture::getHeight()
-{
-	return mHeight;
-}
-
 bool init()
 {
 	//Initialization flag
@@ -367,10 +174,10 @@ bool loadMedia()
 	}
 
 	//Initialize data textures
-	gDataTextures[ 0 ].loadFromRenderedText( to_string ( (LLONG_MAX) gData[ 0 ] ) highlightColor );
+	gDataTextures[ 0 ].loadFromRenderedText( to_string( (long long)gData[ 0 ] ), highlightColor );
 	for( int i = 1; i < TOTAL_DATA; ++i )
 	{
-		gDataTextures[ i ].loadFromRenderedText( to_string ( (LLONG_MAX)gData[ i ] ) textColor );
+		gDataTextures[ i ].loadFromRenderedText( to_string( (long long)gData[ i ] ), textColor );
 	}
 
 	return success;
@@ -466,7 +273,7 @@ int main( int argc, char* args[] )
 							//Previous data entry
 							case SDLK_UP:
 							//Rerender previous entry input point
-							gDataTextures[ currentData ].loadFromRenderedText( to_string( (LLONG_MAX)gData[ currentData ] ) textColor );
+							gDataTextures[ currentData ].loadFromRenderedText( to_string( (long long)gData[ currentData ] ), textColor );
 							--currentData;
 							if( currentData < 0 )
 							{
@@ -474,13 +281,13 @@ int main( int argc, char* args[] )
 							}
 
 							//Rerender current entry input point
-							gDataTextures[ currentData ].loadFromRenderedText( to_string( (LLONG_MAX)gData[ currentData ] ), highlightColor );
+							gDataTextures[ currentData ].loadFromRenderedText( to_string( (long long)gData[ currentData ] ), highlightColor );
 							break;
 
 							//Next data entry
 							case SDLK_DOWN:
 							//Rerender previous entry input point
-							gDataTextures[ currentData ].loadFromRenderedText( to_string( (LLONG_MAX)gData[ currentData ] ) textColor );
+							gDataTextures[ currentData ].loadFromRenderedText( to_string( (long long)gData[ currentData ] ), textColor );
 							++currentData;
 							if( currentData == TOTAL_DATA )
 							{
@@ -488,19 +295,19 @@ int main( int argc, char* args[] )
 							}
 
 							//Rerender current entry input point
-							gDataTextures[ currentData ].loadFromRenderedText( to_string( (LLONG_MAX)gData[ currentData ] ) highlightColor );
+							gDataTextures[ currentData ].loadFromRenderedText( to_string( (long long)gData[ currentData ] ), highlightColor );
 							break;
 
 							//Decrement input point
 							case SDLK_LEFT:
 							--gData[ currentData ];
-							gDataTextures[ currentData ].loadFromRenderedText( to_string( (LLONG_MAX)gData[ currentData ] ) highlightColor );
+							gDataTextures[ currentData ].loadFromRenderedText( to_string( (long long)gData[ currentData ] ), highlightColor );
 							break;
 
 							//Increment input point
 							case SDLK_RIGHT:
 							++gData[ currentData ];
-							gDataTextures[ currentData ].loadFromRenderedText( to_string( (LLONG_MAX)gData[ currentData ] ) highlightColor );
+							gDataTextures[ currentData ].loadFromRenderedText( to_string( (long long)gData[ currentData ] ), highlightColor );
 							break;
 						}
 					}
@@ -0,0 +1,235 @@
+#include "JobPool.h"
+#include <iostream>
+
+using namespace std;
+
+JobPool::JobPool( int threads )
+{
+	//Clamp thread count
+	if( threads < 1 )
+	{
+		threads = 1;
+	}
+	if( threads > MAX_THREADS )
+	{
+		threads = MAX_THREADS;
+	}
+	mThreadCount = threads;
+
+	//Initialize job state
+	mFunction = NULL;
+	mData = NULL;
+	mCount = 0;
+	mChunkSize = 1;
+	SDL_AtomicSet( &mRemaining, 0 );
+	SDL_AtomicSet( &mSteals, 0 );
+	for( int i = 0; i < MAX_THREADS; ++i )
+	{
+		mThreads[ i ] = NULL;
+		mQueues[ i ].lock = 0;
+		mQueues[ i ].front = 0;
+		mQueues[ i ].back = 0;
+	}
+
+	//Create synchronization primitives
+	mWakeLock = SDL_CreateMutex();
+	mWakeCondition = SDL_CreateCond();
+	mDone = SDL_CreateSemaphore( 0 );
+	mGeneration = 0;
+	mQuit = false;
+
+	//Slot 0 is the calling thread, start the rest
+	for( int i = 1; i < mThreadCount; ++i )
+	{
+		mWorkerInfo[ i ].pool = this;
+		mWorkerInfo[ i ].index = i;
+		mThreads[ i ] = SDL_CreateThread( workerMain, "JobWorker", &mWorkerInfo[ i ] );
+
+		//Carry on with the workers already running
+		if( mThreads[ i ] == NULL )
+		{
+			cout << "Unable to create job worker! SDL Error: " << SDL_GetError() << endl;
+			mThreadCount = i;
+			break;
+		}
+	}
+}
+
+JobPool::~JobPool()
+{
+	//Wake workers so they see the quit flag
+	SDL_LockMutex( mWakeLock );
+	mQuit = true;
+	SDL_CondBroadcast( mWakeCondition );
+	SDL_UnlockMutex( mWakeLock );
+
+	//Wait for workers to finish
+	for( int i = 1; i < mThreadCount; ++i )
+	{
+		SDL_WaitThread( mThreads[ i ], NULL );
+		mThreads[ i ] = NULL;
+	}
+
+	//Free synchronization primitives
+	SDL_DestroySemaphore( mDone );
+	SDL_DestroyCond( mWakeCondition );
+	SDL_DestroyMutex( mWakeLock );
+}
+
+void JobPool::parallelFor( int count, int chunkSize, JobFunction function, void* data )
+{
+	if( count <= 0 )
+	{
+		return;
+	}
+	if( chunkSize < 1 )
+	{
+		chunkSize = 1;
+	}
+
+	//Not worth waking anyone for a single chunk
+	int chunks = ( count + chunkSize - 1 ) / chunkSize;
+	if( chunks == 1 || mThreadCount == 1 )
+	{
+		function( 0, count, data );
+		return;
+	}
+
+	//Publish the job before any chunk becomes visible
+	mFunction = function;
+	mData = data;
+	mCount = count;
+	mChunkSize = chunkSize;
+	SDL_AtomicSet( &mRemaining, chunks );
+
+	//Give each thread a contiguous run of chunks
+	for( int i = 0; i < mThreadCount; ++i )
+	{
+		SDL_AtomicLock( &mQueues[ i ].lock );
+		mQueues[ i ].front = (int)( (Sint64)chunks * i / mThreadCount );
+		mQueues[ i ].back = (int)( (Sint64)chunks * ( i + 1 ) / mThreadCount );
+		SDL_AtomicUnlock( &mQueues[ i ].lock );
+	}
+
+	//Wake workers
+	SDL_LockMutex( mWakeLock );
+	++mGeneration;
+	SDL_CondBroadcast( mWakeCondition );
+	SDL_UnlockMutex( mWakeLock );
+
+	//Help out, then wait for whoever finishes the last chunk
+	drain( 0 );
+	SDL_SemWait( mDone );
+}
+
+int JobPool::getThreadCount()
+{
+	return mThreadCount;
+}
+
+int JobPool::getStealCount()
+{
+	return SDL_AtomicGet( &mSteals );
+}
+
+int JobPool::workerMain( void* data )
+{
+	WorkerInfo* info = (WorkerInfo*)data;
+	JobPool* pool = info->pool;
+	int seen = 0;
+
+	while( true )
+	{
+		//Sleep until there is a new job or we are told to quit
+		SDL_LockMutex( pool->mWakeLock );
+		while( pool->mGeneration == seen && !pool->mQuit )
+		{
+			SDL_CondWait( pool->mWakeCondition, pool->mWakeLock );
+		}
+		if( pool->mQuit )
+		{
+			SDL_UnlockMutex( pool->mWakeLock );
+			break;
+		}
+		seen = pool->mGeneration;
+		SDL_UnlockMutex( pool->mWakeLock );
+
+		//Work until nothing is left
+		pool->drain( info->index );
+	}
+
+	return 0;
+}
+
+void JobPool::drain( int self )
+{
+	while( true )
+	{
+		//Own queue first
+		int chunk = popFront( self );
+
+		//Then steal, starting with the next thread over
+		for( int v = 1; chunk < 0 && v < mThreadCount; ++v )
+		{
+			chunk = stealBack( ( self + v ) % mThreadCount );
+			if( chunk >= 0 )
+			{
+				SDL_AtomicAdd( &mSteals, 1 );
+			}
+		}
+
+		//Every queue is empty
+		if( chunk < 0 )
+		{
+			return;
+		}
+
+		runChunk( chunk );
+	}
+}
+
+int JobPool::popFront( int queue )
+{
+	int chunk = -1;
+
+	SDL_AtomicLock( &mQueues[ queue ].lock );
+	if( mQueues[ queue ].front < mQueues[ queue ].back )
+	{
+		chunk = mQueues[ queue ].front++;
+	}
+	SDL_AtomicUnlock( &mQueues[ queue ].lock );
+
+	return chunk;
+}
+
+int JobPool::stealBack( int queue )
+{
+	int chunk = -1;
+
+	SDL_AtomicLock( &mQueues[ queue ].lock );
+	if( mQueues[ queue ].front < mQueues[ queue ].back )
+	{
+		chunk = --mQueues[ queue ].back;
+	}
+	SDL_AtomicUnlock( &mQueues[ queue ].lock );
+
+	return chunk;
+}
+
+void JobPool::runChunk( int chunk )
+{
+	//Chunk boundaries only depend on the chunk index, never on who runs it
+	int begin = chunk * mChunkSize;
+	int end = begin + mChunkSize;
+	if( end > mCount )
+	{
+		end = mCount;
+	}
+	mFunction( begin, end, mData );
+
+	//Last chunk out wakes the caller
+	if( SDL_AtomicAdd( &mRemaining, -1 ) == 1 )
+	{
+		SDL_SemPost( mDone );
+	}
+}
@@ -0,0 +1,91 @@
+#ifndef JOB_POOL_H
+#define JOB_POOL_H
+
+#include <SDL2/SDL.h>
+
+//Work on the index range [begin, end)
+typedef void ( *JobFunction )( int begin, int end, void* data );
+
+//Fixed set of worker threads that split index ranges into stealable chunks
+class JobPool
+{
+	public:
+		//Most threads a pool can run, including the calling thread
+		static const int MAX_THREADS = 64;
+
+		//Starts threads - 1 workers, the calling thread is the last one, runs with fewer if a worker cannot be started
+		JobPool( int threads );
+
+		//Stops and joins workers
+		~JobPool();
+
+		//Runs function over [0, count) in chunks and returns once every chunk is done
+		void parallelFor( int count, int chunkSize, JobFunction function, void* data );
+
+		//Threads taking part in each job
+		int getThreadCount();
+
+		//Chunks taken from another thread's queue since creation
+		int getStealCount();
+
+	private:
+		//Per-thread chunk queue, owner pops the front and thieves take the back
+		struct ChunkQueue
+		{
+			SDL_SpinLock lock;
+			int front;
+			int back;
+
+			//A full cache line between neighbouring queues, so they never share one wherever new places the pool
+			char padding[ 64 ];
+		};
+
+		//Startup data for one worker
+		struct WorkerInfo
+		{
+			JobPool* pool;
+			int index;
+		};
+
+		//Pool is not copyable
+		JobPool( const JobPool& );
+		JobPool& operator=( const JobPool& );
+
+		//Worker thread entry point
+		static int workerMain( void* data );
+
+		//Runs chunks until every queue is empty
+		void drain( int self );
+
+		//Takes a chunk from a queue, returns -1 if it is empty
+		int popFront( int queue );
+		int stealBack( int queue );
+
+		//Runs one chunk and signals when the job finishes
+		void runChunk( int chunk );
+
+		//Threads
+		int mThreadCount;
+		SDL_Thread* mThreads[ MAX_THREADS ];
+		WorkerInfo mWorkerInfo[ MAX_THREADS ];
+		ChunkQueue mQueues[ MAX_THREADS ];
+
+		//Current job
+		JobFunction mFunction;
+		void* mData;
+		int mCount;
+		int mChunkSize;
+		SDL_atomic_t mRemaining;
+		SDL_atomic_t mSteals;
+
+		//Wakes workers for a new job
+		SDL_mutex* mWakeLock;
+		SDL_cond* mWakeCondition;
+		int mGeneration;
+		bool mQuit;
+
+		//Signalled when the last chunk finishes
+		SDL_sem* mDone;
+};
+
+#endif
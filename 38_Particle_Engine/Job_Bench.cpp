@@ -0,0 +1,96 @@
+#include <SDL2/SDL.h>
+#include <string.h>
+#include <iostream>
+#include "ParticlePool.h"
+#include "JobPool.h"
+
+using namespace std;
+
+//Particles in the benchmark emitter
+const int BENCH_PARTICLES = 1 << 20;
+
+//Simulation steps per run
+const int BENCH_STEPS = 120;
+
+//Hashes every particle so runs can be compared bit for bit
+Uint32 hashPool( ParticlePool& pool )
+{
+	Uint32 hash = 2166136261u;
+	for( int i = 0; i < pool.getCapacity(); ++i )
+	{
+		float values[ 3 ] = { pool.getPosX( i ), pool.getPosY( i ), pool.getAlpha( i ) };
+		Uint32 bits[ 3 ];
+		memcpy( bits, values, sizeof( bits ) );
+		for( int v = 0; v < 3; ++v )
+		{
+			hash = ( hash ^ bits[ v ] ) * 16777619u;
+		}
+		hash = ( hash ^ (Uint32)pool.getFrame( i ) ) * 16777619u;
+	}
+	return hash;
+}
+
+//Simulates one emitter with the given thread count, returns milliseconds per step
+double runSteps( int threads, Uint32& hash, int& steals )
+{
+	JobPool jobs( threads );
+	ParticlePool pool( BENCH_PARTICLES, 7 );
+	pool.refill( 320, 240 );
+
+	double updateSeconds = 0.0;
+	for( int s = 0; s < BENCH_STEPS; ++s )
+	{
+		//Recycling stays on this thread so the random stream is always consumed in order
+		pool.reapDead();
+		pool.refill( 320, 240 );
+
+		Uint64 start = SDL_GetPerformanceCounter();
+		pool.update( 1.f / 60.f, jobs );
+		updateSeconds += (double)( SDL_GetPerformanceCounter() - start ) / SDL_GetPerformanceFrequency();
+	}
+
+	hash = hashPool( pool );
+	steals = jobs.getStealCount();
+
+	return updateSeconds * 1000.0 / BENCH_STEPS;
+}
+
+int main( int argc, char* args[] )
+{
+	//Sweep powers of two up to the core count, and the core count itself
+	int cores = SDL_GetCPUCount();
+	int maxThreads = cores > 4 ? cores : 4;
+
+	cout << "cores: " << cores << endl;
+	cout << "threads\tms/step\tspeedup\tsteals\thash" << endl;
+
+	double baseline = 0.0;
+	Uint32 baselineHash = 0;
+	bool deterministic = true;
+	int threads = 1;
+	while( true )
+	{
+		Uint32 hash = 0;
+		int steals = 0;
+		double ms = runSteps( threads, hash, steals );
+		if( threads == 1 )
+		{
+			baseline = ms;
+			baselineHash = hash;
+		}
+		deterministic = deterministic && hash == baselineHash;
+
+		cout << threads << "\t" << ms << "\t" << baseline / ms << "\t" << steals << "\t" << hex << hash << dec << endl;
+
+		//Next power of two, capped at the largest count
+		if( threads == maxThreads )
+		{
+			break;
+		}
+		threads = threads * 2 < maxThreads ? threads * 2 : maxThreads;
+	}
+
+	cout << ( deterministic ? "deterministic: yes" : "deterministic: NO" ) << endl;
+
+	return deterministic ? 0 : 1;
+}
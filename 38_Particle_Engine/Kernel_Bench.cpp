@@ -0,0 +1,82 @@
+#include <SDL2/SDL.h>
+#include <string.h>
+#include <iostream>
+#include "ParticleKernels.h"
+
+using namespace std;
+
+//Lanes per run, large enough to spill out of cache
+const int BENCH_LANES = 1 << 20;
+
+//Steps per run
+const int BENCH_STEPS = 200;
+
+//Allocates a lane set filled with a repeatable pattern
+void fillLanes( ParticleLanes& lanes, float* storage )
+{
+	lanes.posX = storage;
+	lanes.posY = storage + BENCH_LANES;
+	lanes.velX = storage + BENCH_LANES * 2;
+	lanes.velY = storage + BENCH_LANES * 3;
+	lanes.life = storage + BENCH_LANES * 4;
+	lanes.alpha = storage + BENCH_LANES * 5;
+
+	for( int i = 0; i < BENCH_LANES; ++i )
+	{
+		lanes.posX[ i ] = (float)( i % 640 );
+		lanes.posY[ i ] = (float)( i % 480 );
+		lanes.velX[ i ] = (float)( i % 21 ) - 10.f;
+		lanes.velY[ i ] = (float)( i % 17 ) - 8.f;
+		lanes.life[ i ] = (float)( i % 100 ) / 60.f;
+		lanes.alpha[ i ] = 0.f;
+	}
+}
+
+int main( int argc, char* args[] )
+{
+	ParticleStep step;
+	step.dt = 1.f / 60.f;
+	step.accelX = 0.f;
+	step.accelY = -20.f;
+	step.alphaPerLife = 192.f * 60.f / 100.f;
+	step.maxAlpha = 192.f;
+
+	//Scalar results are the reference every other kernel must match
+	float* reference = new float[ BENCH_LANES * 6 ];
+	float* storage = new float[ BENCH_LANES * 6 ];
+
+	cout << "kernel\tMparticles/s\tmatches scalar" << endl;
+
+	for( int k = 0; k < TOTAL_KERNELS; ++k )
+	{
+		ParticleKernel kernel = (ParticleKernel)k;
+		if( !isKernelSupported( kernel ) )
+		{
+			cout << getKernelName( kernel ) << "\tunsupported" << endl;
+			continue;
+		}
+
+		ParticleLanes lanes;
+		fillLanes( lanes, storage );
+
+		Uint64 start = SDL_GetPerformanceCounter();
+		for( int s = 0; s < BENCH_STEPS; ++s )
+		{
+			updateParticleLanes( kernel, lanes, 0, BENCH_LANES, step );
+		}
+		double seconds = (double)( SDL_GetPerformanceCounter() - start ) / SDL_GetPerformanceFrequency();
+
+		if( kernel == KERNEL_SCALAR )
+		{
+			memcpy( reference, storage, sizeof( float ) * BENCH_LANES * 6 );
+		}
+		bool matches = memcmp( reference, storage, sizeof( float ) * BENCH_LANES * 6 ) == 0;
+
+		cout << getKernelName( kernel ) << "\t" << (double)BENCH_LANES * BENCH_STEPS / seconds / 1000000.0 << "\t" << ( matches ? "yes" : "no" ) << endl;
+	}
+
+	delete[] reference;
+	delete[] storage;
+
+	return 0;
+}
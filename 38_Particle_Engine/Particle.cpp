@@ -3,6 +3,12 @@
 #include <stdio.h>
 #include <string>
 #include <iostream>
+#include "ParticlePool.h"
+#include "ParticleBatch.h"
+#include "JobPool.h"
+#include "../Engine/LTexture.h"
+#include "../Engine/TextureAtlas.h"
+#include "../Engine/GameLoop.h"
 
 using namespace std;
 
@@ -13,74 +19,11 @@ const int SCREEN_HEIGHT = 480;
 //Particle count
 const int TOTAL_PARTICLES = 20;
 
-//Texture wrapper class
-class LTexture
-{
-	public:
-		//Initializes variables
-		LTexture();
-
-		//Deallocates memory
-		~LTexture();
-
-		//Loads image specific path
-		bool loadFromFile( string path );
-
-		#ifdef _SDL_TTF_H
-		//Create image from font string
-		bool loadFromRenderedText( string textureText, SDL_Color textColor );
-		#endif
-
-		//Deallocates texture
-		void free();
+//Particle simulation step in seconds
+const float PARTICLE_STEP = 1.f / 60.f;
 
-		//Set color modulation
-		void setColor( Uint8 red, Uint8 green, Uint8 blue );
-
-		//set blending
-		void setBlendMode( SDL_BlendMode blending );
-
-		//Set alpha modulation
-		void setAlpha( Uint8 alpha );
-
-		//Render texture at given point
-		void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
-
-		//Gets image dimensions
-		int getWidth();
-		int getHeight();
-
-	private:
-		//The actual hardware texture
-		SDL_Texture* mTexture;
-
-		//Image dimensions
-		int mWidth;
-		int mHeight;
-};
-
-class Particle
-{
-	public:
-		//Initialize position and animation
-		Particle( int x, int y );
-
-		//Shows the particle
-		void render();
-
-		//Checks if particle is dead
-		bool isDead();
-
-	private:
-		//Offsets
-		int mPosX, mPosY;
-
-		//Current frame of animation
-		int mFrame;
-
-		//Type of particle
-		LTexture *mTexture;
-};
+//Most steps simulated per rendered frame before time is dropped
+const int MAX_STEPS_PER_FRAME = 8;
 
 //The dot that will move
 class Dot
@@ -96,21 +39,21 @@ class Dot
 		//Initializes the variable and allocates particles
 		Dot();
 
-		//Deallocates particles
-		~Dot();
-
 		//Takes key presses and adjusts the dots velocity
 		void handleEvent( SDL_Event& e );
 
 		//Moves the dot
 		void move();
 
+		//Recycles and simulates particles by one fixed step
+		void update( float dt );
+
 		//Shows the dot on the screen
 		void render();
 
 	private:
 		//The particles
-		Particle* particles[ TOTAL_PARTICLES ];
+		ParticlePool mParticles;
 
 		//Shows the particles
 		void renderParticles();
@@ -137,6 +80,9 @@ SDL_Window* gWindow = NULL;
 //The window renderer
 SDL_Renderer* gRenderer = NULL;
 
+//Every sprite of the scene in one sheet
+TextureAtlas gSpriteAtlas;
+
 //Scene texture
 LTexture gDotTexture;
 LTexture gRedTexture;
@@ -144,189 +90,28 @@ LTexture gGreenTexture;
 LTexture gBlueTexture;
 LTexture gShimmerTexture;
 
-LTexture::LTexture()
-{
-	//Initialize
-	mTexture = NULL;
-	mWidth = 0;
-	mHeight = 0;
-}
-
-LTexture::~LTexture()
-{
-	//Deallocate
-	free();
-}
-
-bool LTexture::loadFromFile( string path )
-{
-	//Get rid of preexisting texture
-	free();
-
-	//The final texture
-	SDL_Texture* newTexture = NULL;
-
-	//Load image at specified path
-	SDL_Surface* loadedSurface = IMG_Load( path.c_str() );
-	if( loadedSurface == NULL )
-	{
-		cout << "Unable to load image %s! SDL_image Error: %s\n" << path.c_str() << IMG_GetError() << endl;
-	}
-	else
-	{
-		//Color key image
-		SDL_SetColorKey( loadedSurface, SDL_TRUE, SDL_MapRGB ( loadedSurface->format, 0, 0xFF, 0xFF ) );
-
-		//Create texture from surface pixels
-		newTexture = SDL_CreateTextureFromSurface( gRenderer, loadedSurface );
-		if( newTexture == NULL )
-		{
-			cout << "Unable to create texture from %s! SDL Error: % s\n" << path.c_str() << SDL_GetError() << endl;
-		}
-		else
-		{
-			//Get image dimensions
-			mWidth = loadedSurface->w;
-			mHeight = loadedSurface->h;
-		}
-		//Get rid of old loaded surface
-		SDL_FreeSurface( loadedSurface );
-	}
+//Particle textures indexed by particle type
+LTexture* gParticleTextures[ ParticlePool::TOTAL_PARTICLE_TYPES ] = { &gRedTexture, &gGreenTexture, &gBlueTexture };
 
-	//Return Success
-	mTexture = newTexture;
-	return mTexture != NULL;
-}
+//Atlas sprite of the shimmer, after the three particle types
+const int SPRITE_SHIMMER = ParticlePool::TOTAL_PARTICLE_TYPES;
 
-#ifdef _SDL_TTF_H
-bool LTexture::loadFromRenderedText( string textureText, SDL_Color textColor)
-{
-	//Get rid of  preexisting texture
-	free();
+//Particle alpha modulation
+const Uint8 PARTICLE_ALPHA = 192;
 
-	//Render text surface
-	SDL_Surface* textSurface = TTF_RenderText_Solid( gFont, textureText.c_str(), textColor );
-	if( textSurface != NULL )
-	{
-		//Create texture from surface pixels
-		mTexture = SDL_CreateTextureFromSurface( gRenderer, textSurface );
-		if( mTexture == NULL )
-		{
-			cout << "Unable to create texture from rendered text! SDL Error: %s\n" << SDL_GetError << endl;
-		}
-		else
-		{
-			//Get image dimensions
-			mWidth = textSurface->w;
-			mHeight = textSurface->h;
-		}
-		//Get rid of old surface
-		SDL_FreeSurface( textSurface );
-	}
-	else
-	{
-		cout << "Unable to render text surface! SDL_ttf Error: %s\n" << TTF_GetError() << endl;
-	}
+//Batched particle renderer
+ParticleBatch gParticleBatch;
 
-	//Return success
-	return mTexture != NULL;
-}
-#endif
+//Worker threads for particle simulation
+JobPool* gJobPool = NULL;
 
-void LTexture::free()
-{
-	//Free texture if it exists
-	if( mTexture != NULL )
-	{
-		SDL_DestroyTexture( mTexture );
-		mTexture = NULL;
-		mWidth = 0;
-		mHeight = 0;
-	}
-}
-
-void LTexture::setColor( Uint8 red, Uint8 green, Uint8 blue )
-{
-	//Modulate texture rgb
-	SDL_SetTextureColorMod( mTexture, red, green, blue );
-}
-
-void LTexture::setBlendMode( SDL_BlendMode blending )
-{
-	//Set blending function
-	SDL_SetTextureBlendMode( mTexture, blending );
-}
+//Draw particles in one batch or one copy per sprite
+bool gBatchParticles = true;
 
-void LTexture::setAlpha( Uint8 alpha )
-{
-	//modulate texture alpha
-	SDL_SetTextureAlphaMod( mTexture, alpha );
-}
-
-void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip )
-{
-	//Set rendering space and render to screen
-	SDL_Rect renderQuad = { x, y, mWidth, mHeight };
-
-	//Set clip rendering dimensions
-	if( clip != NULL )
-	{
-		renderQuad.w = clip->w;
-		renderQuad.h = clip->h;
-	}
+//Render copies issued through LTexture
+int gDrawCalls = 0;
 
-	//Render to screen
-	SDL_RenderCopyEx( gRenderer, mTexture, clip, &renderQuad, angle, center, flip );
-}
-
-int LTexture::getWidth()
-{
-	return mWidth;
-}
-
-int LTexture::getHeight()
-{
-	return mHeight;
-}
-
-Particle::Particle( int x, int y )
-{
-	//Set offsets
-	mPosX = x - 5 + ( rand() % 25 );
-	mPosY = y - 5 + ( rand() % 25 );
-
-	//Initialize animation
-	mFrame = rand() % 5;
-
-	//SEt type
-	switch( rand() % 3 )
-	{
-		case 0: mTexture = &gRedTexture; break;
-		case 1: mTexture = &gGreenTexture; break;
-		case 2: mTexture = &gBlueTexture; break;
-	}
-}
-
-void Particle::render()
-{
-	//Show image
-		mTexture->render( mPosX, mPosY );
-	//Show shimmer
-	if( mFrame % 2 == 0)
-	{
-		gShimmerTexture.render( mPosX, mPosY );
-	}
-
-	//Animate
-	mFrame++;
-}
-
-bool Particle::isDead()
-{
-	return mFrame > 100;
-}
-
-Dot::Dot()
+Dot::Dot() : mParticles( TOTAL_PARTICLES, SDL_GetTicks() + 1 )
 {
 	//Initialize teh offsets
 	mPosX = 0;
@@ -337,19 +122,8 @@ Dot::Dot()
 	mVelY = 0;
 
 	//Initialize particles
-	for( int i = 0; i < TOTAL_PARTICLES; ++i )
-	{
-		particles[ i ] = new Particle( mPosX, mPosY );
-	}
-}
-
-Dot::~Dot()
-{
-	//Delete particles
-	for( int i = 0; i < TOTAL_PARTICLES; ++i )
-	{
-		delete particles[ i ];
-	}
+	mParticles.setMaxAlpha( PARTICLE_ALPHA );
+	mParticles.refill( mPosX, mPosY );
 }
 
 void Dot::handleEvent( SDL_Event& e )
@@ -407,6 +181,7 @@ void Dot::render()
 {
 	//Show dot
 	gDotTexture.render( mPosX, mPosY );
+	++gDrawCalls;
 
 	//show particles on top of dot
 	renderParticles();
@@ -414,24 +189,79 @@ void Dot::render()
 
 void Dot::renderParticles()
 {
-	//Go through paricles
-	for( int i = 0; i < TOTAL_PARTICLES; ++i )
+	//Queue every particle into one batch
+	if( gBatchParticles )
 	{
-		//Delete and replace dead paricles
-		if( particles[ i ]->isDead() )
+		gParticleBatch.begin();
+		for( int i = 0; i < mParticles.getCapacity(); ++i )
 		{
-			delete particles[ i ];
-			particles[ i ] = new Particle( mPosX, mPosY );
+			if( !mParticles.isAlive( i ) )
+			{
+				continue;
+			}
+
+			int x = (int)mParticles.getPosX( i );
+			int y = (int)mParticles.getPosY( i );
+			Uint8 alpha = (Uint8)mParticles.getAlpha( i );
+
+			//Queue image
+			gParticleBatch.add( mParticles.getType( i ), x, y, alpha );
+
+			//Queue shimmer
+			if( mParticles.getFrame( i ) % 2 == 0 )
+			{
+				gParticleBatch.add( SPRITE_SHIMMER, x, y, alpha );
+			}
 		}
+		gParticleBatch.flush( gRenderer );
 	}
-
-	//show particles
-	for( int i = 0; i < TOTAL_PARTICLES; ++i )
+	//Show particles one copy at a time
+	else
 	{
-		particles[ i ]->render();
+		for( int i = 0; i < mParticles.getCapacity(); ++i )
+		{
+			if( !mParticles.isAlive( i ) )
+			{
+				continue;
+			}
+
+			int x = (int)mParticles.getPosX( i );
+			int y = (int)mParticles.getPosY( i );
+			Uint8 alpha = (Uint8)mParticles.getAlpha( i );
+
+			//Show image
+			LTexture* texture = gParticleTextures[ mParticles.getType( i ) ];
+			texture->setAlpha( alpha );
+			texture->render( x, y );
+			++gDrawCalls;
+
+			//Show shimmer
+			if( mParticles.getFrame( i ) % 2 == 0 )
+			{
+				gShimmerTexture.setAlpha( alpha );
+				gShimmerTexture.render( x, y );
+				++gDrawCalls;
+			}
+		}
 	}
 }
 
+void Dot::update( float dt )
+{
+	//Recycle dead particles in place
+	mParticles.reapDead();
+	mParticles.refill( mPosX, mPosY );
+
+	//Simulate across every core
+	mParticles.update( dt, *gJobPool );
+}
+
+//Runs one particle step of the dot passed as data, always the exact float step the kernels were checked with
+void updateParticles( void* data )
+{
+	( (Dot*)data )->update( PARTICLE_STEP );
+}
+
 bool init()
 {
 	//Initializatio flag
@@ -479,6 +309,9 @@ bool init()
 					cout << "SDL_image could not be initialized! SDL_image Error: %s\n" << IMG_GetError() << endl;
 					success = false;
 				}
+
+				//Start one simulation thread per core
+				gJobPool = new JobPool( SDL_GetCPUCount() );
 			}
 		}
 	}
@@ -490,46 +323,74 @@ bool loadMedia()
 	//Loadingsucces flag
 	bool success = true;
 
+	//Use the offline packed sheet if "make atlas" wrote one, otherwise pack at load time
+	string atlasPaths[] = { "red.bmp", "green.bmp", "blue.bmp", "shimmer.bmp", "dot.bmp" };
+	SDL_RWops* table = SDL_RWFromFile( "sprites.atlas", "r" );
+	if( table != NULL )
+	{
+		SDL_RWclose( table );
+		success = gSpriteAtlas.loadFromFile( gRenderer, "sprites.atlas" );
+	}
+	else
+	{
+		success = gSpriteAtlas.build( gRenderer, "sprites", atlasPaths, 5 );
+	}
+	if( !success )
+	{
+		cout << "Failed to load sprite atlas!\n" << endl;
+		return false;
+	}
+
 	//load dot texture
-	if( !gDotTexture.loadFromFile( "dot.bmp" ) )
+	if( !gDotTexture.loadFromAtlas( gSpriteAtlas, "dot.bmp" ) )
 	{
 		cout << "Failed to load dot texture!\n" << endl;
 		success = false;
 	}
 
 	//Load red texture
-	if( !gRedTexture.loadFromFile( "red.bmp" ) )
+	if( !gRedTexture.loadFromAtlas( gSpriteAtlas, "red.bmp" ) )
 	{
 		cout << "failed to load red texture!\n" << endl;
 		success = false;
 	}
 
 	//Load green texture
-	if( !gGreenTexture.loadFromFile( "green.bmp" ) )
+	if( !gGreenTexture.loadFromAtlas( gSpriteAtlas, "green.bmp" ) )
 	{
 		cout << "Failed to load green texture!\n" << endl;
 		success = false;
 	}
 
 	//Load blue texture
-	if( !gBlueTexture.loadFromFile( "blue.bmp" ) )
+	if( !gBlueTexture.loadFromAtlas( gSpriteAtlas, "blue.bmp" ) )
 	{
 		cout << "failed to load blue texture!\n" << endl;
 		success = false;
 	}
 
 	//Load shimmer texture
-	if( !gShimmerTexture.loadFromFile( "shimmer.bmp" ) )
+	if( !gShimmerTexture.loadFromAtlas( gSpriteAtlas, "shimmer.bmp" ) )
 	{
 		cout << "Failed to load shimmer texture!\n" << endl;
 		success = false;
 	}
 
 	//Set texture transperancy
-	gRedTexture.setAlpha( 192 );
-	gGreenTexture.setAlpha( 192 );
-	gBlueTexture.setAlpha( 192 );
-	gShimmerTexture.setAlpha( 192 );
+	gRedTexture.setAlpha( PARTICLE_ALPHA );
+	gGreenTexture.setAlpha( PARTICLE_ALPHA );
+	gBlueTexture.setAlpha( PARTICLE_ALPHA );
+	gShimmerTexture.setAlpha( PARTICLE_ALPHA );
+
+	//Particle sprites come first in the atlas paths, in particle type order
+	if( !gParticleBatch.loadAtlas( gSpriteAtlas, atlasPaths, 4 ) )
+	{
+		cout << "Failed to load particle atlas!\n" << endl;
+		success = false;
+	}
+
+	//Two quads per particle at most
+	gParticleBatch.reserve( TOTAL_PARTICLES * 2 );
 
 	return success;
 }
@@ -542,6 +403,12 @@ void close()
 	gGreenTexture.free();
 	gBlueTexture.free();
 	gShimmerTexture.free();
+	gParticleBatch.free();
+	gSpriteAtlas.free();
+
+	//Stop simulation threads
+	delete gJobPool;
+	gJobPool = NULL;
 
 	//Destroy window
 	SDL_DestroyRenderer( gRenderer );
@@ -561,6 +428,11 @@ int main()
 	{
 		cout << "Failed to initialize!\n" << endl;
 	}
+	//Load media
+	else if( !loadMedia() )
+	{
+		cout << "Failed to load media!\n" << endl;
+	}
 	else
 	{
 		//Main loop flag
@@ -572,6 +444,14 @@ int main()
 		//The dot that will be moving
 		Dot dot;
 
+		//Draw call statistics, reported once a second
+		Uint32 statsStart = SDL_GetTicks();
+		int statsFrames = 0;
+
+		//Fixed step particle simulation
+		GameLoop loop( 1.0 / PARTICLE_STEP, MAX_STEPS_PER_FRAME );
+		loop.start();
+
 		//While application is running
 		while( !quit )
 		{
@@ -583,22 +463,44 @@ int main()
 				{
 					quit = true;
 				}
+				//Toggle batching to compare draw calls
+				else if( e.type == SDL_KEYDOWN && e.key.repeat == 0 && e.key.keysym.sym == SDLK_b )
+				{
+					gBatchParticles = !gBatchParticles;
+				}
 
 				//Handle input for dot
 				dot.handleEvent( e );
+			}
 
-				//Move the dot
-				dot.move();
+			//Move the dot
+			dot.move();
 
-				//Clear screen
-				SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
-				SDL_RenderClear( gRenderer );
+			//Run as many fixed particle steps as real time has covered
+			loop.advance( updateParticles, &dot );
 
-				//Redner objects
-				dot.render();
+			//Clear screen
+			SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+			SDL_RenderClear( gRenderer );
 
-				//Update screen
-				SDL_RenderPresent( gRenderer );
+			//Redner objects
+			dot.render();
+
+			//Update screen
+			SDL_RenderPresent( gRenderer );
+
+			//Report draw calls, run with SDL_RENDER_DRIVER=software to measure the software renderer
+			++statsFrames;
+			Uint32 statsTicks = SDL_GetTicks() - statsStart;
+			if( statsTicks >= 1000 )
+			{
+				int drawCalls = gDrawCalls + gParticleBatch.getDrawCalls();
+				cout << ( gBatchParticles ? "Batched" : "Unbatched" ) << ": " << (double)drawCalls / statsFrames << " draw calls/frame, " << (double)statsTicks / statsFrames << " ms/frame" << endl;
+
+				gDrawCalls = 0;
+				gParticleBatch.resetDrawCalls();
+				statsStart = SDL_GetTicks();
+				statsFrames = 0;
 			}
 		}
 	}
@@ -609,4 +511,3 @@ int main()
 	return 0;
 
 }
-
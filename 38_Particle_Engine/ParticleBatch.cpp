@@ -0,0 +1,157 @@
+#include "ParticleBatch.h"
+#include "../Engine/TextureCache.h"
+#include <iostream>
+
+using namespace std;
+
+ParticleBatch::ParticleBatch()
+{
+	//Initialize
+	mTexture = NULL;
+	mWidth = 0;
+	mHeight = 0;
+	mSpriteCount = 0;
+	mDrawCalls = 0;
+}
+
+ParticleBatch::~ParticleBatch()
+{
+	//Deallocate
+	free();
+}
+
+bool ParticleBatch::loadAtlas( TextureAtlas& atlas, string paths[], int count )
+{
+	//Get rid of preexisting atlas
+	free();
+
+	if( count > MAX_SPRITES )
+	{
+		cout << "Too many atlas sprites: " << count << endl;
+		return false;
+	}
+
+	//Look up every sprite
+	for( int i = 0; i < count; ++i )
+	{
+		SDL_Rect* clip = atlas.getClip( paths[ i ] );
+		if( clip == NULL )
+		{
+			cout << "Unable to find " << paths[ i ] << " in atlas " << atlas.getKey() << "!" << endl;
+			return false;
+		}
+		mClips[ i ] = *clip;
+	}
+
+	//Share the sheet through the texture cache
+	mTexture = TextureCache::getInstance().acquireLoaded( atlas.getKey(), mWidth, mHeight );
+	if( mTexture == NULL )
+	{
+		cout << "Atlas " << atlas.getKey() << " is not loaded!" << endl;
+		return false;
+	}
+	mKey = atlas.getKey();
+	mSpriteCount = count;
+
+	return true;
+}
+
+void ParticleBatch::free()
+{
+	//Drop our reference to the atlas
+	if( mTexture != NULL )
+	{
+		TextureCache::getInstance().release( mKey );
+		mKey.clear();
+		mTexture = NULL;
+		mWidth = 0;
+		mHeight = 0;
+		mSpriteCount = 0;
+	}
+}
+
+void ParticleBatch::reserve( int quads )
+{
+	mVertices.reserve( quads * 4 );
+	mIndices.reserve( quads * 6 );
+}
+
+void ParticleBatch::begin()
+{
+	//Keeps capacity, so no allocation once warmed up
+	mVertices.clear();
+	mIndices.clear();
+}
+
+void ParticleBatch::add( int sprite, int x, int y, Uint8 alpha )
+{
+	SDL_Rect& clip = mClips[ sprite ];
+
+	//Texture coordinates of the clip
+	float u0 = (float)clip.x / mWidth;
+	float v0 = (float)clip.y / mHeight;
+	float u1 = (float)( clip.x + clip.w ) / mWidth;
+	float v1 = (float)( clip.y + clip.h ) / mHeight;
+
+	//Screen corners of the quad
+	float x0 = (float)x;
+	float y0 = (float)y;
+	float x1 = (float)( x + clip.w );
+	float y1 = (float)( y + clip.h );
+
+	//Vertex alpha stands in for texture alpha modulation
+	SDL_Color color = { 0xFF, 0xFF, 0xFF, alpha };
+	int base = (int)mVertices.size();
+
+	SDL_Vertex corners[ 4 ] =
+	{
+		{ { x0, y0 }, color, { u0, v0 } },
+		{ { x1, y0 }, color, { u1, v0 } },
+		{ { x1, y1 }, color, { u1, v1 } },
+		{ { x0, y1 }, color, { u0, v1 } }
+	};
+	mVertices.insert( mVertices.end(), corners, corners + 4 );
+
+	//Two triangles per quad
+	int quad[ 6 ] = { base, base + 1, base + 2, base, base + 2, base + 3 };
+	mIndices.insert( mIndices.end(), quad, quad + 6 );
+}
+
+bool ParticleBatch::flush( SDL_Renderer* renderer )
+{
+	//Nothing queued
+	if( mIndices.empty() )
+	{
+		return false;
+	}
+
+	//The atlas is shared, so undo modulation other users left on it
+	SDL_SetTextureColorMod( mTexture, 0xFF, 0xFF, 0xFF );
+	SDL_SetTextureAlphaMod( mTexture, 0xFF );
+	SDL_SetTextureBlendMode( mTexture, SDL_BLENDMODE_BLEND );
+
+	//Submit the whole batch at once
+	if( SDL_RenderGeometry( renderer, mTexture, &mVertices[ 0 ], (int)mVertices.size(), &mIndices[ 0 ], (int)mIndices.size() ) != 0 )
+	{
+		cout << "Unable to render particle batch! SDL Error: " << SDL_GetError() << endl;
+		return false;
+	}
+
+	++mDrawCalls;
+	return true;
+}
+
+SDL_Rect ParticleBatch::getClip( int sprite )
+{
+	return mClips[ sprite ];
+}
+
+int ParticleBatch::getDrawCalls()
+{
+	return mDrawCalls;
+}
+
+void ParticleBatch::resetDrawCalls()
+{
+	mDrawCalls = 0;
+}
@@ -0,0 +1,68 @@
+#ifndef PARTICLE_BATCH_H
+#define PARTICLE_BATCH_H
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+#include "../Engine/TextureAtlas.h"
+
+//Draws particle sprites from a shared atlas with one geometry call
+class ParticleBatch
+{
+	public:
+		//Maximum sprites in the atlas
+		static const int MAX_SPRITES = 8;
+
+		//Initializes variables
+		ParticleBatch();
+
+		//Deallocates memory
+		~ParticleBatch();
+
+		//Uses the atlas images loaded from paths as sprites, in order
+		bool loadAtlas( TextureAtlas& atlas, std::string paths[], int count );
+
+		//Deallocates atlas
+		void free();
+
+		//Reserves room for quads so steady state never reallocates
+		void reserve( int quads );
+
+		//Starts a new batch
+		void begin();
+
+		//Queues a sprite at the given point
+		void add( int sprite, int x, int y, Uint8 alpha = 255 );
+
+		//Submits queued quads and returns whether anything was drawn
+		bool flush( SDL_Renderer* renderer );
+
+		//Gets atlas clip of a sprite
+		SDL_Rect getClip( int sprite );
+
+		//Geometry calls issued since last reset
+		int getDrawCalls();
+		void resetDrawCalls();
+
+	private:
+		//The atlas texture and its texture cache key
+		SDL_Texture* mTexture;
+		std::string mKey;
+
+		//Atlas dimensions
+		int mWidth;
+		int mHeight;
+
+		//Sprite clips inside the atlas
+		SDL_Rect mClips[ MAX_SPRITES ];
+		int mSpriteCount;
+
+		//Queued geometry
+		std::vector<SDL_Vertex> mVertices;
+		std::vector<int> mIndices;
+
+		//Geometry calls issued
+		int mDrawCalls;
+};
+
+#endif
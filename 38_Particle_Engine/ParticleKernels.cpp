@@ -0,0 +1,118 @@
+#include "ParticleKernels.h"
+#include <SDL2/SDL.h>
+
+#ifdef CPU_HAS_X86
+#include <immintrin.h>
+#endif
+
+static void updateScalar( ParticleLanes& lanes, int begin, int end, const ParticleStep& step )
+{
+	for( int i = begin; i < end; ++i )
+	{
+		//Semi-implicit Euler
+		lanes.velX[ i ] += step.accelX * step.dt;
+		lanes.velY[ i ] += step.accelY * step.dt;
+		lanes.posX[ i ] += lanes.velX[ i ] * step.dt;
+		lanes.posY[ i ] += lanes.velY[ i ] * step.dt;
+
+		//Age and fade out
+		lanes.life[ i ] -= step.dt;
+		float alpha = lanes.life[ i ] * step.alphaPerLife;
+		if( alpha < 0.f )
+		{
+			alpha = 0.f;
+		}
+		if( alpha > step.maxAlpha )
+		{
+			alpha = step.maxAlpha;
+		}
+		lanes.alpha[ i ] = alpha;
+	}
+}
+
+#ifdef CPU_HAS_X86
+CPU_TARGET_SSE2 static void updateSSE2( ParticleLanes& lanes, int begin, int end, const ParticleStep& step )
+{
+	__m128 dt = _mm_set1_ps( step.dt );
+	__m128 dvX = _mm_set1_ps( step.accelX * step.dt );
+	__m128 dvY = _mm_set1_ps( step.accelY * step.dt );
+	__m128 alphaPerLife = _mm_set1_ps( step.alphaPerLife );
+	__m128 maxAlpha = _mm_set1_ps( step.maxAlpha );
+	__m128 zero = _mm_setzero_ps();
+
+	//Four lanes at a time
+	int i = begin;
+	for( ; i + 4 <= end; i += 4 )
+	{
+		__m128 velX = _mm_add_ps( _mm_loadu_ps( lanes.velX + i ), dvX );
+		__m128 velY = _mm_add_ps( _mm_loadu_ps( lanes.velY + i ), dvY );
+		_mm_storeu_ps( lanes.velX + i, velX );
+		_mm_storeu_ps( lanes.velY + i, velY );
+		_mm_storeu_ps( lanes.posX + i, _mm_add_ps( _mm_loadu_ps( lanes.posX + i ), _mm_mul_ps( velX, dt ) ) );
+		_mm_storeu_ps( lanes.posY + i, _mm_add_ps( _mm_loadu_ps( lanes.posY + i ), _mm_mul_ps( velY, dt ) ) );
+
+		__m128 life = _mm_sub_ps( _mm_loadu_ps( lanes.life + i ), dt );
+		_mm_storeu_ps( lanes.life + i, life );
+		_mm_storeu_ps( lanes.alpha + i, _mm_min_ps( _mm_max_ps( _mm_mul_ps( life, alphaPerLife ), zero ), maxAlpha ) );
+	}
+
+	//Leftover lanes
+	updateScalar( lanes, i, end, step );
+}
+
+CPU_TARGET_AVX2 static void updateAVX2( ParticleLanes& lanes, int begin, int end, const ParticleStep& step )
+{
+	__m256 dt = _mm256_set1_ps( step.dt );
+	__m256 dvX = _mm256_set1_ps( step.accelX * step.dt );
+	__m256 dvY = _mm256_set1_ps( step.accelY * step.dt );
+	__m256 alphaPerLife = _mm256_set1_ps( step.alphaPerLife );
+	__m256 maxAlpha = _mm256_set1_ps( step.maxAlpha );
+	__m256 zero = _mm256_setzero_ps();
+
+	//Eight lanes at a time
+	int i = begin;
+	for( ; i + 8 <= end; i += 8 )
+	{
+		__m256 velX = _mm256_add_ps( _mm256_loadu_ps( lanes.velX + i ), dvX );
+		__m256 velY = _mm256_add_ps( _mm256_loadu_ps( lanes.velY + i ), dvY );
+		_mm256_storeu_ps( lanes.velX + i, velX );
+		_mm256_storeu_ps( lanes.velY + i, velY );
+		_mm256_storeu_ps( lanes.posX + i, _mm256_add_ps( _mm256_loadu_ps( lanes.posX + i ), _mm256_mul_ps( velX, dt ) ) );
+		_mm256_storeu_ps( lanes.posY + i, _mm256_add_ps( _mm256_loadu_ps( lanes.posY + i ), _mm256_mul_ps( velY, dt ) ) );
+
+		__m256 life = _mm256_sub_ps( _mm256_loadu_ps( lanes.life + i ), dt );
+		_mm256_storeu_ps( lanes.life + i, life );
+		_mm256_storeu_ps( lanes.alpha + i, _mm256_min_ps( _mm256_max_ps( _mm256_mul_ps( life, alphaPerLife ), zero ), maxAlpha ) );
+	}
+
+	//Leftover lanes
+	updateScalar( lanes, i, end, step );
+}
+#endif
+
+bool isKernelSupported( ParticleKernel kernel )
+{
+	return isCpuLevelSupported( kernel );
+}
+
+ParticleKernel getBestKernel()
+{
+	return (ParticleKernel)getBestCpuLevel();
+}
+
+const char* getKernelName( ParticleKernel kernel )
+{
+	return getCpuLevelName( kernel );
+}
+
+void updateParticleLanes( ParticleKernel kernel, ParticleLanes& lanes, int begin, int end, const ParticleStep& step )
+{
+	switch( getRunnableCpuLevel( kernel ) )
+	{
+		#ifdef CPU_HAS_X86
+		case KERNEL_SSE2: updateSSE2( lanes, begin, end, step ); break;
+		case KERNEL_AVX2: updateAVX2( lanes, begin, end, step ); break;
+		#endif
+		default: updateScalar( lanes, begin, end, step ); break;
+	}
+}
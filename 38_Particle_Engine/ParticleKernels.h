@@ -0,0 +1,53 @@
+#ifndef PARTICLE_KERNELS_H
+#define PARTICLE_KERNELS_H
+
+#include "../Engine/CpuDispatch.h"
+
+//Instruction sets the particle update can run on
+enum ParticleKernel
+{
+	KERNEL_SCALAR = CPU_SCALAR,
+	KERNEL_SSE2 = CPU_SSE2,
+	KERNEL_AVX2 = CPU_AVX2,
+	TOTAL_KERNELS = TOTAL_CPU_LEVELS
+};
+
+//Pointers to the float lanes of a particle pool
+struct ParticleLanes
+{
+	float* posX;
+	float* posY;
+	float* velX;
+	float* velY;
+	float* life;
+	float* alpha;
+};
+
+//Per step integration constants
+struct ParticleStep
+{
+	//Step length in seconds
+	float dt;
+
+	//Constant acceleration
+	float accelX;
+	float accelY;
+
+	//Alpha per second of remaining life, alpha is clamped to maxAlpha
+	float alphaPerLife;
+	float maxAlpha;
+};
+
+//Checks whether the kernel can run on this machine
+bool isKernelSupported( ParticleKernel kernel );
+
+//Picks the widest supported kernel
+ParticleKernel getBestKernel();
+
+//Gets kernel display name
+const char* getKernelName( ParticleKernel kernel );
+
+//Integrates lanes in [begin, end) with the given kernel, falling back to scalar if unsupported
+void updateParticleLanes( ParticleKernel kernel, ParticleLanes& lanes, int begin, int end, const ParticleStep& step );
+
+#endif
@@ -0,0 +1,235 @@
+#include "ParticlePool.h"
+
+//Default lifetime, the old 100 frames at 60 frames per second
+const float DEFAULT_LIFETIME = 100.f / 60.f;
+
+//Default alpha at full life
+const float DEFAULT_MAX_ALPHA = 192.f;
+
+//Largest spawn speed on each axis in pixels per second
+const float SPAWN_SPEED = 12.f;
+
+//What a job chunk needs to update its slots
+struct UpdateJob
+{
+	ParticlePool* pool;
+	float dt;
+};
+
+//Job pool entry point
+static void updateChunk( int begin, int end, void* data )
+{
+	UpdateJob* job = (UpdateJob*)data;
+	job->pool->updateRange( begin, end, job->dt );
+}
+
+ParticlePool::ParticlePool( int capacity, Uint32 seed )
+{
+	//Allocate every array up front so steady state never touches the heap
+	mCapacity = capacity;
+	mLiveCount = 0;
+	mLanes.posX = new float[ capacity ];
+	mLanes.posY = new float[ capacity ];
+	mLanes.velX = new float[ capacity ];
+	mLanes.velY = new float[ capacity ];
+	mLanes.life = new float[ capacity ];
+	mLanes.alpha = new float[ capacity ];
+	mFrame = new int[ capacity ];
+	mType = new Uint8[ capacity ];
+	mAlive = new Uint8[ capacity ];
+	mFreeList = new int[ capacity ];
+
+	//Every slot starts free and inert, lowest index on top of the stack
+	for( int i = 0; i < capacity; ++i )
+	{
+		mLanes.posX[ i ] = 0.f;
+		mLanes.posY[ i ] = 0.f;
+		mLanes.velX[ i ] = 0.f;
+		mLanes.velY[ i ] = 0.f;
+		mLanes.life[ i ] = 0.f;
+		mLanes.alpha[ i ] = 0.f;
+		mFrame[ i ] = 0;
+		mType[ i ] = 0;
+		mAlive[ i ] = 0;
+		mFreeList[ i ] = capacity - 1 - i;
+	}
+	mFreeCount = capacity;
+
+	//Xorshift must never hold zero
+	mRandomState = seed != 0 ? seed : 1;
+
+	//Initialize tuning
+	mLifetime = DEFAULT_LIFETIME;
+	mMaxAlpha = DEFAULT_MAX_ALPHA;
+	mAccelX = 0.f;
+	mAccelY = -20.f;
+	mKernel = getBestKernel();
+}
+
+ParticlePool::~ParticlePool()
+{
+	//Deallocate
+	delete[] mLanes.posX;
+	delete[] mLanes.posY;
+	delete[] mLanes.velX;
+	delete[] mLanes.velY;
+	delete[] mLanes.life;
+	delete[] mLanes.alpha;
+	delete[] mFrame;
+	delete[] mType;
+	delete[] mAlive;
+	delete[] mFreeList;
+}
+
+void ParticlePool::setLifetime( float seconds )
+{
+	mLifetime = seconds;
+}
+
+void ParticlePool::setMaxAlpha( float alpha )
+{
+	mMaxAlpha = alpha;
+}
+
+void ParticlePool::setAcceleration( float accelX, float accelY )
+{
+	mAccelX = accelX;
+	mAccelY = accelY;
+}
+
+void ParticlePool::setKernel( ParticleKernel kernel )
+{
+	mKernel = kernel;
+}
+
+ParticleKernel ParticlePool::getKernel()
+{
+	return mKernel;
+}
+
+int ParticlePool::emit( int x, int y )
+{
+	//Same scatter and start frame as the old Particle constructor
+	float posX = (float)( x - 5 + (int)( nextRandom() % 25 ) );
+	float posY = (float)( y - 5 + (int)( nextRandom() % 25 ) );
+	int frame = nextRandom() % 5;
+	int type = nextRandom() % TOTAL_PARTICLE_TYPES;
+
+	//Drift in a random direction
+	float velX = ( (float)( nextRandom() % 2001 ) / 1000.f - 1.f ) * SPAWN_SPEED;
+	float velY = ( (float)( nextRandom() % 2001 ) / 1000.f - 1.f ) * SPAWN_SPEED;
+
+	//Older start frames have less life left
+	float life = mLifetime * ( 1.f - frame / 100.f );
+
+	return spawn( posX, posY, velX, velY, life, frame, type );
+}
+
+int ParticlePool::spawn( float x, float y, float velX, float velY, float life, int frame, int type )
+{
+	//Pool is full
+	if( mFreeCount == 0 )
+	{
+		return -1;
+	}
+
+	//Pop a free slot
+	int index = mFreeList[ --mFreeCount ];
+
+	//Set attributes
+	mLanes.posX[ index ] = x;
+	mLanes.posY[ index ] = y;
+	mLanes.velX[ index ] = velX;
+	mLanes.velY[ index ] = velY;
+	mLanes.life[ index ] = life;
+	mLanes.alpha[ index ] = life / mLifetime * mMaxAlpha;
+	mFrame[ index ] = frame;
+	mType[ index ] = (Uint8)type;
+	mAlive[ index ] = 1;
+	++mLiveCount;
+
+	return index;
+}
+
+void ParticlePool::kill( int index )
+{
+	//Only push live slots back so the free list never holds duplicates
+	if( mAlive[ index ] )
+	{
+		mAlive[ index ] = 0;
+		mFreeList[ mFreeCount++ ] = index;
+		--mLiveCount;
+	}
+}
+
+int ParticlePool::reapDead()
+{
+	int freed = 0;
+
+	//Walk backwards so the lowest free index ends up on top of the stack
+	for( int i = mCapacity - 1; i >= 0; --i )
+	{
+		if( mAlive[ i ] && mLanes.life[ i ] <= 0.f )
+		{
+			kill( i );
+			++freed;
+		}
+	}
+
+	return freed;
+}
+
+int ParticlePool::refill( int x, int y )
+{
+	int spawned = 0;
+
+	//Fill every free slot
+	while( mFreeCount > 0 )
+	{
+		emit( x, y );
+		++spawned;
+	}
+
+	return spawned;
+}
+
+void ParticlePool::update( float dt )
+{
+	updateRange( 0, mCapacity, dt );
+}
+
+void ParticlePool::update( float dt, JobPool& jobs )
+{
+	//Every slot is updated on its own, so any split gives the same result
+	UpdateJob job = { this, dt };
+	jobs.parallelFor( mCapacity, UPDATE_CHUNK_SIZE, updateChunk, &job );
+}
+
+void ParticlePool::updateRange( int begin, int end, float dt )
+{
+	//Dead lanes integrate too, which keeps the kernels branch free
+	ParticleStep step;
+	step.dt = dt;
+	step.accelX = mAccelX;
+	step.accelY = mAccelY;
+	step.alphaPerLife = mMaxAlpha / mLifetime;
+	step.maxAlpha = mMaxAlpha;
+	updateParticleLanes( mKernel, mLanes, begin, end, step );
+
+	//Adding the occupancy flag keeps the frame count branch free as well
+	for( int i = begin; i < end; ++i )
+	{
+		mFrame[ i ] += mAlive[ i ];
+	}
+}
+
+Uint32 ParticlePool::nextRandom()
+{
+	//Xorshift32
+	Uint32 x = mRandomState;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	mRandomState = x;
+	return x;
+}
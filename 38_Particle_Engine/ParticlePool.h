@@ -0,0 +1,155 @@
+#ifndef PARTICLE_POOL_H
+#define PARTICLE_POOL_H
+
+#include <SDL2/SDL.h>
+#include "ParticleKernels.h"
+#include "JobPool.h"
+
+//Structure-of-arrays particle storage with free-list recycling
+class ParticlePool
+{
+	public:
+		//Number of particle types
+		static const int TOTAL_PARTICLE_TYPES = 3;
+
+		//Slots per job chunk, a multiple of the widest kernel
+		static const int UPDATE_CHUNK_SIZE = 4096;
+
+		//Allocates storage for capacity particles, seed drives this emitter's random stream
+		ParticlePool( int capacity, Uint32 seed = 1 );
+
+		//Deallocates storage
+		~ParticlePool();
+
+		//Simulation tuning
+		void setLifetime( float seconds );
+		void setMaxAlpha( float alpha );
+		void setAcceleration( float accelX, float accelY );
+		void setKernel( ParticleKernel kernel );
+		ParticleKernel getKernel();
+
+		//Spawns a particle scattered around the given point, returns its slot or -1 if full
+		int emit( int x, int y );
+
+		//Spawns a particle with explicit attributes, returns its slot or -1 if full
+		int spawn( float x, float y, float velX, float velY, float life, int frame, int type );
+
+		//Returns a slot to the free list
+		void kill( int index );
+
+		//Frees every particle out of life, returns how many were freed
+		int reapDead();
+
+		//Refills every free slot from the given point, returns how many were spawned
+		int refill( int x, int y );
+
+		//Integrates every slot by one step of dt seconds
+		void update( float dt );
+
+		//Same as update, split into chunks across the job pool
+		void update( float dt, JobPool& jobs );
+
+		//Integrates slots in [begin, end) by one step of dt seconds
+		void updateRange( int begin, int end, float dt );
+
+		//Next value of this emitter's random stream
+		Uint32 nextRandom();
+
+		//Pool state
+		int getCapacity();
+		int getLiveCount();
+		bool isFull();
+
+		//Per-slot accessors
+		bool isAlive( int index );
+		float getPosX( int index );
+		float getPosY( int index );
+		float getAlpha( int index );
+		int getFrame( int index );
+		int getType( int index );
+
+	private:
+		//Pool is not copyable
+		ParticlePool( const ParticlePool& );
+		ParticlePool& operator=( const ParticlePool& );
+
+		//Maximum number of particles
+		int mCapacity;
+
+		//Number of live particles
+		int mLiveCount;
+
+		//Float lanes handed to the update kernels
+		ParticleLanes mLanes;
+
+		//Steps lived, drives the shimmer
+		int* mFrame;
+
+		//Type of particle
+		Uint8* mType;
+
+		//Slot occupancy
+		Uint8* mAlive;
+
+		//Stack of free slot indices
+		int* mFreeList;
+		int mFreeCount;
+
+		//Xorshift state
+		Uint32 mRandomState;
+
+		//Simulation tuning
+		float mLifetime;
+		float mMaxAlpha;
+		float mAccelX;
+		float mAccelY;
+		ParticleKernel mKernel;
+};
+
+//Accessors are inline so per-particle loops compile down to array reads
+inline int ParticlePool::getCapacity()
+{
+	return mCapacity;
+}
+
+inline int ParticlePool::getLiveCount()
+{
+	return mLiveCount;
+}
+
+inline bool ParticlePool::isFull()
+{
+	return mFreeCount == 0;
+}
+
+inline bool ParticlePool::isAlive( int index )
+{
+	return mAlive[ index ] != 0;
+}
+
+inline float ParticlePool::getPosX( int index )
+{
+	return mLanes.posX[ index ];
+}
+
+inline float ParticlePool::getPosY( int index )
+{
+	return mLanes.posY[ index ];
+}
+
+inline float ParticlePool::getAlpha( int index )
+{
+	return mLanes.alpha[ index ];
+}
+
+inline int ParticlePool::getFrame( int index )
+{
+	return mFrame[ index ];
+}
+
+inline int ParticlePool::getType( int index )
+{
+	return mType[ index ];
+}
+
+#endif
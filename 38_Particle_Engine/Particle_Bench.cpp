@@ -0,0 +1,217 @@
+#include <SDL2/SDL.h>
+#include <stdlib.h>
+#include <new>
+#include <iostream>
+#include "ParticlePool.h"
+#include "../Engine/BenchUtil.h"
+
+using namespace std;
+
+//Frames simulated per run
+const int BENCH_FRAMES = 300;
+
+//Emitter sizes to compare
+const int BENCH_SIZES[] = { 20, 1000, 100000, 250000 };
+const int TOTAL_BENCH_SIZES = 4;
+
+//Same tuning as the pool's defaults, so both paths simulate the same particles
+const float LEGACY_LIFETIME = 100.f / 60.f;
+const float LEGACY_MAX_ALPHA = 192.f;
+const float LEGACY_SPAWN_SPEED = 12.f;
+const float LEGACY_ACCEL_Y = -20.f;
+
+//Step the bench advances each frame
+const float BENCH_DT = 1.f / 60.f;
+
+//Heap allocations made since startup
+static long gAllocations = 0;
+
+//Where each run's total goes so the work is not optimized away
+volatile long gSink = 0;
+
+void* operator new( size_t size )
+{
+	++gAllocations;
+	void* p = malloc( size );
+	if( p == NULL )
+	{
+		throw bad_alloc();
+	}
+	return p;
+}
+
+void operator delete( void* p ) noexcept
+{
+	free( p );
+}
+
+//The old heap allocated particle, minus the texture draw, doing the same float update and random draws as the pool
+class LegacyParticle
+{
+	public:
+		//Initialize position, motion and animation from the same xorshift draws as ParticlePool::emit
+		LegacyParticle( int x, int y, Uint32& random )
+		{
+			mPosX = (float)( x - 5 + (int)( nextRandom( random ) % 25 ) );
+			mPosY = (float)( y - 5 + (int)( nextRandom( random ) % 25 ) );
+			mFrame = nextRandom( random ) % 5;
+			mType = nextRandom( random ) % ParticlePool::TOTAL_PARTICLE_TYPES;
+			mVelX = ( (float)( nextRandom( random ) % 2001 ) / 1000.f - 1.f ) * LEGACY_SPAWN_SPEED;
+			mVelY = ( (float)( nextRandom( random ) % 2001 ) / 1000.f - 1.f ) * LEGACY_SPAWN_SPEED;
+			mLife = LEGACY_LIFETIME * ( 1.f - mFrame / 100.f );
+			mAlpha = mLife / LEGACY_LIFETIME * LEGACY_MAX_ALPHA;
+		}
+
+		//Stands in for the render call
+		long render()
+		{
+			long drawn = (int)mPosX + (int)mPosY + mType;
+			if( mFrame % 2 == 0 )
+			{
+				drawn += 1;
+			}
+			return drawn;
+		}
+
+		//Integrates one step the way the scalar kernel does and animates
+		void update( float dt )
+		{
+			mVelY += LEGACY_ACCEL_Y * dt;
+			mPosX += mVelX * dt;
+			mPosY += mVelY * dt;
+			mLife -= dt;
+			mAlpha = mLife * ( LEGACY_MAX_ALPHA / LEGACY_LIFETIME );
+			if( mAlpha < 0.f )
+			{
+				mAlpha = 0.f;
+			}
+			if( mAlpha > LEGACY_MAX_ALPHA )
+			{
+				mAlpha = LEGACY_MAX_ALPHA;
+			}
+			mFrame++;
+		}
+
+		//Checks if particle is dead
+		bool isDead()
+		{
+			return mLife <= 0.f;
+		}
+
+	private:
+		float mPosX, mPosY;
+		float mVelX, mVelY;
+		float mLife;
+		float mAlpha;
+		int mFrame;
+		int mType;
+};
+
+//Runs the pointer array path
+void runLegacy( int count, long& allocations, double& seconds )
+{
+	//Same seed as the pool's default stream
+	Uint32 random = 1;
+	LegacyParticle** particles = new LegacyParticle*[ count ];
+	for( int i = 0; i < count; ++i )
+	{
+		particles[ i ] = new LegacyParticle( 0, 0, random );
+	}
+
+	long total = 0;
+	long startAllocations = gAllocations;
+	Uint64 start = SDL_GetPerformanceCounter();
+
+	for( int frame = 0; frame < BENCH_FRAMES; ++frame )
+	{
+		//Delete and replace dead particles
+		for( int i = 0; i < count; ++i )
+		{
+			if( particles[ i ]->isDead() )
+			{
+				delete particles[ i ];
+				particles[ i ] = new LegacyParticle( frame, frame, random );
+			}
+		}
+
+		//Show particles
+		for( int i = 0; i < count; ++i )
+		{
+			total += particles[ i ]->render();
+		}
+
+		//Move particles
+		for( int i = 0; i < count; ++i )
+		{
+			particles[ i ]->update( BENCH_DT );
+		}
+	}
+
+	seconds = getSeconds( start );
+	allocations = gAllocations - startAllocations;
+
+	for( int i = 0; i < count; ++i )
+	{
+		delete particles[ i ];
+	}
+	delete[] particles;
+
+	gSink = gSink + total;
+}
+
+//Runs the structure-of-arrays pool path at one step per frame
+void runPool( int count, long& allocations, double& seconds )
+{
+	ParticlePool pool( count );
+	pool.refill( 0, 0 );
+
+	long total = 0;
+	long startAllocations = gAllocations;
+	Uint64 start = SDL_GetPerformanceCounter();
+
+	for( int frame = 0; frame < BENCH_FRAMES; ++frame )
+	{
+		//Recycle dead particles in place
+		pool.reapDead();
+		pool.refill( frame, frame );
+
+		//Show particles
+		for( int i = 0; i < count; ++i )
+		{
+			if( pool.isAlive( i ) )
+			{
+				total += (int)pool.getPosX( i ) + (int)pool.getPosY( i ) + pool.getType( i );
+				if( pool.getFrame( i ) % 2 == 0 )
+				{
+					total += 1;
+				}
+			}
+		}
+		pool.update( BENCH_DT );
+	}
+
+	seconds = getSeconds( start );
+	allocations = gAllocations - startAllocations;
+
+	gSink = gSink + total;
+}
+
+int main( int argc, char* args[] )
+{
+	cout << "particles\tpath\tms/frame\tallocs/frame" << endl;
+
+	for( int s = 0; s < TOTAL_BENCH_SIZES; ++s )
+	{
+		int count = BENCH_SIZES[ s ];
+		long allocations = 0;
+		double seconds = 0.0;
+
+		runLegacy( count, allocations, seconds );
+		cout << count << "\tpointer\t" << seconds * 1000.0 / BENCH_FRAMES << "\t" << (double)allocations / BENCH_FRAMES << endl;
+
+		runPool( count, allocations, seconds );
+		cout << count << "\tpool\t" << seconds * 1000.0 / BENCH_FRAMES << "\t" << (double)allocations / BENCH_FRAMES << endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,212 @@
+#include <SDL2/SDL.h>
+#include <iostream>
+#include "TileMap.h"
+#include "../Engine/BenchUtil.h"
+
+using namespace std;
+
+//Generated level size in tiles
+const int BENCH_COLUMNS = 4096;
+const int BENCH_ROWS = 4096;
+
+//Same tiles and dots as the sample
+const int BENCH_TILE_WIDTH = 80;
+const int BENCH_TILE_HEIGHT = 80;
+const int BENCH_DOT_SIZE = 20;
+const int BENCH_DOT_VEL = 10;
+
+//Moving dots and frames they move for
+const int BENCH_DOTS = 5000;
+const int GRID_FRAMES = 200;
+
+//Wall checks timed with the full scan, it is far slower
+const int SCAN_QUERIES = 8;
+
+//Smaller level where every grid query is checked against the full scan
+const int CHECK_COLUMNS = 128;
+const int CHECK_ROWS = 128;
+const int CHECK_DOTS = 100;
+const int CHECK_FRAMES = 100;
+
+//One in this many generated tiles is a wall
+const int WALL_RATIO = 8;
+
+//Wall sprite type
+const int WALL_TYPE = 3;
+
+//A moving dot without a texture
+struct BenchDot
+{
+	SDL_Rect box;
+	int velX;
+	int velY;
+};
+
+//The old way, every wall tile tested against the box
+bool scanAll( TileMap& map, SDL_Rect box )
+{
+	for( int row = 0; row < map.getRows(); ++row )
+	{
+		for( int column = 0; column < map.getColumns(); ++column )
+		{
+			if( !map.isSolid( map.getTile( column, row ) ) )
+			{
+				continue;
+			}
+
+			int x = column * BENCH_TILE_WIDTH;
+			int y = row * BENCH_TILE_HEIGHT;
+			if( box.x + box.w > x && box.x < x + BENCH_TILE_WIDTH && box.y + box.h > y && box.y < y + BENCH_TILE_HEIGHT )
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+//Grid wall check, also run through the full scan when mismatches is given
+bool touchesWall( TileMap& map, SDL_Rect box, int* mismatches )
+{
+	bool touches = map.touchesSolid( box );
+	if( mismatches != NULL && scanAll( map, box ) != touches )
+	{
+		++*mismatches;
+	}
+	return touches;
+}
+
+//Same rules as Dot::move, returns how many moves were blocked
+int moveDot( TileMap& map, BenchDot& dot, int* mismatches = NULL )
+{
+	int blocked = 0;
+
+	dot.box.x += dot.velX;
+	if( dot.box.x < 0 || dot.box.x + dot.box.w > map.getPixelWidth() || touchesWall( map, dot.box, mismatches ) )
+	{
+		dot.box.x -= dot.velX;
+		dot.velX = -dot.velX;
+		++blocked;
+	}
+
+	dot.box.y += dot.velY;
+	if( dot.box.y < 0 || dot.box.y + dot.box.h > map.getPixelHeight() || touchesWall( map, dot.box, mismatches ) )
+	{
+		dot.box.y -= dot.velY;
+		dot.velY = -dot.velY;
+		++blocked;
+	}
+
+	return blocked;
+}
+
+//Generates a repeatable level with scattered walls
+void makeLevel( TileMap& map, int columns, int rows, Uint32& random )
+{
+	map.create( columns, rows, BENCH_TILE_WIDTH, BENCH_TILE_HEIGHT );
+	map.setSolid( WALL_TYPE, true );
+	for( int row = 0; row < rows; ++row )
+	{
+		for( int column = 0; column < columns; ++column )
+		{
+			map.setTile( column, row, nextRandom( random ) % WALL_RATIO == 0 ? WALL_TYPE : 0 );
+		}
+	}
+}
+
+//Scatters dots over open floor
+BenchDot* makeDots( TileMap& map, int count, Uint32& random )
+{
+	BenchDot* dots = new BenchDot[ count ];
+	for( int i = 0; i < count; ++i )
+	{
+		do
+		{
+			dots[ i ].box.x = (int)( nextRandom( random ) % (Uint32)( map.getPixelWidth() - BENCH_DOT_SIZE ) );
+			dots[ i ].box.y = (int)( nextRandom( random ) % (Uint32)( map.getPixelHeight() - BENCH_DOT_SIZE ) );
+			dots[ i ].box.w = BENCH_DOT_SIZE;
+			dots[ i ].box.h = BENCH_DOT_SIZE;
+		}
+		while( map.touchesSolid( dots[ i ].box ) );
+
+		dots[ i ].velX = random & 1 ? BENCH_DOT_VEL : -BENCH_DOT_VEL;
+		dots[ i ].velY = random & 2 ? BENCH_DOT_VEL : -BENCH_DOT_VEL;
+	}
+	return dots;
+}
+
+//Moves dots on a small level with every grid query checked by the full scan, returns how many disagreed
+int checkQueries()
+{
+	Uint32 random = 1;
+	TileMap map;
+	makeLevel( map, CHECK_COLUMNS, CHECK_ROWS, random );
+	BenchDot* dots = makeDots( map, CHECK_DOTS, random );
+
+	int mismatches = 0;
+	for( int frame = 0; frame < CHECK_FRAMES; ++frame )
+	{
+		for( int i = 0; i < CHECK_DOTS; ++i )
+		{
+			moveDot( map, dots[ i ], &mismatches );
+		}
+	}
+
+	delete[] dots;
+
+	return mismatches;
+}
+
+int main( int argc, char* args[] )
+{
+	Uint32 random = 1;
+	TileMap map;
+	makeLevel( map, BENCH_COLUMNS, BENCH_ROWS, random );
+	BenchDot* dots = makeDots( map, BENCH_DOTS, random );
+
+	cout << BENCH_COLUMNS << "x" << BENCH_ROWS << " tiles, " << BENCH_DOTS << " dots" << endl;
+	cout << "method\tns/query" << endl;
+
+	//Grid queries, two per dot per frame
+	long blocked = 0;
+	Uint64 start = SDL_GetPerformanceCounter();
+	for( int frame = 0; frame < GRID_FRAMES; ++frame )
+	{
+		for( int i = 0; i < BENCH_DOTS; ++i )
+		{
+			blocked += moveDot( map, dots[ i ] );
+		}
+	}
+	double gridSeconds = getSeconds( start );
+	double gridQueries = (double)GRID_FRAMES * BENCH_DOTS * 2;
+
+	//Full scans on a few of the boxes the dots ended on, nudged so some touch walls
+	long touching = 0;
+	start = SDL_GetPerformanceCounter();
+	for( int i = 0; i < SCAN_QUERIES; ++i )
+	{
+		SDL_Rect box = dots[ i ].box;
+		box.x += ( i % 3 - 1 ) * BENCH_TILE_WIDTH / 2;
+		box.y += ( i % 2 ) * BENCH_TILE_HEIGHT / 2;
+		touching += scanAll( map, box );
+	}
+	double scanSeconds = getSeconds( start );
+
+	cout << "grid\t" << gridSeconds * 1000000000.0 / gridQueries << endl;
+	cout << "scan\t" << scanSeconds * 1000000000.0 / SCAN_QUERIES << endl;
+	cout << blocked << " blocked moves, " << touching << " of " << SCAN_QUERIES << " scanned boxes touch walls" << endl;
+
+	delete[] dots;
+
+	//Every query the dots make on the small level has to agree with the scan
+	int mismatches = checkQueries();
+	cout << CHECK_DOTS * CHECK_FRAMES * 2 << " moves checked, " << mismatches << " wall checks disagree with the scan" << endl;
+	if( mismatches > 0 )
+	{
+		cout << "Grid wall checks disagree with the full scan!" << endl;
+		return 1;
+	}
+
+	return 0;
+}
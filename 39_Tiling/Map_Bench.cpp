@@ -0,0 +1,119 @@
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <fstream>
+#include <iostream>
+#include "TileMap.h"
+#include "../Engine/BenchUtil.h"
+
+using namespace std;
+
+//Generated level size in tiles, a little over ten million
+const int BENCH_COLUMNS = 3200;
+const int BENCH_ROWS = 3200;
+
+//Same tiles as the sample
+const int BENCH_TILE_WIDTH = 80;
+const int BENCH_TILE_HEIGHT = 80;
+const int BENCH_TILE_TYPES = 12;
+
+//Scratch files, removed when the run ends
+const char* TEXT_PATH = "bench.map";
+const char* BINARY_PATH = "bench.tmap";
+
+//Sum of every tile type, also pulls mapped pages in
+long sumTiles( TileMap& map )
+{
+	long sum = 0;
+	for( int row = 0; row < map.getRows(); ++row )
+	{
+		for( int column = 0; column < map.getColumns(); ++column )
+		{
+			sum += map.getTile( column, row );
+		}
+	}
+	return sum;
+}
+
+//Checks every tile of one layer against the parsed map, reports the first one that differs
+bool matchTiles( TileMap& parsed, TileMap& mapped, int layer )
+{
+	if( mapped.getColumns() != parsed.getColumns() || mapped.getRows() != parsed.getRows() )
+	{
+		cout << "Layer " << layer << " is " << mapped.getColumns() << "x" << mapped.getRows() << " tiles instead of " << parsed.getColumns() << "x" << parsed.getRows() << "!" << endl;
+		return false;
+	}
+
+	for( int row = 0; row < parsed.getRows(); ++row )
+	{
+		for( int column = 0; column < parsed.getColumns(); ++column )
+		{
+			if( mapped.getTile( column, row ) != parsed.getTile( column, row ) )
+			{
+				cout << "Layer " << layer << " tile " << column << ", " << row << " is " << mapped.getTile( column, row ) << " instead of " << parsed.getTile( column, row ) << "!" << endl;
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+int main( int argc, char* args[] )
+{
+	//Write a repeatable level in the text format
+	ofstream text( TEXT_PATH );
+	Uint32 random = 1;
+	for( int row = 0; row < BENCH_ROWS; ++row )
+	{
+		for( int column = 0; column < BENCH_COLUMNS; ++column )
+		{
+			random ^= random << 13;
+			random ^= random >> 17;
+			random ^= random << 5;
+			text << random % BENCH_TILE_TYPES << ( column + 1 < BENCH_COLUMNS ? " " : "\n" );
+		}
+	}
+	text.close();
+
+	cout << BENCH_COLUMNS << "x" << BENCH_ROWS << " tiles" << endl;
+	cout << "method\tload ms\tload and read ms\tmatches text" << endl;
+
+	//Text path
+	TileMap textMap;
+	Uint64 start = SDL_GetPerformanceCounter();
+	bool loaded = textMap.loadFromText( TEXT_PATH, BENCH_COLUMNS, BENCH_ROWS, BENCH_TILE_WIDTH, BENCH_TILE_HEIGHT, BENCH_TILE_TYPES );
+	double textLoad = getSeconds( start );
+	long textSum = loaded ? sumTiles( textMap ) : -1;
+	double textTotal = getSeconds( start );
+
+	//Binary path, the file cache is warm from writing it like it is for the text file
+	loaded = loaded && textMap.saveToFile( BINARY_PATH );
+	TileMap binaryMap;
+	start = SDL_GetPerformanceCounter();
+	loaded = loaded && binaryMap.loadFromFile( BINARY_PATH );
+	double binaryLoad = getSeconds( start );
+	long binarySum = loaded ? sumTiles( binaryMap ) : -2;
+	double binaryTotal = getSeconds( start );
+
+	//saveToFile writes a single layer, so layer 0 is the whole file
+	bool matches = loaded && binarySum == textSum && matchTiles( textMap, binaryMap, 0 );
+
+	cout << "text\t" << textLoad * 1000.0 << "\t" << textTotal * 1000.0 << "\t-" << endl;
+	cout << "mmap\t" << binaryLoad * 1000.0 << "\t" << binaryTotal * 1000.0 << "\t" << ( matches ? "yes" : "no" ) << endl;
+
+	//Clean up
+	binaryMap.free();
+	remove( TEXT_PATH );
+	remove( BINARY_PATH );
+
+	if( !loaded )
+	{
+		return 1;
+	}
+	if( !matches )
+	{
+		cout << "Mapped tiles do not match the parsed ones!" << endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,39 @@
+#include <SDL2/SDL.h>
+#include <stdlib.h>
+#include <string>
+#include <iostream>
+#include "TileMap.h"
+
+using namespace std;
+
+//Converts a text tile map into the binary format TileMap::loadFromFile maps
+int main( int argc, char* args[] )
+{
+	if( argc < 7 )
+	{
+		cout << "Usage: map_convert in.map out.tmap columns rows tileWidth tileHeight [typeCount]" << endl;
+		return 1;
+	}
+
+	int columns = atoi( args[ 3 ] );
+	int rows = atoi( args[ 4 ] );
+	int tileWidth = atoi( args[ 5 ] );
+	int tileHeight = atoi( args[ 6 ] );
+	int typeCount = argc > 7 ? atoi( args[ 7 ] ) : TileMap::TOTAL_TYPES;
+	if( columns <= 0 || rows <= 0 || tileWidth <= 0 || tileHeight <= 0 || typeCount <= 0 || typeCount > TileMap::TOTAL_TYPES )
+	{
+		cout << "Invalid map dimensions!" << endl;
+		return 1;
+	}
+
+	//Parse once here so the game never has to
+	TileMap map;
+	if( !map.loadFromText( args[ 1 ], columns, rows, tileWidth, tileHeight, typeCount ) || !map.saveToFile( args[ 2 ] ) )
+	{
+		cout << "Failed to convert " << args[ 1 ] << "!" << endl;
+		return 1;
+	}
+
+	cout << args[ 2 ] << ": " << columns << "x" << rows << " tiles" << endl;
+	return 0;
+}
@@ -0,0 +1,170 @@
+#include "TileLayerCache.h"
+
+TileLayerCache::TileLayerCache( int maxChunks, TileFunction drawTile, void* data )
+{
+	//Initialize
+	mMaxChunks = maxChunks;
+	mDrawTile = drawTile;
+	mData = data;
+	mFrame = 0;
+	mGeneration = 0;
+	mDrawCount = 0;
+	mBakeCount = 0;
+}
+
+TileLayerCache::~TileLayerCache()
+{
+	//Deallocate
+	clear();
+}
+
+void TileLayerCache::render( TileMap& tiles, SDL_Rect& camera )
+{
+	++mFrame;
+
+	//Chunk indices and revisions only mean something for the map they were baked from
+	if( tiles.getGeneration() != mGeneration )
+	{
+		clear();
+		mGeneration = tiles.getGeneration();
+	}
+
+	TileRange range = tiles.getRange( camera );
+	if( range.firstColumn >= range.endColumn || range.firstRow >= range.endRow )
+	{
+		return;
+	}
+
+	//Chunks under the camera
+	int chunkWidth = TileMap::CHUNK_SIZE * tiles.getTileWidth();
+	int chunkHeight = TileMap::CHUNK_SIZE * tiles.getTileHeight();
+	int firstChunkColumn = range.firstColumn / TileMap::CHUNK_SIZE;
+	int firstChunkRow = range.firstRow / TileMap::CHUNK_SIZE;
+	int lastChunkColumn = ( range.endColumn - 1 ) / TileMap::CHUNK_SIZE;
+	int lastChunkRow = ( range.endRow - 1 ) / TileMap::CHUNK_SIZE;
+	for( int chunkRow = firstChunkRow; chunkRow <= lastChunkRow; ++chunkRow )
+	{
+		for( int chunkColumn = firstChunkColumn; chunkColumn <= lastChunkColumn; ++chunkColumn )
+		{
+			int key = chunkRow * tiles.getChunkColumns() + chunkColumn;
+			std::map< int, Chunk >::iterator found = mChunks.find( key );
+
+			//Bake chunks seen for the first time
+			if( found == mChunks.end() )
+			{
+				if( (int)mChunks.size() >= mMaxChunks )
+				{
+					evict();
+				}
+
+				Chunk chunk = { new LTexture(), 0, 0 };
+				if( !bake( tiles, chunkColumn, chunkRow, chunk ) )
+				{
+					delete chunk.texture;
+					continue;
+				}
+				found = mChunks.insert( std::make_pair( key, chunk ) ).first;
+			}
+			//Rebake chunks whose tiles were edited since
+			else if( found->second.revision != tiles.getChunkRevision( chunkColumn, chunkRow ) )
+			{
+				bake( tiles, chunkColumn, chunkRow, found->second );
+			}
+
+			//One copy for the whole chunk
+			found->second.lastUsed = mFrame;
+			found->second.texture->render( chunkColumn * chunkWidth - camera.x, chunkRow * chunkHeight - camera.y );
+			++mDrawCount;
+		}
+	}
+}
+
+void TileLayerCache::clear()
+{
+	for( std::map< int, Chunk >::iterator i = mChunks.begin(); i != mChunks.end(); ++i )
+	{
+		delete i->second.texture;
+	}
+	mChunks.clear();
+}
+
+int TileLayerCache::getDrawCount()
+{
+	return mDrawCount;
+}
+
+int TileLayerCache::getBakeCount()
+{
+	return mBakeCount;
+}
+
+void TileLayerCache::resetCounts()
+{
+	mDrawCount = 0;
+	mBakeCount = 0;
+}
+
+bool TileLayerCache::bake( TileMap& tiles, int chunkColumn, int chunkRow, Chunk& chunk )
+{
+	//Target texture the size of a full chunk, created once per cached chunk
+	if( chunk.texture->getWidth() == 0 )
+	{
+		int width = TileMap::CHUNK_SIZE * tiles.getTileWidth();
+		int height = TileMap::CHUNK_SIZE * tiles.getTileHeight();
+		if( !chunk.texture->createBlank( width, height, SDL_TEXTUREACCESS_TARGET ) )
+		{
+			return false;
+		}
+		chunk.texture->setBlendMode( SDL_BLENDMODE_BLEND );
+	}
+
+	//Remember what we are drawing to and with
+	SDL_Texture* previousTarget = SDL_GetRenderTarget( gRenderer );
+	Uint8 r, g, b, a;
+	SDL_GetRenderDrawColor( gRenderer, &r, &g, &b, &a );
+
+	//Tiles past the map edge stay transparent
+	chunk.texture->setAsRenderTarget();
+	SDL_SetRenderDrawColor( gRenderer, 0x00, 0x00, 0x00, 0x00 );
+	SDL_RenderClear( gRenderer );
+
+	//Draw the chunk's tiles relative to its corner
+	int left = chunkColumn * TileMap::CHUNK_SIZE;
+	int top = chunkRow * TileMap::CHUNK_SIZE;
+	int right = left + TileMap::CHUNK_SIZE < tiles.getColumns() ? left + TileMap::CHUNK_SIZE : tiles.getColumns();
+	int bottom = top + TileMap::CHUNK_SIZE < tiles.getRows() ? top + TileMap::CHUNK_SIZE : tiles.getRows();
+	for( int row = top; row < bottom; ++row )
+	{
+		for( int column = left; column < right; ++column )
+		{
+			mDrawTile( ( column - left ) * tiles.getTileWidth(), ( row - top ) * tiles.getTileHeight(), tiles.getTile( column, row ), mData );
+		}
+	}
+
+	//Back to the previous target
+	SDL_SetRenderTarget( gRenderer, previousTarget );
+	SDL_SetRenderDrawColor( gRenderer, r, g, b, a );
+
+	chunk.revision = tiles.getChunkRevision( chunkColumn, chunkRow );
+	++mBakeCount;
+	return true;
+}
+
+void TileLayerCache::evict()
+{
+	//Find the chunk that went unused the longest
+	std::map< int, Chunk >::iterator stalest = mChunks.end();
+	for( std::map< int, Chunk >::iterator i = mChunks.begin(); i != mChunks.end(); ++i )
+	{
+		if( stalest == mChunks.end() || i->second.lastUsed < stalest->second.lastUsed )
+		{
+			stalest = i;
+		}
+	}
+
+	if( stalest != mChunks.end() )
+	{
+		delete stalest->second.texture;
+		mChunks.erase( stalest );
+	}
+}
@@ -0,0 +1,66 @@
+#ifndef TILE_LAYER_CACHE_H
+#define TILE_LAYER_CACHE_H
+
+#include <SDL2/SDL.h>
+#include <map>
+#include "TileMap.h"
+#include "../Engine/LTexture.h"
+
+//Static tile layer pre-rendered into one target texture per map chunk
+class TileLayerCache
+{
+	public:
+		//Keeps up to maxChunks chunk textures, drawTile shows one tile at a chunk relative position
+		TileLayerCache( int maxChunks, TileFunction drawTile, void* data );
+
+		//Deallocates chunk textures
+		~TileLayerCache();
+
+		//Shows every chunk under the camera, baking the ones that are missing or were edited, starts over for a different or reloaded map
+		void render( TileMap& tiles, SDL_Rect& camera );
+
+		//Drops every chunk texture, needed when the renderer loses its render targets
+		void clear();
+
+		//Chunk textures drawn and chunks baked since the last reset
+		int getDrawCount();
+		int getBakeCount();
+		void resetCounts();
+
+	private:
+		//One baked chunk
+		struct Chunk
+		{
+			LTexture* texture;
+			Uint32 revision;
+			int lastUsed;
+		};
+
+		//Cache is not copyable
+		TileLayerCache( const TileLayerCache& );
+		TileLayerCache& operator=( const TileLayerCache& );
+
+		//Renders every tile of a chunk into its texture
+		bool bake( TileMap& tiles, int chunkColumn, int chunkRow, Chunk& chunk );
+
+		//Frees the chunk that went unused the longest
+		void evict();
+
+		//Tile drawing
+		TileFunction mDrawTile;
+		void* mData;
+
+		//Baked chunks by chunk index, all from the map generation they were baked from
+		std::map< int, Chunk > mChunks;
+		Uint32 mGeneration;
+		int mMaxChunks;
+
+		//Frames rendered, used to find the stalest chunk
+		int mFrame;
+
+		//Statistics
+		int mDrawCount;
+		int mBakeCount;
+};
+
+#endif
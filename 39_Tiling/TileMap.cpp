@@ -0,0 +1,463 @@
+#include "TileMap.h"
+#include <string.h>
+#include <fstream>
+#include <iostream>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+//Last map generation handed out
+static Uint32 gLastGeneration = 0;
+
+//Releases a file mapping
+static void unmapFile( void* mapping, size_t size )
+{
+	if( mapping == NULL )
+	{
+		return;
+	}
+
+#ifndef _WIN32
+	munmap( mapping, size );
+#else
+	delete[] (Uint8*)mapping;
+#endif
+}
+
+//Maps a whole file copy on write, NULL on failure, falls back to reading it where there is no mmap
+static void* mapFile( string path, size_t& size )
+{
+#ifndef _WIN32
+	int file = open( path.c_str(), O_RDONLY );
+	if( file < 0 )
+	{
+		return NULL;
+	}
+
+	struct stat info;
+	void* mapping = NULL;
+	if( fstat( file, &info ) == 0 && info.st_size > 0 )
+	{
+		size = (size_t)info.st_size;
+		mapping = mmap( NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0 );
+		if( mapping == MAP_FAILED )
+		{
+			mapping = NULL;
+		}
+	}
+
+	//The mapping stays valid without the descriptor
+	close( file );
+	return mapping;
+#else
+	SDL_RWops* file = SDL_RWFromFile( path.c_str(), "rb" );
+	if( file == NULL )
+	{
+		return NULL;
+	}
+
+	Uint8* data = NULL;
+	Sint64 fileSize = SDL_RWsize( file );
+	if( fileSize > 0 )
+	{
+		size = (size_t)fileSize;
+		data = new Uint8[ size ];
+		if( SDL_RWread( file, data, 1, size ) != size )
+		{
+			delete[] data;
+			data = NULL;
+		}
+	}
+	SDL_RWclose( file );
+	return data;
+#endif
+}
+
+TileMap::TileMap()
+{
+	//Initialize
+	mColumns = 0;
+	mRows = 0;
+	mChunkColumns = 0;
+	mChunkRows = 0;
+	mTileWidth = 0;
+	mTileHeight = 0;
+	mGeneration = 0;
+	mTiles = NULL;
+	mMapping = NULL;
+	mMappingSize = 0;
+	memset( mSolid, 0, sizeof( mSolid ) );
+}
+
+TileMap::~TileMap()
+{
+	//Deallocate
+	free();
+}
+
+void TileMap::create( int columns, int rows, int tileWidth, int tileHeight )
+{
+	//Get rid of preexisting tiles
+	free();
+
+	setSize( columns, rows, tileWidth, tileHeight );
+	mStorage.assign( getTileCount(), 0 );
+	mTiles = &mStorage[ 0 ];
+}
+
+bool TileMap::loadFromText( string path, int columns, int rows, int tileWidth, int tileHeight, int typeCount )
+{
+	//Open the map
+	ifstream map( path.c_str() );
+	if( !map.is_open() )
+	{
+		cout << "Unable to load map file " << path << "!" << endl;
+		return false;
+	}
+
+	//Read tiles row by row
+	create( columns, rows, tileWidth, tileHeight );
+	for( int i = 0; i < columns * rows; ++i )
+	{
+		int type = -1;
+		map >> type;
+		if( map.fail() )
+		{
+			cout << "Error loading map: Unexpected end of file!" << endl;
+			free();
+			return false;
+		}
+		if( type < 0 || type >= typeCount )
+		{
+			cout << "Error loading map: Invalid tile type at " << i << endl;
+			free();
+			return false;
+		}
+
+		setTile( i % columns, i / columns, type );
+	}
+
+	return true;
+}
+
+bool TileMap::loadFromFile( string path, int layer )
+{
+	//Get rid of preexisting tiles
+	free();
+
+	//Map the file
+	size_t size = 0;
+	void* mapping = mapFile( path, size );
+	if( mapping == NULL )
+	{
+		cout << "Unable to map " << path << "!" << endl;
+		return false;
+	}
+
+	//Header fields to host byte order, the mapping is private so this never reaches the file
+	TileMapHeader* header = (TileMapHeader*)mapping;
+	if( size >= sizeof( TileMapHeader ) )
+	{
+		header->version = SDL_SwapLE32( header->version );
+		header->columns = SDL_SwapLE32( header->columns );
+		header->rows = SDL_SwapLE32( header->rows );
+		header->tileWidth = SDL_SwapLE32( header->tileWidth );
+		header->tileHeight = SDL_SwapLE32( header->tileHeight );
+		header->chunkSize = SDL_SwapLE32( header->chunkSize );
+		header->layers = SDL_SwapLE32( header->layers );
+	}
+
+	//Check the header before trusting any size in it
+	bool valid = size >= sizeof( TileMapHeader ) && memcmp( header->magic, "TMAP", 4 ) == 0 && header->version == FILE_VERSION && header->chunkSize == CHUNK_SIZE;
+
+	//Tile indices have to fit in an int
+	valid = valid && header->columns <= 32768 && header->rows <= 32768;
+
+	//Tiles need some size to divide by, and the map's size in pixels has to fit in an int
+	valid = valid && header->tileWidth > 0 && header->tileHeight > 0 &&
+		header->tileWidth <= SDL_MAX_SINT32 && header->tileHeight <= SDL_MAX_SINT32 &&
+		(Uint64)header->columns * header->tileWidth <= SDL_MAX_SINT32 && (Uint64)header->rows * header->tileHeight <= SDL_MAX_SINT32;
+	if( valid )
+	{
+		setSize( header->columns, header->rows, header->tileWidth, header->tileHeight );
+		size_t layerBytes = getTileCount() * sizeof( Uint16 );
+		valid = layer >= 0 && (Uint32)layer < header->layers && size >= sizeof( TileMapHeader ) + layerBytes * header->layers;
+	}
+	if( !valid )
+	{
+		cout << path << " is not a version " << FILE_VERSION << " map file!" << endl;
+		unmapFile( mapping, size );
+		setSize( 0, 0, 0, 0 );
+		return false;
+	}
+
+	//Tiles are used where they lie
+	mMapping = mapping;
+	mMappingSize = size;
+	mTiles = (Uint16*)( header + 1 ) + getTileCount() * layer;
+
+	//Little endian hosts use them as they are, others swap the one layer in use
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+	size_t count = getTileCount();
+	for( size_t i = 0; i < count; ++i )
+	{
+		mTiles[ i ] = SDL_SwapLE16( mTiles[ i ] );
+	}
+#endif
+
+	return true;
+}
+
+bool TileMap::saveToFile( string path )
+{
+	ofstream file( path.c_str(), ios::binary );
+	if( !file.is_open() )
+	{
+		cout << "Unable to save map file " << path << "!" << endl;
+		return false;
+	}
+
+	TileMapHeader header;
+	memcpy( header.magic, "TMAP", 4 );
+	header.version = SDL_SwapLE32( FILE_VERSION );
+	header.columns = SDL_SwapLE32( mColumns );
+	header.rows = SDL_SwapLE32( mRows );
+	header.tileWidth = SDL_SwapLE32( mTileWidth );
+	header.tileHeight = SDL_SwapLE32( mTileHeight );
+	header.chunkSize = SDL_SwapLE32( CHUNK_SIZE );
+	header.layers = SDL_SwapLE32( 1 );
+
+	//Chunk layout as it is in memory, padding included
+	file.write( (const char*)&header, sizeof( header ) );
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+	vector< Uint16 > swapped( mTiles, mTiles + getTileCount() );
+	for( size_t i = 0; i < swapped.size(); ++i )
+	{
+		swapped[ i ] = SDL_SwapLE16( swapped[ i ] );
+	}
+	if( !swapped.empty() )
+	{
+		file.write( (const char*)&swapped[ 0 ], swapped.size() * sizeof( Uint16 ) );
+	}
+#else
+	file.write( (const char*)mTiles, getTileCount() * sizeof( Uint16 ) );
+#endif
+
+	return file.good();
+}
+
+void TileMap::free()
+{
+	//Give the memory back
+	unmapFile( mMapping, mMappingSize );
+	mMapping = NULL;
+	mMappingSize = 0;
+	std::vector< Uint16 >().swap( mStorage );
+	std::vector< Uint32 >().swap( mRevisions );
+	mTiles = NULL;
+	setSize( 0, 0, 0, 0 );
+}
+
+int TileMap::getTile( int column, int row )
+{
+	return mTiles[ getIndex( column, row ) ];
+}
+
+void TileMap::setTile( int column, int row, int type )
+{
+	mTiles[ getIndex( column, row ) ] = (Uint16)type;
+	++mRevisions[ ( row >> CHUNK_SHIFT ) * mChunkColumns + ( column >> CHUNK_SHIFT ) ];
+}
+
+Uint32 TileMap::getChunkRevision( int chunkColumn, int chunkRow )
+{
+	return mRevisions[ chunkRow * mChunkColumns + chunkColumn ];
+}
+
+Uint32 TileMap::getGeneration()
+{
+	return mGeneration;
+}
+
+Uint16* TileMap::getChunk( int chunkColumn, int chunkRow )
+{
+	return mTiles + (size_t)( chunkRow * mChunkColumns + chunkColumn ) * CHUNK_SIZE * CHUNK_SIZE;
+}
+
+TileRange TileMap::getRange( SDL_Rect box )
+{
+	//Only the part of the box inside the map
+	int left = box.x < 0 ? 0 : box.x;
+	int top = box.y < 0 ? 0 : box.y;
+	int right = box.x + box.w;
+	int bottom = box.y + box.h;
+
+	//First tile touched and one past the last
+	TileRange range;
+	range.firstColumn = left / mTileWidth;
+	range.firstRow = top / mTileHeight;
+	range.endColumn = right <= 0 ? 0 : ( right + mTileWidth - 1 ) / mTileWidth;
+	range.endRow = bottom <= 0 ? 0 : ( bottom + mTileHeight - 1 ) / mTileHeight;
+
+	if( range.endColumn > mColumns )
+	{
+		range.endColumn = mColumns;
+	}
+	if( range.endRow > mRows )
+	{
+		range.endRow = mRows;
+	}
+
+	return range;
+}
+
+void TileMap::setSolid( int type, bool solid )
+{
+	if( solid )
+	{
+		mSolid[ type >> 5 ] |= 1u << ( type & 31 );
+	}
+	else
+	{
+		mSolid[ type >> 5 ] &= ~( 1u << ( type & 31 ) );
+	}
+}
+
+bool TileMap::isSolid( int type )
+{
+	return ( mSolid[ type >> 5 ] >> ( type & 31 ) ) & 1;
+}
+
+bool TileMap::touchesSolid( SDL_Rect box )
+{
+	//Only the cells under the box can touch it
+	TileRange range = getRange( box );
+	for( int row = range.firstRow; row < range.endRow; ++row )
+	{
+		for( int column = range.firstColumn; column < range.endColumn; ++column )
+		{
+			if( isSolid( mTiles[ getIndex( column, row ) ] ) )
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+int TileMap::forEachVisible( SDL_Rect camera, TileFunction function, void* data )
+{
+	TileRange range = getRange( camera );
+	if( range.firstColumn >= range.endColumn || range.firstRow >= range.endRow )
+	{
+		return 0;
+	}
+
+	//Walk chunk by chunk so each one is read straight through
+	int visited = 0;
+	int lastChunkColumn = ( range.endColumn - 1 ) >> CHUNK_SHIFT;
+	int lastChunkRow = ( range.endRow - 1 ) >> CHUNK_SHIFT;
+	for( int chunkRow = range.firstRow >> CHUNK_SHIFT; chunkRow <= lastChunkRow; ++chunkRow )
+	{
+		//Rows of this chunk inside the range
+		int chunkTop = chunkRow << CHUNK_SHIFT;
+		int firstRow = range.firstRow > chunkTop ? range.firstRow : chunkTop;
+		int endRow = range.endRow < chunkTop + CHUNK_SIZE ? range.endRow : chunkTop + CHUNK_SIZE;
+
+		for( int chunkColumn = range.firstColumn >> CHUNK_SHIFT; chunkColumn <= lastChunkColumn; ++chunkColumn )
+		{
+			//Columns of this chunk inside the range
+			int chunkLeft = chunkColumn << CHUNK_SHIFT;
+			int firstColumn = range.firstColumn > chunkLeft ? range.firstColumn : chunkLeft;
+			int endColumn = range.endColumn < chunkLeft + CHUNK_SIZE ? range.endColumn : chunkLeft + CHUNK_SIZE;
+
+			Uint16* chunk = getChunk( chunkColumn, chunkRow );
+			for( int row = firstRow; row < endRow; ++row )
+			{
+				Uint16* tiles = chunk + ( ( row - chunkTop ) << CHUNK_SHIFT );
+				for( int column = firstColumn; column < endColumn; ++column )
+				{
+					function( column * mTileWidth, row * mTileHeight, tiles[ column - chunkLeft ], data );
+				}
+			}
+			visited += ( endRow - firstRow ) * ( endColumn - firstColumn );
+		}
+	}
+
+	return visited;
+}
+
+int TileMap::getColumns()
+{
+	return mColumns;
+}
+
+int TileMap::getRows()
+{
+	return mRows;
+}
+
+int TileMap::getChunkColumns()
+{
+	return mChunkColumns;
+}
+
+int TileMap::getChunkRows()
+{
+	return mChunkRows;
+}
+
+int TileMap::getTileWidth()
+{
+	return mTileWidth;
+}
+
+int TileMap::getTileHeight()
+{
+	return mTileHeight;
+}
+
+int TileMap::getPixelWidth()
+{
+	return mColumns * mTileWidth;
+}
+
+int TileMap::getPixelHeight()
+{
+	return mRows * mTileHeight;
+}
+
+void TileMap::setSize( int columns, int rows, int tileWidth, int tileHeight )
+{
+	mColumns = columns;
+	mRows = rows;
+	mTileWidth = tileWidth;
+	mTileHeight = tileHeight;
+
+	//Round up to whole chunks
+	mChunkColumns = ( columns + CHUNK_SIZE - 1 ) >> CHUNK_SHIFT;
+	mChunkRows = ( rows + CHUNK_SIZE - 1 ) >> CHUNK_SHIFT;
+	mRevisions.assign( (size_t)mChunkColumns * mChunkRows, 0 );
+
+	//Revisions start over, so chunks baked from the old tiles must not match them
+	mGeneration = ++gLastGeneration;
+}
+
+size_t TileMap::getTileCount()
+{
+	return (size_t)mChunkColumns * mChunkRows * CHUNK_SIZE * CHUNK_SIZE;
+}
+
+int TileMap::getIndex( int column, int row )
+{
+	//Chunk first, then the tile inside it
+	int chunk = ( row >> CHUNK_SHIFT ) * mChunkColumns + ( column >> CHUNK_SHIFT );
+	int inside = ( ( row & ( CHUNK_SIZE - 1 ) ) << CHUNK_SHIFT ) | ( column & ( CHUNK_SIZE - 1 ) );
+	return ( chunk << ( CHUNK_SHIFT * 2 ) ) | inside;
+}
@@ -0,0 +1,155 @@
+#ifndef TILE_MAP_H
+#define TILE_MAP_H
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+
+//Visits one tile at its level position
+typedef void ( *TileFunction )( int x, int y, int type, void* data );
+
+//Tiles in columns [firstColumn, endColumn) and rows [firstRow, endRow)
+struct TileRange
+{
+	int firstColumn;
+	int firstRow;
+	int endColumn;
+	int endRow;
+};
+
+//Start of a binary map file, followed by layers tiles in the same chunked order as TileMap, every field little endian whatever the writer's byte order
+struct TileMapHeader
+{
+	//"TMAP"
+	char magic[ 4 ];
+
+	//TileMap::FILE_VERSION of the writer
+	Uint32 version;
+
+	//Map dimensions
+	Uint32 columns;
+	Uint32 rows;
+	Uint32 tileWidth;
+	Uint32 tileHeight;
+
+	//TileMap::CHUNK_SIZE of the writer
+	Uint32 chunkSize;
+
+	//Tile arrays stored one after the other
+	Uint32 layers;
+};
+
+//Tile types stored as one contiguous array, chunk after chunk of CHUNK_SIZE by CHUNK_SIZE tiles
+class TileMap
+{
+	public:
+		//Tiles along each side of a chunk
+		static const int CHUNK_SIZE = 16;
+
+		//Number of distinct tile types
+		static const int TOTAL_TYPES = 65536;
+
+		//Binary map format written by saveToFile
+		static const int FILE_VERSION = 1;
+
+		//Initializes variables
+		TileMap();
+
+		//Deallocates tiles
+		~TileMap();
+
+		//Allocates columns by rows tiles of type 0
+		void create( int columns, int rows, int tileWidth, int tileHeight );
+
+		//Reads columns by rows whitespace separated tile types, each below typeCount
+		bool loadFromText( std::string path, int columns, int rows, int tileWidth, int tileHeight, int typeCount );
+
+		//Maps one layer of a binary map file straight into memory, edits never reach the file
+		bool loadFromFile( std::string path, int layer = 0 );
+
+		//Writes the map as a single layer binary map file
+		bool saveToFile( std::string path );
+
+		//Deallocates tiles
+		void free();
+
+		//Gets or sets the type of the tile at column, row
+		int getTile( int column, int row );
+		void setTile( int column, int row, int type );
+
+		//Tiles of a chunk, row by row, CHUNK_SIZE tiles per row
+		Uint16* getChunk( int chunkColumn, int chunkRow );
+
+		//Goes up every time a tile in the chunk is set
+		Uint32 getChunkRevision( int chunkColumn, int chunkRow );
+
+		//Changes whenever the map is created, loaded or freed, unique across every map
+		Uint32 getGeneration();
+
+		//Tiles overlapping box, clamped to the map
+		TileRange getRange( SDL_Rect box );
+
+		//Marks which tile types block movement, none do by default
+		void setSolid( int type, bool solid );
+		bool isSolid( int type );
+
+		//Checks the tiles overlapping box for a solid one
+		bool touchesSolid( SDL_Rect box );
+
+		//Calls function for every tile overlapping camera, returns how many were visited
+		int forEachVisible( SDL_Rect camera, TileFunction function, void* data );
+
+		//Map dimensions
+		int getColumns();
+		int getRows();
+		int getChunkColumns();
+		int getChunkRows();
+		int getTileWidth();
+		int getTileHeight();
+		int getPixelWidth();
+		int getPixelHeight();
+
+	private:
+		//log2 of CHUNK_SIZE
+		static const int CHUNK_SHIFT = 4;
+
+		//Map is not copyable
+		TileMap( const TileMap& );
+		TileMap& operator=( const TileMap& );
+
+		//Tiles in one layer, chunks at the edges included
+		size_t getTileCount();
+
+		//Sets dimensions without allocating tiles
+		void setSize( int columns, int rows, int tileWidth, int tileHeight );
+
+		//Position of a tile in mTiles
+		int getIndex( int column, int row );
+
+		//Map dimensions, chunks at the edges are padded to full size
+		int mColumns;
+		int mRows;
+		int mChunkColumns;
+		int mChunkRows;
+		int mTileWidth;
+		int mTileHeight;
+
+		//Every tile type, in mStorage or inside mMapping
+		Uint16* mTiles;
+		std::vector< Uint16 > mStorage;
+
+		//Edit count of every chunk
+		std::vector< Uint32 > mRevisions;
+
+		//Tiles the revisions count from
+		Uint32 mGeneration;
+
+		//Mapped map file
+		void* mMapping;
+		size_t mMappingSize;
+
+		//One bit per tile type, set for solid types
+		Uint32 mSolid[ TOTAL_TYPES / 32 ];
+};
+
+#endif
@@ -0,0 +1,118 @@
+#include <SDL2/SDL.h>
+#include <iostream>
+#include "TileMap.h"
+
+using namespace std;
+
+//Generated level size in tiles
+const int BENCH_COLUMNS = 4096;
+const int BENCH_ROWS = 4096;
+
+//Same tiles and screen as the sample
+const int BENCH_TILE_WIDTH = 80;
+const int BENCH_TILE_HEIGHT = 80;
+const int BENCH_SCREEN_WIDTH = 640;
+const int BENCH_SCREEN_HEIGHT = 480;
+
+//Frames per run, the full scan is far slower so it gets fewer
+const int CHUNKED_FRAMES = 100000;
+const int SCAN_FRAMES = 20;
+
+//What the renderer would see, summed so nothing gets optimized away
+struct VisitTotals
+{
+	long tiles;
+	long types;
+};
+
+//Stands in for drawing a tile
+static void countTile( int x, int y, int type, void* data )
+{
+	VisitTotals* totals = (VisitTotals*)data;
+	++totals->tiles;
+	totals->types += type;
+}
+
+//Camera for a frame, sweeping diagonally across the whole level
+SDL_Rect getCamera( TileMap& map, int frame, int frames )
+{
+	SDL_Rect camera = { 0, 0, BENCH_SCREEN_WIDTH, BENCH_SCREEN_HEIGHT };
+	camera.x = (int)( (long long)( map.getPixelWidth() - camera.w ) * frame / frames );
+	camera.y = (int)( (long long)( map.getPixelHeight() - camera.h ) * frame / frames );
+	return camera;
+}
+
+//The old way, every tile tested against the camera each frame
+void scanAll( TileMap& map, SDL_Rect camera, VisitTotals& totals )
+{
+	for( int row = 0; row < map.getRows(); ++row )
+	{
+		for( int column = 0; column < map.getColumns(); ++column )
+		{
+			int x = column * BENCH_TILE_WIDTH;
+			int y = row * BENCH_TILE_HEIGHT;
+			if( x + BENCH_TILE_WIDTH > camera.x && x < camera.x + camera.w && y + BENCH_TILE_HEIGHT > camera.y && y < camera.y + camera.h )
+			{
+				countTile( x, y, map.getTile( column, row ), &totals );
+			}
+		}
+	}
+}
+
+int main( int argc, char* args[] )
+{
+	//Generate a repeatable level
+	TileMap map;
+	map.create( BENCH_COLUMNS, BENCH_ROWS, BENCH_TILE_WIDTH, BENCH_TILE_HEIGHT );
+	Uint32 random = 1;
+	for( int row = 0; row < BENCH_ROWS; ++row )
+	{
+		for( int column = 0; column < BENCH_COLUMNS; ++column )
+		{
+			random ^= random << 13;
+			random ^= random >> 17;
+			random ^= random << 5;
+			map.setTile( column, row, random % 12 );
+		}
+	}
+
+	cout << BENCH_COLUMNS << "x" << BENCH_ROWS << " tiles, " << BENCH_SCREEN_WIDTH << "x" << BENCH_SCREEN_HEIGHT << " camera" << endl;
+	cout << "method\tus/frame\ttiles/frame\tmatches scan" << endl;
+
+	//Chunked culling
+	VisitTotals chunked = { 0, 0 };
+	Uint64 start = SDL_GetPerformanceCounter();
+	for( int frame = 0; frame < CHUNKED_FRAMES; ++frame )
+	{
+		map.forEachVisible( getCamera( map, frame, CHUNKED_FRAMES ), countTile, &chunked );
+	}
+	double chunkedSeconds = (double)( SDL_GetPerformanceCounter() - start ) / SDL_GetPerformanceFrequency();
+
+	//Full scan
+	VisitTotals scanned = { 0, 0 };
+	start = SDL_GetPerformanceCounter();
+	for( int frame = 0; frame < SCAN_FRAMES; ++frame )
+	{
+		scanAll( map, getCamera( map, frame, SCAN_FRAMES ), scanned );
+	}
+	double scanSeconds = (double)( SDL_GetPerformanceCounter() - start ) / SDL_GetPerformanceFrequency();
+
+	//Both have to see the same tiles for the same cameras
+	VisitTotals check = { 0, 0 };
+	for( int frame = 0; frame < SCAN_FRAMES; ++frame )
+	{
+		map.forEachVisible( getCamera( map, frame, SCAN_FRAMES ), countTile, &check );
+	}
+	bool matches = check.tiles == scanned.tiles && check.types == scanned.types;
+
+	cout << "chunked\t" << chunkedSeconds * 1000000.0 / CHUNKED_FRAMES << "\t" << chunked.tiles / CHUNKED_FRAMES << "\t" << ( matches ? "yes" : "no" ) << endl;
+	cout << "scan\t" << scanSeconds * 1000000.0 / SCAN_FRAMES << "\t" << scanned.tiles / SCAN_FRAMES << "\t-" << endl;
+
+	if( !matches )
+	{
+		cout << "Chunked culling does not see the tiles the scan does!" << endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -3,7 +3,11 @@
 #include <stdio.h>
 #include <string>
 #include <iostream>
-#include <fstream>
+#include "../Engine/LTexture.h"
+#include "../Engine/AssetManager.h"
+#include "../Engine/Sweep.h"
+#include "TileMap.h"
+#include "TileLayerCache.h"
 
 using namespace std;
 
@@ -11,16 +15,15 @@ using namespace std;
 const int SCREEN_WIDTH = 640;
 const int SCREEN_HEIGHT = 480;
 
-//the dimension constant
-const int LEVEL_WIDTH = 1280;
-const int LEVEL_HEIGHT = 960;
-
 //Tile constant
 const int TILE_WIDTH = 80;
 const int TILE_HEIGHT = 80;
-const int TOTAL_TILES = 192;
 const int TOTAL_TILE_SPRITES = 12;
 
+//the dimension constant of lazy.map in tiles
+const int LEVEL_COLUMNS = 16;
+const int LEVEL_ROWS = 12;
+
 //The different tile sprites
 const int TILE_RED = 0;
 const int TILE_GREEN = 1;
@@ -35,76 +38,14 @@ const int TILE_BOTTOMLEFT = 9;
 const int TILE_LEFT = 10;
 const int TILE_TOPLEFT = 11;
 
+//Most decoded images uploaded to the renderer per frame
+const int UPLOADS_PER_FRAME = 1;
 
-//Texture wrapper class
-class LTexture
-{
-	public:
-		//Initializes variables
-		LTexture();
-
-		//Deallocates memory
-		~LTexture();
-
-		//Loads image specific path
-		bool loadFromFile( string path );
-
-		#ifdef _SDL_TTF_H
-		//Create image from font string
-		bool loadFromRenderedText( string textureText, SDL_Color textColor );
-		#endif
-
-		//Deallocates texture
-		void free();
-
-		//Set color modulation
-		void setColor( Uint8 red, Uint8 green, Uint8 blue );
-
-		//set blending
-		void setBlendMode( SDL_BlendMode blending );
-
-		//Set alpha modulation
-		void setAlpha( Uint8 alpha );
-
-		//Render texture at given point
-		void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
-
-		//Gets image dimensions
-		int getWidth();
-		int getHeight();
-
-	private:
-		//The actual hardware texture
-		SDL_Texture* mTexture;
-
-		//Image dimensions
-		int mWidth;
-		int mHeight;
-};
-
-//The tile class
-class Tile
-{
-	public:
-		//Initialize position and animation
-		Tile( int x, int y, int tileType );
-
-		//Shows the tile
-		void render( SDL_Rect& camera );
+//Image decoder threads
+const int DECODER_THREADS = 2;
 
-		//Gets the tile type
-		int getType();
-
-		//Get the collision box
-		SDL_Rect getBox();
-
-	private:
-		//attributes of the ttile
-		SDL_Rect mBox;
-
-		//Tile Type
-		int mType;
-};
+//Most baked chunk textures kept, enough to cover the screen several times
+const int MAX_CHUNK_TEXTURES = 16;
 
 //The dot that will move
 class Dot
@@ -123,11 +64,11 @@ class Dot
 		//Takes key presses and adjusts the dots velocity
 		void handleEvent( SDL_Event& e );
 
-		//Moves the dot and check collision against tiles
-		void move( Tile *tiles[] );
+		//Moves the dot up to the first wall tile in its way on each axis
+		void move( TileMap& tiles );
 
-		//Centers the camera over the dot
-		void setCamera( SDL_Rect& camera );
+		//Centers the camera over the dot, inside the level
+		void setCamera( SDL_Rect& camera, TileMap& tiles );
 
 		//Shows the dot on the screen
 		void render( SDL_Rect& camera);
@@ -143,20 +84,29 @@ class Dot
 //Starts SDL and creates window
 bool init();
 
-//Loads media
-bool loadMedia( Tile* tiles[] );
+//Loads media, images are only requested when loading in the background
+bool loadMedia( TileMap& tiles );
 
-//Frees media and shuts down SDL
-void close( Tile* tiles[] );
+//Takes the background loaded images once the asset manager is idle
+bool finishLoading();
 
-//Box collision detector
-bool checkCollision( SDL_Rect a, SDL_Rect b );
+//Frees media and shuts down SDL
+void close( TileMap& tiles );
 
-//Checks collision box against set of tiles
-bool touchesWall( SDL_Rect box, Tile* tiles[] );
+//Sweeps collision box against the wall tiles along its path, true with the earliest contact if it hits one
+bool sweepWalls( SDL_Rect box, int velX, int velY, TileMap& tiles, SweepHit& hit );
 
 //Sets tiles from tile map
-bool setTiles( Tile *tiles[] );
+bool setTiles( TileMap& tiles );
+
+//Shows the tiles on the screen
+void renderTiles( TileMap& tiles, SDL_Rect& camera );
+
+//Cycles the sprite of the tile at a level position
+void editTile( TileMap& tiles, int x, int y );
+
+//Draws one tile into a chunk texture
+void bakeTile( int x, int y, int type, void* data );
 
 //The window we'll be rendering to
 SDL_Window* gWindow = NULL;
@@ -169,184 +119,19 @@ LTexture gDotTexture;
 LTexture gTileTexture;
 SDL_Rect gTileClips[ TOTAL_TILE_SPRITES ];
 
-LTexture::LTexture()
-{
-	//Initialize
-	mTexture = NULL;
-	mWidth = 0;
-	mHeight = 0;
-}
-
-LTexture::~LTexture()
-{
-	//Deallocate
-	free();
-}
-
-bool LTexture::loadFromFile( string path )
-{
-	//Get rid of preexisting texture
-	free();
-
-	//The final texture
-	SDL_Texture* newTexture = NULL;
-
-	//Load image at specified path
-	SDL_Surface* loadedSurface = IMG_Load( path.c_str() );
-	if( loadedSurface == NULL )
-	{
-		cout << "Unable to load image %s! SDL_image Error: %s\n" << path.c_str() << IMG_GetError() << endl;
-	}
-	else
-	{
-		//Color key image
-		SDL_SetColorKey( loadedSurface, SDL_TRUE, SDL_MapRGB ( loadedSurface->format, 0, 0xFF, 0xFF ) );
+//Decodes images off the main thread
+AssetManager* gAssets = NULL;
+AssetHandle gDotAsset = 0;
+AssetHandle gTileAsset = 0;
 
-		//Create texture from surface pixels
-		newTexture = SDL_CreateTextureFromSurface( gRenderer, loadedSurface );
-		if( newTexture == NULL )
-		{
-			cout << "Unable to create texture from %s! SDL Error: % s\n" << path.c_str() << SDL_GetError() << endl;
-		}
-		else
-		{
-			//Get image dimensions
-			mWidth = loadedSurface->w;
-			mHeight = loadedSurface->h;
-		}
-		//Get rid of old loaded surface
-		SDL_FreeSurface( loadedSurface );
-	}
+//Load images in the background instead of before the first frame
+bool gAsyncLoading = true;
 
-	//Return Success
-	mTexture = newTexture;
-	return mTexture != NULL;
-}
+//The level pre-rendered into chunk textures
+TileLayerCache gTileCache( MAX_CHUNK_TEXTURES, bakeTile, NULL );
 
-#ifdef _SDL_TTF_H
-bool LTexture::loadFromRenderedText( string textureText, SDL_Color textColor)
-{
-	//Get rid of  preexisting texture
-	free();
-
-	//Render text surface
-	SDL_Surface* textSurface = TTF_RenderText_Solid( gFont, textureText.c_str(), textColor );
-	if( textSurface != NULL )
-	{
-		//Create texture from surface pixels
-		mTexture = SDL_CreateTextureFromSurface( gRenderer, textSurface );
-		if( mTexture == NULL )
-		{
-			cout << "Unable to create texture from rendered text! SDL Error: %s\n" << SDL_GetError << endl;
-		}
-		else
-		{
-			//Get image dimensions
-			mWidth = textSurface->w;
-			mHeight = textSurface->h;
-		}
-		//Get rid of old surface
-		SDL_FreeSurface( textSurface );
-	}
-	else
-	{
-		cout << "Unable to render text surface! SDL_ttf Error: %s\n" << TTF_GetError() << endl;
-	}
-
-	//Return success
-	return mTexture != NULL;
-}
-#endif
-
-void LTexture::free()
-{
-	//Free texture if it exists
-	if( mTexture != NULL )
-	{
-		SDL_DestroyTexture( mTexture );
-		mTexture = NULL;
-		mWidth = 0;
-		mHeight = 0;
-	}
-}
-
-void LTexture::setColor( Uint8 red, Uint8 green, Uint8 blue )
-{
-	//Modulate texture rgb
-	SDL_SetTextureColorMod( mTexture, red, green, blue );
-}
-
-void LTexture::setBlendMode( SDL_BlendMode blending )
-{
-	//Set blending function
-	SDL_SetTextureBlendMode( mTexture, blending );
-}
-
-void LTexture::setAlpha( Uint8 alpha )
-{
-	//modulate texture alpha
-	SDL_SetTextureAlphaMod( mTexture, alpha );
-}
-
-void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip )
-{
-	//Set rendering space and render to screen
-	SDL_Rect renderQuad = { x, y, mWidth, mHeight };
-
-	//Set clip rendering dimensions
-	if( clip != NULL )
-	{
-		renderQuad.w = clip->w;
-		renderQuad.h = clip->h;
-	}
-
-	//Render to screen
-	SDL_RenderCopyEx( gRenderer, mTexture, clip, &renderQuad, angle, center, flip );
-}
-
-int LTexture::getWidth()
-{
-	return mWidth;
-}
-
-int LTexture::getHeight()
-{
-	return mHeight;
-}
-
-Tile::Tile( int x, int y, int tileType )
-{
-	//Set offsets
-	mBox.x = x;
-	mBox.y = y;
-
-	//Set the collision box
-	mBox.w = TILE_WIDTH;
-	mBox.h = TILE_HEIGHT;
-
-	//SEt type
-	mType = tileType;
-}
-
-void Tile::render( SDL_Rect& camera )
-{
-	//If tile is on the screen
-	if( checkCollision( camera, mBox ) )
-	{
-		//Show the tile
-		gTileTexture.render( mBox.x - camera.x, mBox.y - camera.y, &gTileClips[ mType ] );
-	}
-}
-
-int Tile::getType()
-{
-	return mType;
-}
-
-SDL_Rect Tile::getBox()
-{
-	return mBox;
-}
+//Draw the level from chunk textures instead of one copy per tile
+bool gCacheTiles = true;
 
 Dot::Dot()
 {
@@ -362,7 +147,6 @@ Dot::Dot()
 
 }
 
-
 void Dot::handleEvent( SDL_Event& e )
 {
 	//If a key was pressed
@@ -391,30 +175,37 @@ void Dot::handleEvent( SDL_Event& e )
 	}
 }
 
-void Dot::move( Tile *tiles[] )
+void Dot::move( TileMap& tiles )
 {
-	//move the dot left or right
-	mBox.x += mVelX;
+	//Move the dot left or right, stopping against a wall instead of short of it
+	SweepHit hit;
+	mBox.x += sweepWalls( mBox, mVelX, 0, tiles, hit ) ? getSweepTravel( mVelX, hit ) : mVelX;
 
-	//If the dot went too far to the left or right
-	if( ( mBox.x < 0 ) || (mBox.x + DOT_WIDTH > LEVEL_WIDTH ) || touchesWall( mBox, tiles ) )
+	//Keep the dot in the level
+	if( mBox.x < 0 )
+	{
+		mBox.x = 0;
+	}
+	else if( mBox.x + DOT_WIDTH > tiles.getPixelWidth() )
 	{
-		//Move back
-		mBox.x -= mVelX;
+		mBox.x = tiles.getPixelWidth() - DOT_WIDTH;
 	}
 
 	//Move the dot up or down
-	mBox.y += mVelY;
+	mBox.y += sweepWalls( mBox, 0, mVelY, tiles, hit ) ? getSweepTravel( mVelY, hit ) : mVelY;
 
-	//If the dot went too far up or down or touched a wall
-	if( ( mBox.y < 0 ) || ( mBox.y + DOT_HEIGHT > LEVEL_HEIGHT ) || touchesWall( mBox, tiles ) )
+	//Keep the dot in the level
+	if( mBox.y < 0 )
 	{
-		//Move back
-		mBox.y -= mVelY;
+		mBox.y = 0;
+	}
+	else if( mBox.y + DOT_HEIGHT > tiles.getPixelHeight() )
+	{
+		mBox.y = tiles.getPixelHeight() - DOT_HEIGHT;
 	}
 }
 
-void Dot::setCamera( SDL_Rect& camera)
+void Dot::setCamera( SDL_Rect& camera, TileMap& tiles )
 {
 	//Center the camera over the  dot
 	camera.x = ( mBox.x + DOT_WIDTH / 2 ) - SCREEN_WIDTH / 2;
@@ -429,13 +220,13 @@ void Dot::setCamera( SDL_Rect& camera)
 	{
 		camera.y = 0;
 	}
-	if( camera.x > LEVEL_WIDTH - camera.w )
+	if( camera.x > tiles.getPixelWidth() - camera.w )
 	{
-		camera.x = LEVEL_WIDTH - camera.w;
+		camera.x = tiles.getPixelWidth() - camera.w;
 	}
-	if( camera.y > LEVEL_HEIGHT - camera.h )
+	if( camera.y > tiles.getPixelHeight() - camera.h )
 	{
-		camera.y = LEVEL_HEIGHT - camera.h;
+		camera.y = tiles.getPixelHeight() - camera.h;
 	}
 }
 
@@ -492,29 +283,43 @@ bool init()
 					cout << "SDL_image could not be initialized! SDL_image Error: %s\n" << IMG_GetError() << endl;
 					success = false;
 				}
+				//Start image decoders
+				else if( gAsyncLoading )
+				{
+					gAssets = new AssetManager( gRenderer, DECODER_THREADS );
+				}
 			}
 		}
 	}
 	return success;
 }
 
-bool loadMedia( Tile* tiles[] )
+bool loadMedia( TileMap& tiles )
 {
 	//Loading success flag
 	bool success = true;
 
-	//load dot texture
-	if( !gDotTexture.loadFromFile( "dot.bmp" ) )
+	//Decode images while the first frames are shown
+	if( gAsyncLoading )
 	{
-		cout << "Failed to load dot texture!\n" << endl;
-		success = false;
+		gDotAsset = gAssets->request( "dot.bmp" );
+		gTileAsset = gAssets->request( "tiles.png" );
 	}
-
-	//Load tile texture
-	if( !gTileTexture.loadFromFile( "tiles.png" ) )
+	else
 	{
-		cout << "failed to load tile set texture!\n" << endl;
-		success = false;
+		//load dot texture
+		if( !gDotTexture.loadFromFile( "dot.bmp" ) )
+		{
+			cout << "Failed to load dot texture!\n" << endl;
+			success = false;
+		}
+
+		//Load tile texture
+		if( !gTileTexture.loadFromFile( "tiles.png" ) )
+		{
+			cout << "failed to load tile set texture!\n" << endl;
+			success = false;
+		}
 	}
 
 	//Load tile map
@@ -527,21 +332,44 @@ bool loadMedia( Tile* tiles[] )
 	return success;
 }
 
-void close( Tile* tiles[] )
+bool finishLoading()
 {
-	//Deallocates tiles
-	for( int i = 0; i < TOTAL_TILES; ++i )
+	//Loading success flag
+	bool success = true;
+
+	//Both loads are texture cache hits by now
+	if( !gAssets->isReady( gDotAsset ) || !gDotTexture.loadFromFile( "dot.bmp" ) )
 	{
-		if( tiles[ i ] == NULL )
-		{
-			delete tiles[ i ];
-			tiles[ i ] = NULL;
-		}
+		cout << "Failed to load dot texture!" << endl;
+		success = false;
 	}
+	if( !gAssets->isReady( gTileAsset ) || !gTileTexture.loadFromFile( "tiles.png" ) )
+	{
+		cout << "Failed to load tile set texture!" << endl;
+		success = false;
+	}
+
+	return success;
+}
+
+void close( TileMap& tiles )
+{
+	//Deallocates tiles
+	tiles.free();
 
 	//Free loaded images
 	gDotTexture.free();
 	gTileTexture.free();
+	gTileCache.clear();
+
+	//Stop decoders and let go of their images before the renderer goes
+	if( gAssets != NULL )
+	{
+		gAssets->release( gDotAsset );
+		gAssets->release( gTileAsset );
+		delete gAssets;
+		gAssets = NULL;
+	}
 
 	//Destroy window
 	SDL_DestroyRenderer( gRenderer );
@@ -554,107 +382,34 @@ void close( Tile* tiles[] )
 	SDL_Quit();
 }
 
-bool checkCollision( SDL_Rect a, SDL_Rect b )
+bool setTiles( TileMap& tiles )
 {
-	//The sides of the rectangle
-	int leftA, leftB;
-	int rightA, rightB;
-	int topA, topB;
-	int bottomA, bottomB;
-
-	//Calculate the sides of rect A
-	leftA = a.x;
-	rightA = a.x + a.w;
-	topA = a.y;
-	bottomA = a.y + a.h;
-
-	//If any of the sides from A are outside of B
-	if( bottomA <= topB )
-	{
-		return false;
-	}
-
-	if( topA >= bottomB )
-	{
-		return false;
-	}
+	//Success flag
+	bool tilesLoaded = true;
 
-	if( rightA <= leftB )
+	//Map the binary level if "make map" converted it, otherwise parse the text one
+	SDL_RWops* binaryMap = SDL_RWFromFile( "lazy.tmap", "rb" );
+	if( binaryMap != NULL )
 	{
-		return false;
+		SDL_RWclose( binaryMap );
+		tilesLoaded = tiles.loadFromFile( "lazy.tmap" );
 	}
-
-	if(leftA >= rightB )
+	else
 	{
-		return false;
+		tilesLoaded = tiles.loadFromText( "lazy.map", LEVEL_COLUMNS, LEVEL_ROWS, TILE_WIDTH, TILE_HEIGHT, TOTAL_TILE_SPRITES );
 	}
 
-	//If none of the sides from A are outside B
-	return true;
-}
-
-bool setTiles( Tile* tiles[] )
-{
-	//Success flag
-	bool tilesLoaded = true;
-
-	//The tile offsets
-	int x = 0, y = 0;
-
-	//Open the map
-	ifstream map( "lazy.map" );
-
 	//If the map couldn't be loaded
-	if( !map.is_open() )
+	if( !tilesLoaded )
 	{
 		cout << "Unable to load map file!\n" << endl;
-		tilesLoaded = false;
 	}
 	else
 	{
-		//Initialize the tiles
-		for( int i = 0; i < TOTAL_TILES; ++i )
+		//Every wall sprite blocks the dot
+		for( int type = TILE_CENTER; type <= TILE_TOPLEFT; ++type )
 		{
-			//Determines kind of tile will be made
-			int tileType = -1;
-
-			//Read tile from map file
-			map >> tileType;
-
-			//If the was a problem in reading the map
-			if( map.fail() )
-			{
-				//Stop loading map
-				cout << "Error loading map: Unexpected end of file!\n" << endl;
-				tilesLoaded = false;
-				break;
-			}
-			//If the number is valid tile number
-			if( ( tileType >= 0 ) && (tileType < TOTAL_TILE_SPRITES ) )
-			{
-				tiles[ i ] = new Tile( x, y, tileType );
-			}
-			//If we don't recognize the tile type
-			else
-			{
-				//Stop loading map
-				cout << "Error loading map: Invalid tile type at %d\n" << i << endl;
-				tilesLoaded = false;
-				break;
-			}
-
-			//Move to next tile spot
-			x += TILE_WIDTH;
-
-			//If we've gone too far
-			if( x >= LEVEL_WIDTH )
-			{
-				//Move back
-				x = 0;
-
-				//Move to the next row
-				y += TILE_HEIGHT;
-			}
+			tiles.setSolid( type, true );
 		}
 
 		//Clip the sprite sheet
@@ -721,36 +476,104 @@ bool setTiles( Tile* tiles[] )
 			gTileClips[ TILE_BOTTOMRIGHT ].h = TILE_HEIGHT;
 		}
 	}
-	//Close the file
-	map.close();
-
 	//If the map was loaded fine
 	return tilesLoaded;
 
 }
 
-bool touchesWall( SDL_Rect box, Tile* tiles[] )
+bool sweepWalls( SDL_Rect box, int velX, int velY, TileMap& tiles, SweepHit& hit )
 {
-	//Go through the tiles
-	for( int i = 0; i < TOTAL_TILES; ++i )
+	//Only the tiles under the path are swept
+	TileRange range = tiles.getRange( getSweepBounds( box, velX, velY ) );
+
+	//Keep the earliest contact
+	bool found = false;
+	for( int row = range.firstRow; row < range.endRow; ++row )
 	{
-		//If the tile is a wall Type tile
-		if( ( tiles[ i ]->getType() >= TILE_CENTER ) && ( tiles[ i ]->getType() <= TILE_TOPLEFT ) )
+		for( int column = range.firstColumn; column < range.endColumn; ++column )
 		{
-			//If the collision box touches the wall tile
-			if( checkCollision( box, tiles[ i ]->getBox() ) )
+			if( !tiles.isSolid( tiles.getTile( column, row ) ) )
 			{
-				return true;
+				continue;
+			}
+
+			SDL_Rect wall = { column * tiles.getTileWidth(), row * tiles.getTileHeight(), tiles.getTileWidth(), tiles.getTileHeight() };
+			SweepHit contact;
+			if( sweepBox( box, velX, velY, wall, contact ) && ( !found || contact.time < hit.time ) )
+			{
+				hit = contact;
+				found = true;
 			}
 		}
 	}
 
-	//If no wall tiles were touched
-	return false;
+	return found;
+}
+
+//Shows one visible tile, data is the camera
+static void renderTile( int x, int y, int type, void* data )
+{
+	//A binary map is not checked when it loads, so skip types we have no sprite for
+	if( type < TOTAL_TILE_SPRITES )
+	{
+		SDL_Rect* camera = (SDL_Rect*)data;
+		gTileTexture.render( x - camera->x, y - camera->y, &gTileClips[ type ] );
+	}
+}
+
+void bakeTile( int x, int y, int type, void* data )
+{
+	//Same skip as renderTile
+	if( type < TOTAL_TILE_SPRITES )
+	{
+		gTileTexture.render( x, y, &gTileClips[ type ] );
+	}
+}
+
+void renderTiles( TileMap& tiles, SDL_Rect& camera )
+{
+	//A few chunk textures, baked when first seen or edited
+	if( gCacheTiles )
+	{
+		gTileCache.render( tiles, camera );
+	}
+	//Only the tiles under the camera are visited
+	else
+	{
+		tiles.forEachVisible( camera, renderTile, &camera );
+	}
+}
+
+void editTile( TileMap& tiles, int x, int y )
+{
+	//The map's own tile size, a binary map need not use the sample's
+	int column = x / tiles.getTileWidth();
+	int row = y / tiles.getTileHeight();
+	if( x >= 0 && y >= 0 && column < tiles.getColumns() && row < tiles.getRows() )
+	{
+		//Only this tile's chunk gets baked again
+		tiles.setTile( column, row, ( tiles.getTile( column, row ) + 1 ) % TOTAL_TILE_SPRITES );
+	}
 }
 
-int main()
+int main( int argc, char* args[] )
 {
+	//Startup timer for the first presented frames
+	Uint64 startTime = SDL_GetPerformanceCounter();
+
+	//Pass sync to load every image before the first frame and tiles to draw tile by tile like before
+	for( int i = 1; i < argc; ++i )
+	{
+		if( string( args[ i ] ) == "sync" )
+		{
+			gAsyncLoading = false;
+		}
+		else if( string( args[ i ] ) == "tiles" )
+		{
+			gCacheTiles = false;
+		}
+	}
+
 	//Start up SDL and create window
 	if( !init() )
 	{
@@ -759,7 +582,7 @@ int main()
 	else
 	{
 		//The level tiles
-		Tile* tileSet[ TOTAL_TILES ];
+		TileMap tileSet;
 
 		//Load Media
 		if( !loadMedia( tileSet ) )
@@ -780,6 +603,15 @@ int main()
 			//Level camera
 			SDL_Rect camera = { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT };
 
+			//Startup progress
+			bool mediaReady = !gAsyncLoading;
+			bool firstFrame = true;
+			bool firstLevelFrame = true;
+
+			//Level frames drawn and the tile copies drawing them tile by tile takes
+			int levelFrames = 0;
+			long tileCopies = 0;
+
 			//While application is running
 			while( !quit )
 			{
@@ -791,30 +623,83 @@ int main()
 					{
 						quit = true;
 					}
+					//Chunk textures are gone with the render targets
+					else if( e.type == SDL_RENDER_TARGETS_RESET )
+					{
+						gTileCache.clear();
+					}
+					//Clicking a tile edits it
+					else if( e.type == SDL_MOUSEBUTTONDOWN && mediaReady )
+					{
+						editTile( tileSet, e.button.x + camera.x, e.button.y + camera.y );
+					}
 
 					//Handle input for dot
 					dot.handleEvent( e );
 				}
 
-				//Move the dot
-				dot.move( tileSet );
-				dot.setCamera( camera );
+				//Upload a bounded batch of decoded images
+				if( !mediaReady )
+				{
+					gAssets->upload( UPLOADS_PER_FRAME );
+					if( gAssets->isIdle() )
+					{
+						if( !finishLoading() )
+						{
+							quit = true;
+						}
+						mediaReady = true;
+					}
+				}
 
 				//Clear screen
 				SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
 				SDL_RenderClear( gRenderer );
 
-				//Render level
-				for( int i = 0; i < TOTAL_TILES; ++i )
+				if( mediaReady )
 				{
-					tileSet[ i ]->render( camera );
-				}
+					//Move the dot
+					dot.move( tileSet );
+					dot.setCamera( camera, tileSet );
+
+					//Render level
+					renderTiles( tileSet, camera );
+					TileRange range = tileSet.getRange( camera );
+					if( range.firstColumn < range.endColumn && range.firstRow < range.endRow )
+					{
+						tileCopies += (long)( range.endColumn - range.firstColumn ) * ( range.endRow - range.firstRow );
+					}
+					++levelFrames;
 
-				//Redner objects
-				dot.render( camera );
+					//Redner objects
+					dot.render( camera );
+				}
 
 				//Update screen
 				SDL_RenderPresent( gRenderer );
+
+				//Report startup times
+				double elapsed = (double)( SDL_GetPerformanceCounter() - startTime ) * 1000.0 / SDL_GetPerformanceFrequency();
+				if( firstFrame )
+				{
+					cout << ( gAsyncLoading ? "async" : "sync" ) << " first frame presented: " << elapsed << " ms" << endl;
+					firstFrame = false;
+				}
+				if( mediaReady && firstLevelFrame )
+				{
+					cout << ( gAsyncLoading ? "async" : "sync" ) << " first level frame presented: " << elapsed << " ms" << endl;
+					firstLevelFrame = false;
+				}
+			}
+
+			//Report what the chunk cache drew in place of single tiles
+			if( gCacheTiles )
+			{
+				cout << levelFrames << " level frames: " << gTileCache.getDrawCount() << " chunk copies and " << gTileCache.getBakeCount() << " chunk bakes in place of " << tileCopies << " tile copies" << endl;
+			}
+			else
+			{
+				cout << levelFrames << " level frames: " << tileCopies << " tile copies" << endl;
 			}
 		}
 
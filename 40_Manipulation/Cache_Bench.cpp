@@ -0,0 +1,188 @@
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <iostream>
+#include "../Engine/LTexture.h"
+#include "../Engine/PixelCache.h"
+#include "../Engine/BenchUtil.h"
+
+using namespace std;
+
+//A large sprite sheet written out for the run
+const char* SHEET_PATH = "cache_bench.png";
+const int SHEET_SIZE = 2048;
+
+//Cyan squares the loader keys out, one in every cell
+const int SHEET_CELL = 64;
+const int KEY_SIZE = 16;
+
+//Loads timed per mode
+const int BENCH_LOADS = 10;
+
+//Ways to load the sheet
+enum LoadMode
+{
+	LOAD_DECODE,
+	LOAD_COLD,
+	LOAD_WARM,
+	TOTAL_LOAD_MODES
+};
+
+//Mode display names
+const char* LOAD_MODE_NAMES[] = { "decode only", "cold start", "warm start" };
+
+//Software renderer drawing into a surface, so no window is needed
+SDL_Renderer* gRenderer = NULL;
+
+//Writes a 24 bit sheet with noisy sprites and keyed squares, so decoding costs about what real art does
+bool writeSheet()
+{
+	SDL_Surface* sheet = SDL_CreateRGBSurfaceWithFormat( 0, SHEET_SIZE, SHEET_SIZE, 24, SDL_PIXELFORMAT_RGB24 );
+	if( sheet == NULL )
+	{
+		cout << "Unable to create sheet! SDL Error: " << SDL_GetError() << endl;
+		return false;
+	}
+
+	Uint32 random = 1;
+	for( int y = 0; y < SHEET_SIZE; ++y )
+	{
+		Uint8* row = (Uint8*)sheet->pixels + y * sheet->pitch;
+		for( int x = 0; x < SHEET_SIZE; ++x )
+		{
+			random ^= random << 13;
+			random ^= random >> 17;
+			random ^= random << 5;
+			bool keyed = x % SHEET_CELL < KEY_SIZE && y % SHEET_CELL < KEY_SIZE;
+			row[ x * 3 ] = keyed ? 0 : (Uint8)( x + ( random & 0x0F ) );
+			row[ x * 3 + 1 ] = keyed ? 0xFF : (Uint8)( y + ( ( random >> 4 ) & 0x0F ) );
+			row[ x * 3 + 2 ] = keyed ? 0xFF : (Uint8)( x ^ y );
+		}
+	}
+
+	bool success = IMG_SavePNG( sheet, SHEET_PATH ) == 0;
+	if( !success )
+	{
+		cout << "Unable to save sheet! SDL_image Error: " << IMG_GetError() << endl;
+	}
+	SDL_FreeSurface( sheet );
+	return success;
+}
+
+//Loads the sheet and copies out its locked pixels row by row, pitch padding left behind
+bool readSheet( LTexture& texture, vector<Uint8>& pixels )
+{
+	if( !texture.loadFromFile( SHEET_PATH, SDL_TEXTUREACCESS_STREAMING ) || !texture.lockTexture() )
+	{
+		return false;
+	}
+
+	int rowBytes = texture.getWidth() * 4;
+	pixels.resize( rowBytes * texture.getHeight() );
+	for( int y = 0; y < texture.getHeight(); ++y )
+	{
+		memcpy( &pixels[ y * rowBytes ], (Uint8*)texture.getPixels() + y * texture.getPitch(), rowBytes );
+	}
+
+	texture.unlockTexture();
+	texture.free();
+	return true;
+}
+
+//Checks that cold and warm starts give the pixels a fresh decode does, returns false on any difference
+bool checkPixels( PixelCache& cache, LTexture& texture )
+{
+	vector<Uint8> decoded, cold, warm;
+
+	cache.setEnabled( false );
+	bool loaded = readSheet( texture, decoded );
+
+	cache.setEnabled( true );
+	cache.remove( SHEET_PATH );
+	loaded = loaded && readSheet( texture, cold ) && readSheet( texture, warm );
+	if( !loaded )
+	{
+		cout << "Unable to load sheet for the pixel check!" << endl;
+		return false;
+	}
+
+	bool coldMatches = cold.size() == decoded.size() && memcmp( &cold[ 0 ], &decoded[ 0 ], decoded.size() ) == 0;
+	bool warmMatches = warm.size() == decoded.size() && memcmp( &warm[ 0 ], &decoded[ 0 ], decoded.size() ) == 0;
+	cout << "cold start pixels match decode: " << ( coldMatches ? "yes" : "no" ) << endl;
+	cout << "warm start pixels match decode: " << ( warmMatches ? "yes" : "no" ) << endl;
+	return coldMatches && warmMatches;
+}
+
+int main( int argc, char* args[] )
+{
+	if( !( IMG_Init( IMG_INIT_PNG ) & IMG_INIT_PNG ) )
+	{
+		cout << "SDL_image could not initialize! SDL_image Error: " << IMG_GetError() << endl;
+		return 1;
+	}
+
+	SDL_Surface* screen = SDL_CreateRGBSurfaceWithFormat( 0, 1, 1, 32, SDL_PIXELFORMAT_RGBA8888 );
+	gRenderer = screen != NULL ? SDL_CreateSoftwareRenderer( screen ) : NULL;
+	if( gRenderer == NULL || !writeSheet() )
+	{
+		cout << "Unable to set up renderer and sheet! SDL Error: " << SDL_GetError() << endl;
+		return 1;
+	}
+
+	PixelCache& cache = PixelCache::getInstance();
+	cache.remove( SHEET_PATH );
+
+	cout << "mode\tms/load\thits\tmisses\tstale" << endl;
+
+	LTexture texture;
+	for( int m = 0; m < TOTAL_LOAD_MODES; ++m )
+	{
+		LoadMode mode = (LoadMode)m;
+		cache.setEnabled( mode != LOAD_DECODE );
+		int hits = cache.getHitCount();
+		int misses = cache.getMissCount();
+		int stale = cache.getStaleCount();
+
+		//Cold starts find no entry and write one, warm starts read the last one written
+		double seconds = 0;
+		for( int i = 0; i < BENCH_LOADS; ++i )
+		{
+			if( mode == LOAD_COLD )
+			{
+				cache.remove( SHEET_PATH );
+			}
+
+			Uint64 start = SDL_GetPerformanceCounter();
+			if( !texture.loadFromFile( SHEET_PATH, SDL_TEXTUREACCESS_STREAMING ) )
+			{
+				return 1;
+			}
+			seconds += getSeconds( start );
+			texture.free();
+		}
+
+		cout << LOAD_MODE_NAMES[ mode ] << "\t" << seconds * 1000.0 / BENCH_LOADS << "\t" << cache.getHitCount() - hits << "\t";
+		cout << cache.getMissCount() - misses << "\t" << cache.getStaleCount() - stale << endl;
+	}
+
+	//A fast warm start only counts if it gives back the same pixels
+	bool matches = checkPixels( cache, texture );
+
+	//Leave nothing behind
+	cache.remove( SHEET_PATH );
+	remove( SHEET_PATH );
+
+	SDL_DestroyRenderer( gRenderer );
+	SDL_FreeSurface( screen );
+	IMG_Quit();
+
+	if( !matches )
+	{
+		cout << "Cached pixels differ from a fresh decode!" << endl;
+		return 1;
+	}
+
+	return 0;
+}
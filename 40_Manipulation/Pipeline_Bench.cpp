@@ -0,0 +1,307 @@
+#include <SDL2/SDL.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+#include <iostream>
+#include "PixelPipeline.h"
+#include "../Engine/BenchUtil.h"
+
+using namespace std;
+
+//A large texture
+const int BENCH_WIDTH = 2048;
+const int BENCH_HEIGHT = 2048;
+
+//Applies timed per run
+const int BENCH_APPLIES = 5;
+
+//Worker counts for the fused runs
+const int BENCH_THREADS[] = { 1, 2, 4, 8 };
+const int TOTAL_BENCH_THREADS = 4;
+
+//Cyan color key and its transparent replacement in RGBA8888
+const Uint32 KEY_PIXEL = 0x00FFFFFF;
+const Uint32 TRANSPARENT_PIXEL = 0x00FFFF00;
+
+//A small retro palette
+const Uint32 PALETTE[] = { 0x000000FF, 0xFFFFFFFF, 0x880000FF, 0xAAFFEEFF, 0xCC44CCFF, 0x00CC55FF, 0x0000AAFF, 0xEEEE77FF,
+	0xDD8855FF, 0x664400FF, 0xFF7777FF, 0x333333FF, 0x777777FF, 0xAAFF66FF, 0x0088FFFF, 0xBBBBBBFF };
+const int PALETTE_SIZE = 16;
+
+//Small odd sized image the operations are checked on, every pixel near an edge for the wider blurs
+const int CHECK_WIDTH = 61;
+const int CHECK_HEIGHT = 37;
+
+//Blur radii checked, from one pixel to wider than the image
+const int CHECK_RADII[] = { 1, 2, 7, 40, 127 };
+const int TOTAL_CHECK_RADII = 5;
+
+//Blurs round the horizontal average before the vertical one with a fixed point reciprocal, the documented result is within one
+const int BLUR_TOLERANCE = 1;
+
+//Channel c of an RGBA8888 pixel, red first
+int getChannel( Uint32 p, int c )
+{
+	return ( p >> ( 24 - c * 8 ) ) & 0xFF;
+}
+
+//Luma with the BT.601 weights out of 256 the pipeline documents, rounded to nearest
+int referenceLuma( Uint32 p )
+{
+	return (int)floor( ( 77.0 * getChannel( p, 0 ) + 150.0 * getChannel( p, 1 ) + 29.0 * getChannel( p, 2 ) ) / 256.0 + 0.5 );
+}
+
+//Straightforward version of a single operation, one pixel at a time
+void runReference( int op, int radius, const vector<Uint32>& source, vector<Uint32>& result )
+{
+	result = source;
+	for( int y = 0; y < CHECK_HEIGHT; ++y )
+	{
+		for( int x = 0; x < CHECK_WIDTH; ++x )
+		{
+			Uint32 p = source[ y * CHECK_WIDTH + x ];
+			Uint32& out = result[ y * CHECK_WIDTH + x ];
+			if( op == 0 )
+			{
+				out = p == KEY_PIXEL ? TRANSPARENT_PIXEL : p;
+			}
+			else if( op == 1 )
+			{
+				//Channel times tint over 255, rounded to nearest
+				int tint[ 3 ] = { 0xFF, 0xC0, 0x80 };
+				out = p & 0xFF;
+				for( int c = 0; c < 3; ++c )
+				{
+					out |= (Uint32)( ( getChannel( p, c ) * tint[ c ] + 127 ) / 255 ) << ( 24 - c * 8 );
+				}
+			}
+			else if( op == 2 )
+			{
+				//Every channel averaged over the whole square, pixels past an edge repeat the edge
+				out = 0;
+				for( int c = 0; c < 4; ++c )
+				{
+					int sum = 0;
+					for( int dy = -radius; dy <= radius; ++dy )
+					{
+						for( int dx = -radius; dx <= radius; ++dx )
+						{
+							int sx = x + dx < 0 ? 0 : ( x + dx >= CHECK_WIDTH ? CHECK_WIDTH - 1 : x + dx );
+							int sy = y + dy < 0 ? 0 : ( y + dy >= CHECK_HEIGHT ? CHECK_HEIGHT - 1 : y + dy );
+							sum += getChannel( source[ sy * CHECK_WIDTH + sx ], c );
+						}
+					}
+					int span = radius * 2 + 1;
+					out |= (Uint32)floor( (double)sum / ( span * span ) + 0.5 ) << ( 24 - c * 8 );
+				}
+			}
+			else if( op == 3 )
+			{
+				Uint32 luma = referenceLuma( p );
+				out = ( luma << 24 ) | ( luma << 16 ) | ( luma << 8 ) | ( p & 0xFF );
+			}
+			else if( op == 4 )
+			{
+				out = ( referenceLuma( p ) >= 0x60 ? 0xFFFFFF00 : 0 ) | ( p & 0xFF );
+			}
+			else if( op == 5 )
+			{
+				//Search the palette from the middle of the pixel's 8 step cell, first of equally near colors wins
+				int best = 0;
+				int bestDistance = -1;
+				for( int i = 0; i < PALETTE_SIZE; ++i )
+				{
+					int distance = 0;
+					for( int c = 0; c < 3; ++c )
+					{
+						int delta = ( getChannel( p, c ) & 0xF8 ) + 4 - getChannel( PALETTE[ i ], c );
+						distance += delta * delta;
+					}
+					if( bestDistance < 0 || distance < bestDistance )
+					{
+						best = i;
+						bestDistance = distance;
+					}
+				}
+				out = ( PALETTE[ best ] & 0xFFFFFF00 ) | ( p & 0xFF );
+			}
+		}
+	}
+}
+
+//Largest channel difference between two images
+int getMaxError( const vector<Uint32>& a, const vector<Uint32>& b )
+{
+	int worst = 0;
+	for( int i = 0; i < (int)a.size(); ++i )
+	{
+		for( int c = 0; c < 4; ++c )
+		{
+			int error = abs( getChannel( a[ i ], c ) - getChannel( b[ i ], c ) );
+			worst = error > worst ? error : worst;
+		}
+	}
+	return worst;
+}
+
+//FNV-1a of the pixels
+Uint32 hashPixels( vector<Uint32>& pixels )
+{
+	const Uint8* bytes = (const Uint8*)&pixels[ 0 ];
+	Uint32 hash = 2166136261u;
+	for( size_t i = 0; i < pixels.size() * 4; ++i )
+	{
+		hash = ( hash ^ bytes[ i ] ) * 16777619u;
+	}
+	return hash;
+}
+
+//The effect chain, one operation at a time or all of them
+void addEffects( PixelPipeline& pipeline, int op )
+{
+	if( op < 0 || op == 0 ) pipeline.addColorKey( KEY_PIXEL, TRANSPARENT_PIXEL );
+	if( op < 0 || op == 1 ) pipeline.addTint( 0xFF, 0xC0, 0x80 );
+	if( op < 0 || op == 2 ) pipeline.addBlur( 2 );
+	if( op < 0 || op == 3 ) pipeline.addGrayscale();
+	if( op < 0 || op == 4 ) pipeline.addThreshold( 0x60 );
+	if( op < 0 || op == 5 ) pipeline.addPalette( PALETTE, PALETTE_SIZE );
+}
+const int TOTAL_EFFECTS = 6;
+
+//Effect display names, in addEffects order
+const char* EFFECT_NAMES[] = { "color key", "tint", "blur", "grayscale", "threshold", "palette" };
+
+//Checks each operation on its own against its reference loop, blurs at every checked radius, returns how many disagree
+int checkEffects()
+{
+	//Random pixels with a quarter of them cyan, a few black and white so the palette and threshold see extremes
+	vector<Uint32> source( CHECK_WIDTH * CHECK_HEIGHT );
+	Uint32 random = 7;
+	for( int i = 0; i < (int)source.size(); ++i )
+	{
+		Uint32 value = nextRandom( random );
+		source[ i ] = value % 4 == 0 ? KEY_PIXEL : ( value % 17 == 0 ? 0x000000FF : ( value % 19 == 0 ? 0xFFFFFFFF : value ) );
+	}
+
+	cout << "effect	radius	max error	matches reference" << endl;
+	int failures = 0;
+	for( int op = 0; op < TOTAL_EFFECTS; ++op )
+	{
+		int radii = op == 2 ? TOTAL_CHECK_RADII : 1;
+		for( int r = 0; r < radii; ++r )
+		{
+			int radius = op == 2 ? CHECK_RADII[ r ] : 0;
+			PixelPipeline pipeline( 1 );
+			if( op == 2 )
+			{
+				pipeline.addBlur( radius );
+			}
+			else
+			{
+				addEffects( pipeline, op );
+			}
+			vector<Uint32> pixels = source;
+			pipeline.apply( &pixels[ 0 ], CHECK_WIDTH * 4, CHECK_WIDTH, CHECK_HEIGHT );
+
+			vector<Uint32> expected;
+			runReference( op, radius, source, expected );
+			int error = getMaxError( pixels, expected );
+			bool matches = error <= ( op == 2 ? BLUR_TOLERANCE : 0 );
+			cout << EFFECT_NAMES[ op ] << "\t" << radius << "\t" << error << "\t" << ( matches ? "yes" : "no" ) << endl;
+			if( !matches )
+			{
+				++failures;
+			}
+		}
+	}
+	cout << endl;
+	return failures;
+}
+
+//Prints one result row, returns whether the output matches the separate passes
+bool report( const char* mode, int threads, int passes, double seconds, double reference, Uint32 hash, Uint32 referenceHash )
+{
+	double bytes = (double)BENCH_WIDTH * BENCH_HEIGHT * 4 * BENCH_APPLIES;
+	cout << mode << "\t" << threads << "\t" << passes << "\t" << seconds * 1000.0 / BENCH_APPLIES << "\t" << bytes / seconds / 1e9 << "\t";
+	cout << reference / seconds << "\t" << ( hash == referenceHash ? "yes" : "no" ) << endl;
+	return hash == referenceHash;
+}
+
+int main( int argc, char* args[] )
+{
+	//Make sure every operation does what it says before timing any of them
+	if( checkEffects() > 0 )
+	{
+		cout << "Pipeline operations disagree with their reference loops!" << endl;
+		return 1;
+	}
+
+	//Random pixels with a quarter of them cyan
+	vector<Uint32> source( BENCH_WIDTH * BENCH_HEIGHT );
+	Uint32 random = 1;
+	for( int i = 0; i < (int)source.size(); ++i )
+	{
+		Uint32 value = nextRandom( random );
+		source[ i ] = value % 4 == 0 ? KEY_PIXEL : value;
+	}
+	vector<Uint32> pixels;
+
+	cout << "mode\tthreads\tpasses\tms/apply\tGB/s\tspeedup\tmatches separate" << endl;
+
+	//Every operation in its own pipeline, a pass over the whole texture each, the way hand written loops run
+	vector<PixelPipeline*> separate;
+	int separatePasses = 0;
+	for( int op = 0; op < TOTAL_EFFECTS; ++op )
+	{
+		separate.push_back( new PixelPipeline( 1 ) );
+		addEffects( *separate.back(), op );
+		separatePasses += separate.back()->getPassCount();
+	}
+	double separateSeconds = 0;
+	for( int i = 0; i < BENCH_APPLIES; ++i )
+	{
+		pixels = source;
+		Uint64 start = SDL_GetPerformanceCounter();
+		for( int op = 0; op < TOTAL_EFFECTS; ++op )
+		{
+			separate[ op ]->apply( &pixels[ 0 ], BENCH_WIDTH * 4, BENCH_WIDTH, BENCH_HEIGHT );
+		}
+		separateSeconds += getSeconds( start );
+	}
+	Uint32 reference = hashPixels( pixels );
+	report( "separate", 1, separatePasses, separateSeconds, separateSeconds, reference, reference );
+	for( int op = 0; op < TOTAL_EFFECTS; ++op )
+	{
+		delete separate[ op ];
+	}
+
+	//The whole chain fused, on more and more threads
+	int mismatches = 0;
+	for( int t = 0; t < TOTAL_BENCH_THREADS; ++t )
+	{
+		PixelPipeline fused( BENCH_THREADS[ t ] );
+		addEffects( fused, -1 );
+		double seconds = 0;
+		for( int i = 0; i < BENCH_APPLIES; ++i )
+		{
+			pixels = source;
+			Uint64 start = SDL_GetPerformanceCounter();
+			fused.apply( &pixels[ 0 ], BENCH_WIDTH * 4, BENCH_WIDTH, BENCH_HEIGHT );
+			seconds += getSeconds( start );
+		}
+		if( !report( "fused", BENCH_THREADS[ t ], fused.getPassCount(), seconds, separateSeconds, hashPixels( pixels ), reference ) )
+		{
+			++mismatches;
+		}
+	}
+
+	cout << "cores: " << SDL_GetCPUCount() << endl;
+
+	if( mismatches > 0 )
+	{
+		cout << "Fused pipeline output differs from the separate passes!" << endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,477 @@
+#include "PixelPipeline.h"
+#include <string.h>
+
+using namespace std;
+
+//Rows a worker claims at a time
+const int PIPELINE_BAND_ROWS = 32;
+
+//Widest blur, past a 255 pixel window the rounded reciprocal can push a full white average to 256
+const int MAX_BLUR_RADIUS = 127;
+
+//Luma of an RGBA8888 pixel, BT.601 weights out of 256
+static inline Uint32 getLuma( Uint32 p )
+{
+	return ( 77 * ( p >> 24 ) + 150 * ( ( p >> 16 ) & 0xFF ) + 29 * ( ( p >> 8 ) & 0xFF ) + 128 ) >> 8;
+}
+
+//Scales a channel by a factor out of 255, exact rounding
+static inline Uint32 scaleChannel( Uint32 c, Uint32 factor )
+{
+	Uint32 t = c * factor + 128;
+	return ( t + ( t >> 8 ) ) >> 8;
+}
+
+//Clamps a row or column to the image
+static inline int clampIndex( int i, int size )
+{
+	return i < 0 ? 0 : ( i >= size ? size - 1 : i );
+}
+
+//Fixed point reciprocal of a blur window, averages come out within one of exact rounding without a divide, for windows up to 255 pixels
+static inline Uint32 getBlurScale( int radius )
+{
+	Uint32 span = radius * 2 + 1;
+	return ( 65536 + span / 2 ) / span;
+}
+
+//Averages each channel of a row over radius pixels either side, edges repeat
+static void blurRow( const Uint8* source, Uint8* destination, int width, int radius )
+{
+	Uint32 scale = getBlurScale( radius );
+
+	//Window around the first pixel
+	Uint32 sums[ 4 ] = { 0, 0, 0, 0 };
+	for( int x = -radius; x <= radius; ++x )
+	{
+		const Uint8* p = source + clampIndex( x, width ) * 4;
+		for( int c = 0; c < 4; ++c )
+		{
+			sums[ c ] += p[ c ];
+		}
+	}
+
+	//Slide it along, clamping only where the window hangs over an edge
+	for( int x = 0; x < width; ++x )
+	{
+		const Uint8* entering = source + ( x + radius + 1 < width ? x + radius + 1 : width - 1 ) * 4;
+		const Uint8* leaving = source + ( x - radius > 0 ? x - radius : 0 ) * 4;
+		for( int c = 0; c < 4; ++c )
+		{
+			destination[ x * 4 + c ] = (Uint8)( ( sums[ c ] * scale + 32768 ) >> 16 );
+			sums[ c ] += entering[ c ] - leaving[ c ];
+		}
+	}
+}
+
+PixelPipeline::PixelPipeline( int threads )
+{
+	//Initialize
+	mKernel = getBestPixelKernel();
+	mPixels = NULL;
+	mPitch = 0;
+	mWidth = 0;
+	mHeight = 0;
+	mPass = 0;
+	mBandCount = 0;
+	mNextBand = 0;
+	mBandsDone = 0;
+	mGeneration = 0;
+	mQuit = false;
+	mLock = SDL_CreateMutex();
+	mWork = SDL_CreateCond();
+	mDone = SDL_CreateCond();
+
+	//Start workers, the caller is the last thread
+	for( int i = 1; i < threads; ++i )
+	{
+		mThreads.push_back( SDL_CreateThread( workerMain, "PixelWorker", this ) );
+	}
+}
+
+PixelPipeline::~PixelPipeline()
+{
+	//Wake workers so they see the quit flag
+	SDL_LockMutex( mLock );
+	mQuit = true;
+	SDL_CondBroadcast( mWork );
+	SDL_UnlockMutex( mLock );
+
+	//Wait for workers to finish
+	for( int i = 0; i < (int)mThreads.size(); ++i )
+	{
+		SDL_WaitThread( mThreads[ i ], NULL );
+	}
+	mThreads.clear();
+
+	SDL_DestroyCond( mDone );
+	SDL_DestroyCond( mWork );
+	SDL_DestroyMutex( mLock );
+}
+
+void PixelPipeline::addColorKey( Uint32 key, Uint32 replacement )
+{
+	PixelOp op;
+	op.type = OP_COLOR_KEY;
+	op.key = key;
+	op.replacement = replacement;
+	mOps.push_back( op );
+}
+
+void PixelPipeline::addTint( Uint8 red, Uint8 green, Uint8 blue )
+{
+	PixelOp op;
+	op.type = OP_TINT;
+
+	//Scaled values of every channel value, red then green then blue, already shifted into place
+	Uint8 tint[ 3 ] = { red, green, blue };
+	op.table.resize( 3 * 256 );
+	for( int c = 0; c < 3; ++c )
+	{
+		for( int i = 0; i < 256; ++i )
+		{
+			op.table[ c * 256 + i ] = scaleChannel( i, tint[ c ] ) << ( 24 - c * 8 );
+		}
+	}
+	mOps.push_back( op );
+}
+
+void PixelPipeline::addGrayscale()
+{
+	PixelOp op;
+	op.type = OP_GRAYSCALE;
+	mOps.push_back( op );
+}
+
+void PixelPipeline::addThreshold( Uint8 level )
+{
+	PixelOp op;
+	op.type = OP_THRESHOLD;
+	op.level = level;
+	mOps.push_back( op );
+}
+
+void PixelPipeline::addBlur( int radius )
+{
+	//Nothing to average
+	if( radius < 1 )
+	{
+		return;
+	}
+	if( radius > MAX_BLUR_RADIUS )
+	{
+		radius = MAX_BLUR_RADIUS;
+	}
+
+	PixelOp op;
+	op.type = OP_BLUR;
+	op.radius = radius;
+	mOps.push_back( op );
+}
+
+void PixelPipeline::addPalette( const Uint32* colors, int count )
+{
+	if( count < 1 )
+	{
+		return;
+	}
+
+	PixelOp op;
+	op.type = OP_PALETTE;
+
+	//Nearest palette color to the middle of each 15 bit color, looked up per pixel instead of searched
+	op.table.resize( 1 << 15 );
+	for( int i = 0; i < ( 1 << 15 ); ++i )
+	{
+		int red = ( ( i >> 10 ) << 3 ) + 4;
+		int green = ( ( ( i >> 5 ) & 0x1F ) << 3 ) + 4;
+		int blue = ( ( i & 0x1F ) << 3 ) + 4;
+		int best = 0;
+		int bestDistance = 0;
+		for( int c = 0; c < count; ++c )
+		{
+			int deltaRed = red - (int)( colors[ c ] >> 24 );
+			int deltaGreen = green - (int)( ( colors[ c ] >> 16 ) & 0xFF );
+			int deltaBlue = blue - (int)( ( colors[ c ] >> 8 ) & 0xFF );
+			int distance = deltaRed * deltaRed + deltaGreen * deltaGreen + deltaBlue * deltaBlue;
+			if( c == 0 || distance < bestDistance )
+			{
+				best = c;
+				bestDistance = distance;
+			}
+		}
+
+		//Palette alpha is dropped, pixels keep their own
+		op.table[ i ] = colors[ best ] & 0xFFFFFF00;
+	}
+	mOps.push_back( op );
+}
+
+void PixelPipeline::clear()
+{
+	mOps.clear();
+	mPasses.clear();
+}
+
+int PixelPipeline::getOpCount()
+{
+	return mOps.size();
+}
+
+int PixelPipeline::getPassCount()
+{
+	buildPasses();
+	return mPasses.size();
+}
+
+void PixelPipeline::buildPasses()
+{
+	mPasses.clear();
+
+	PixelPass pass = { -1, 0, 0, -1 };
+	int blurs = 0;
+	for( int i = 0; i < (int)mOps.size(); ++i )
+	{
+		if( mOps[ i ].type != OP_BLUR )
+		{
+			pass.endOp = i + 1;
+			continue;
+		}
+
+		//A blur ends the pass with its horizontal half and starts the next with its vertical half
+		mOps[ i ].scratch = blurs++ % 2;
+		pass.blurOut = i;
+		mPasses.push_back( pass );
+		pass.blurIn = i;
+		pass.firstOp = i + 1;
+		pass.endOp = i + 1;
+		pass.blurOut = -1;
+	}
+
+	//Last pass, unless it has nothing to do
+	if( pass.blurIn != -1 || pass.endOp > pass.firstOp )
+	{
+		mPasses.push_back( pass );
+	}
+}
+
+bool PixelPipeline::apply( void* pixels, int pitch, int width, int height )
+{
+	if( pixels == NULL || width < 1 || height < 1 || pitch < width * 4 )
+	{
+		return false;
+	}
+
+	buildPasses();
+
+	//Scratch buffers for however many blurs take turns with them
+	for( int i = 0; i < (int)mOps.size(); ++i )
+	{
+		if( mOps[ i ].type == OP_BLUR )
+		{
+			mScratch[ mOps[ i ].scratch ].resize( width * height );
+		}
+	}
+
+	mPixels = (Uint8*)pixels;
+	mPitch = pitch;
+	mWidth = width;
+	mHeight = height;
+	int bands = ( height + PIPELINE_BAND_ROWS - 1 ) / PIPELINE_BAND_ROWS;
+
+	for( int p = 0; p < (int)mPasses.size(); ++p )
+	{
+		//On our own, no need to hand out bands
+		if( mThreads.empty() )
+		{
+			for( int band = 0; band < bands; ++band )
+			{
+				runBand( mPasses[ p ], band, mSums );
+			}
+			continue;
+		}
+
+		//Wake the workers for the new pass
+		SDL_LockMutex( mLock );
+		mPass = p;
+		mBandCount = bands;
+		mNextBand = 0;
+		mBandsDone = 0;
+		++mGeneration;
+		SDL_CondBroadcast( mWork );
+		SDL_UnlockMutex( mLock );
+
+		//Help out, then wait for every band so the next pass can read across them
+		runBands( mSums );
+		SDL_LockMutex( mLock );
+		while( mBandsDone < mBandCount )
+		{
+			SDL_CondWait( mDone, mLock );
+		}
+		SDL_UnlockMutex( mLock );
+	}
+
+	mPixels = NULL;
+	return true;
+}
+
+int PixelPipeline::workerMain( void* data )
+{
+	PixelPipeline* pipeline = (PixelPipeline*)data;
+
+	//Column sums kept for the life of the worker so bands don't allocate
+	vector< Uint32 > sums;
+
+	SDL_LockMutex( pipeline->mLock );
+	int seen = pipeline->mGeneration;
+	while( true )
+	{
+		//Sleep until there is a new pass or we are told to quit
+		while( pipeline->mGeneration == seen && !pipeline->mQuit )
+		{
+			SDL_CondWait( pipeline->mWork, pipeline->mLock );
+		}
+		if( pipeline->mQuit )
+		{
+			break;
+		}
+		seen = pipeline->mGeneration;
+
+		//Work without holding the lock
+		SDL_UnlockMutex( pipeline->mLock );
+		pipeline->runBands( sums );
+		SDL_LockMutex( pipeline->mLock );
+	}
+	SDL_UnlockMutex( pipeline->mLock );
+
+	return 0;
+}
+
+void PixelPipeline::runBands( vector< Uint32 >& sums )
+{
+	while( true )
+	{
+		//Claim the next band
+		SDL_LockMutex( mLock );
+		if( mNextBand >= mBandCount )
+		{
+			SDL_UnlockMutex( mLock );
+			return;
+		}
+		int band = mNextBand++;
+		PixelPass pass = mPasses[ mPass ];
+		SDL_UnlockMutex( mLock );
+
+		runBand( pass, band, sums );
+
+		//Last band done lets apply move on
+		SDL_LockMutex( mLock );
+		if( ++mBandsDone == mBandCount )
+		{
+			SDL_CondSignal( mDone );
+		}
+		SDL_UnlockMutex( mLock );
+	}
+}
+
+void PixelPipeline::runBand( const PixelPass& pass, int band, vector< Uint32 >& sums )
+{
+	int top = band * PIPELINE_BAND_ROWS;
+	int bottom = top + PIPELINE_BAND_ROWS < mHeight ? top + PIPELINE_BAND_ROWS : mHeight;
+	int rowBytes = mWidth * 4;
+
+	//Column sums for the vertical half of the blur coming in, started at the band's top row
+	const Uint8* blurred = NULL;
+	int radius = 0;
+	if( pass.blurIn != -1 )
+	{
+		radius = mOps[ pass.blurIn ].radius;
+		blurred = (const Uint8*)&mScratch[ mOps[ pass.blurIn ].scratch ][ 0 ];
+		sums.assign( rowBytes, 0 );
+		for( int y = top - radius; y <= top + radius; ++y )
+		{
+			const Uint8* source = blurred + clampIndex( y, mHeight ) * rowBytes;
+			for( int i = 0; i < rowBytes; ++i )
+			{
+				sums[ i ] += source[ i ];
+			}
+		}
+	}
+
+	for( int y = top; y < bottom; ++y )
+	{
+		Uint8* row = mPixels + y * mPitch;
+
+		//Finish the blur coming in, then slide its window down a row
+		if( blurred != NULL )
+		{
+			Uint32 scale = getBlurScale( radius );
+			const Uint8* entering = blurred + clampIndex( y + radius + 1, mHeight ) * rowBytes;
+			const Uint8* leaving = blurred + clampIndex( y - radius, mHeight ) * rowBytes;
+			for( int i = 0; i < rowBytes; ++i )
+			{
+				row[ i ] = (Uint8)( ( sums[ i ] * scale + 32768 ) >> 16 );
+				sums[ i ] += entering[ i ] - leaving[ i ];
+			}
+		}
+
+		runPointOps( pass, (Uint32*)row );
+
+		//Start the blur going out
+		if( pass.blurOut != -1 )
+		{
+			const PixelOp& blur = mOps[ pass.blurOut ];
+			blurRow( row, (Uint8*)&mScratch[ blur.scratch ][ y * mWidth ], mWidth, blur.radius );
+		}
+	}
+}
+
+void PixelPipeline::runPointOps( const PixelPass& pass, Uint32* row )
+{
+	//Each operation sweeps the whole row, which stays in cache between them
+	for( int o = pass.firstOp; o < pass.endOp; ++o )
+	{
+		const PixelOp& op = mOps[ o ];
+		switch( op.type )
+		{
+			case OP_COLOR_KEY:
+				colorKeyPixels( mKernel, row, mWidth, op.key, op.replacement );
+				break;
+
+			case OP_TINT:
+				for( int x = 0; x < mWidth; ++x )
+				{
+					Uint32 p = row[ x ];
+					row[ x ] = op.table[ p >> 24 ] | op.table[ 256 + ( ( p >> 16 ) & 0xFF ) ] | op.table[ 512 + ( ( p >> 8 ) & 0xFF ) ] | ( p & 0xFF );
+				}
+				break;
+
+			case OP_GRAYSCALE:
+				for( int x = 0; x < mWidth; ++x )
+				{
+					Uint32 luma = getLuma( row[ x ] );
+					row[ x ] = ( luma << 24 ) | ( luma << 16 ) | ( luma << 8 ) | ( row[ x ] & 0xFF );
+				}
+				break;
+
+			case OP_THRESHOLD:
+				for( int x = 0; x < mWidth; ++x )
+				{
+					row[ x ] = ( getLuma( row[ x ] ) >= op.level ? 0xFFFFFF00 : 0 ) | ( row[ x ] & 0xFF );
+				}
+				break;
+
+			case OP_PALETTE:
+				for( int x = 0; x < mWidth; ++x )
+				{
+					Uint32 p = row[ x ];
+					int index = ( ( p >> 17 ) & 0x7C00 ) | ( ( p >> 14 ) & 0x3E0 ) | ( ( p >> 11 ) & 0x1F );
+					row[ x ] = op.table[ index ] | ( p & 0xFF );
+				}
+				break;
+
+			default:
+				break;
+		}
+	}
+}
@@ -0,0 +1,149 @@
+#ifndef PIXEL_PIPELINE_H
+#define PIXEL_PIPELINE_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+#include "../Engine/PixelKernels.h"
+
+//A chain of pixel operations run over RGBA8888 pixels, such as a locked texture's.
+//Point operations are fused so each row goes through all of them while it is in cache, a blur needs its
+//neighbours finished first so it splits the chain into one more pass. Rows are shared out between worker threads
+class PixelPipeline
+{
+	public:
+		//Starts threads - 1 workers, the calling thread does its share of every pass
+		PixelPipeline( int threads = 1 );
+
+		//Stops workers
+		~PixelPipeline();
+
+		//Replaces pixels equal to key with replacement
+		void addColorKey( Uint32 key, Uint32 replacement );
+
+		//Multiplies color by the tint, as color modulation does
+		void addTint( Uint8 red, Uint8 green, Uint8 blue );
+
+		//Replaces color with its luma
+		void addGrayscale();
+
+		//Turns pixels white when their luma is at least level, black otherwise
+		void addThreshold( Uint8 level );
+
+		//Averages every channel over a square 2 * radius + 1 pixels wide, clamped at the edges, radius is capped at 127
+		void addBlur( int radius );
+
+		//Replaces color with the nearest palette color, in steps of 8 per channel
+		void addPalette( const Uint32* colors, int count );
+
+		//Removes every operation
+		void clear();
+
+		//Operations added
+		int getOpCount();
+
+		//Passes apply makes over the pixels, one plus one per blur
+		int getPassCount();
+
+		//Runs every operation over width by height pixels with pitch bytes per row
+		bool apply( void* pixels, int pitch, int width, int height );
+
+	private:
+		//Kinds of operation
+		enum PixelOpType
+		{
+			OP_COLOR_KEY,
+			OP_TINT,
+			OP_GRAYSCALE,
+			OP_THRESHOLD,
+			OP_BLUR,
+			OP_PALETTE
+		};
+
+		//One operation and its settings
+		struct PixelOp
+		{
+			PixelOpType type;
+			Uint32 key;
+			Uint32 replacement;
+			Uint32 level;
+			int radius;
+
+			//Scratch buffer a blur goes through
+			int scratch;
+
+			//Tint lookup per channel, or nearest palette color for each 15 bit color
+			std::vector< Uint32 > table;
+		};
+
+		//One trip over the pixels, finishing one blur and starting the next
+		struct PixelPass
+		{
+			//Blur whose vertical half writes the rows, -1 if none
+			int blurIn;
+
+			//Point operations run on each row
+			int firstOp;
+			int endOp;
+
+			//Blur whose horizontal half reads the rows, -1 if none
+			int blurOut;
+		};
+
+		//Pipeline is not copyable
+		PixelPipeline( const PixelPipeline& );
+		PixelPipeline& operator=( const PixelPipeline& );
+
+		//Worker thread entry point
+		static int workerMain( void* data );
+
+		//Splits the operations into passes
+		void buildPasses();
+
+		//Claims and runs bands of the current pass until none are left, with the calling thread's blur sums
+		void runBands( std::vector< Uint32 >& sums );
+
+		//Runs one pass over a band of rows, sums holds the blur's column sums
+		void runBand( const PixelPass& pass, int band, std::vector< Uint32 >& sums );
+
+		//Runs point operations on one row
+		void runPointOps( const PixelPass& pass, Uint32* row );
+
+		//Operations in order and the passes they make
+		std::vector< PixelOp > mOps;
+		std::vector< PixelPass > mPasses;
+
+		//Kernel the color key runs on
+		PixelKernel mKernel;
+
+		//Blurred rows waiting for their vertical half, blurs take turns so one can be read while the next is written
+		std::vector< Uint32 > mScratch[ 2 ];
+
+		//Blur column sums for the thread calling apply, workers keep their own
+		std::vector< Uint32 > mSums;
+
+		//Pixels being worked on
+		Uint8* mPixels;
+		int mPitch;
+		int mWidth;
+		int mHeight;
+
+		//Pass being run and its bands
+		int mPass;
+		int mBandCount;
+		int mNextBand;
+		int mBandsDone;
+
+		//Bumped for every pass so workers know there is new work
+		int mGeneration;
+
+		//Guards the pass state above against the workers
+		SDL_mutex* mLock;
+		SDL_cond* mWork;
+		SDL_cond* mDone;
+		bool mQuit;
+
+		//Worker threads
+		std::vector< SDL_Thread* > mThreads;
+};
+
+#endif
@@ -0,0 +1,172 @@
+#include <SDL2/SDL.h>
+#include <vector>
+#include <iostream>
+#include "../Engine/PixelKernels.h"
+#include "../Engine/BenchUtil.h"
+
+using namespace std;
+
+//A large sprite sheet, with a few pixels over so every kernel runs its leftover loop
+const int BENCH_PIXELS = 2048 * 2048 + 5;
+
+//Passes timed per kernel
+const int BENCH_PASSES = 20;
+
+//Cyan color key and its transparent replacement, as the loader maps them in RGBA8888
+const Uint32 KEY_PIXEL = 0x00FFFFFF;
+const Uint32 TRANSPARENT_PIXEL = 0x00FFFF00;
+
+//Operations to time
+enum PixelOp
+{
+	OP_COLOR_KEY,
+	OP_PREMULTIPLY,
+	OP_REVERSE,
+	OP_EXPAND_RGB,
+	OP_EXPAND_BGR,
+	OP_PACK_RGB,
+	OP_PACK_BGR,
+	TOTAL_PIXEL_OPS
+};
+
+//Op display names
+const char* PIXEL_OP_NAMES[] = { "color key", "premultiply", "abgr to rgba", "rgb24 to rgba", "bgr24 to rgba", "rgba to rgb24", "rgba to bgr24" };
+
+//Buffers every op reads from and writes to
+struct PixelBuffers
+{
+	vector<Uint32> rgba;
+	vector<Uint8> rgb;
+	vector<Uint32> outRGBA;
+	vector<Uint8> outRGB;
+};
+
+//FNV-1a of a byte range
+Uint32 hashBytes( const void* data, size_t size )
+{
+	const Uint8* bytes = (const Uint8*)data;
+	Uint32 hash = 2166136261u;
+	for( size_t i = 0; i < size; ++i )
+	{
+		hash = ( hash ^ bytes[ i ] ) * 16777619u;
+	}
+	return hash;
+}
+
+//Runs one pass of an op, color key swaps key and replacement on odd passes so every pass has the same work
+void runOp( PixelOp op, PixelKernel kernel, PixelBuffers& buffers, int pass )
+{
+	switch( op )
+	{
+		case OP_COLOR_KEY:
+			colorKeyPixels( kernel, &buffers.outRGBA[ 0 ], BENCH_PIXELS, pass % 2 == 0 ? KEY_PIXEL : TRANSPARENT_PIXEL, pass % 2 == 0 ? TRANSPARENT_PIXEL : KEY_PIXEL );
+			break;
+		case OP_PREMULTIPLY: premultiplyAlpha( kernel, &buffers.outRGBA[ 0 ], BENCH_PIXELS ); break;
+		case OP_REVERSE: reversePixelBytes( kernel, &buffers.rgba[ 0 ], &buffers.outRGBA[ 0 ], BENCH_PIXELS ); break;
+		case OP_EXPAND_RGB: expandRGB24( kernel, &buffers.rgb[ 0 ], &buffers.outRGBA[ 0 ], BENCH_PIXELS, false ); break;
+		case OP_EXPAND_BGR: expandRGB24( kernel, &buffers.rgb[ 0 ], &buffers.outRGBA[ 0 ], BENCH_PIXELS, true ); break;
+		case OP_PACK_RGB: packRGB24( kernel, &buffers.rgba[ 0 ], &buffers.outRGB[ 0 ], BENCH_PIXELS, false ); break;
+		case OP_PACK_BGR: packRGB24( kernel, &buffers.rgba[ 0 ], &buffers.outRGB[ 0 ], BENCH_PIXELS, true ); break;
+		default: break;
+	}
+}
+
+//Bytes an op reads and writes per pixel
+int getOpBytes( PixelOp op )
+{
+	switch( op )
+	{
+		case OP_EXPAND_RGB:
+		case OP_EXPAND_BGR:
+		case OP_PACK_RGB:
+		case OP_PACK_BGR: return 3 + 4;
+		default: return 4 + 4;
+	}
+}
+
+//Hash of what an op wrote
+Uint32 hashOutput( PixelOp op, PixelBuffers& buffers )
+{
+	if( op == OP_PACK_RGB || op == OP_PACK_BGR )
+	{
+		return hashBytes( &buffers.outRGB[ 0 ], buffers.outRGB.size() );
+	}
+	return hashBytes( &buffers.outRGBA[ 0 ], buffers.outRGBA.size() * 4 );
+}
+
+int main( int argc, char* args[] )
+{
+	//Random pixels with a quarter of them cyan, the same bytes again as 24 bit
+	PixelBuffers buffers;
+	buffers.rgba.resize( BENCH_PIXELS );
+	buffers.rgb.resize( BENCH_PIXELS * 3 );
+	buffers.outRGBA.resize( BENCH_PIXELS );
+	buffers.outRGB.resize( BENCH_PIXELS * 3 );
+	Uint32 random = 1;
+	for( int i = 0; i < BENCH_PIXELS; ++i )
+	{
+		Uint32 value = nextRandom( random );
+		buffers.rgba[ i ] = value % 4 == 0 ? KEY_PIXEL : value;
+		buffers.rgb[ i * 3 ] = (Uint8)( buffers.rgba[ i ] >> 24 );
+		buffers.rgb[ i * 3 + 1 ] = (Uint8)( buffers.rgba[ i ] >> 16 );
+		buffers.rgb[ i * 3 + 2 ] = (Uint8)( buffers.rgba[ i ] >> 8 );
+	}
+
+	cout << "op\tkernel\tGB/s\tspeedup\tmatches scalar" << endl;
+
+	//Rows whose output differs from the scalar kernel's
+	int mismatches = 0;
+
+	for( int o = 0; o < TOTAL_PIXEL_OPS; ++o )
+	{
+		PixelOp op = (PixelOp)o;
+		Uint32 reference = 0;
+		double scalarSeconds = 0;
+
+		for( int k = 0; k < TOTAL_PIXEL_KERNELS; ++k )
+		{
+			PixelKernel kernel = (PixelKernel)k;
+			if( !isPixelKernelSupported( kernel ) )
+			{
+				cout << PIXEL_OP_NAMES[ op ] << "\t" << getPixelKernelName( kernel ) << "\tunsupported" << endl;
+				continue;
+			}
+
+			//One checked pass from the same input
+			buffers.outRGBA = buffers.rgba;
+			runOp( op, kernel, buffers, 0 );
+			Uint32 hash = hashOutput( op, buffers );
+			if( kernel == PIXEL_SCALAR )
+			{
+				reference = hash;
+			}
+
+			//Timed passes, in place ops keep working on their own output
+			Uint64 start = SDL_GetPerformanceCounter();
+			for( int pass = 0; pass < BENCH_PASSES; ++pass )
+			{
+				runOp( op, kernel, buffers, pass + 1 );
+			}
+			double seconds = getSeconds( start );
+			if( kernel == PIXEL_SCALAR )
+			{
+				scalarSeconds = seconds;
+			}
+
+			double bytes = (double)BENCH_PIXELS * getOpBytes( op ) * BENCH_PASSES;
+			cout << PIXEL_OP_NAMES[ op ] << "\t" << getPixelKernelName( kernel ) << "\t" << bytes / seconds / 1e9 << "\t" << scalarSeconds / seconds << "\t" << ( hash == reference ? "yes" : "no" ) << endl;
+			if( hash != reference )
+			{
+				++mismatches;
+			}
+		}
+	}
+
+	if( mismatches > 0 )
+	{
+		cout << "Pixel kernels disagree with the scalar one!" << endl;
+		return 1;
+	}
+
+	return 0;
+}
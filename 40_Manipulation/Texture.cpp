@@ -2,7 +2,11 @@
 #include <SDL2/SDL_image.h>
 #include <stdio.h>
 #include <string>
+#include <string.h>
 #include <iostream>
+#include <vector>
+#include "../Engine/LTexture.h"
+#include "PixelPipeline.h"
 
 using namespace std;
 
@@ -10,66 +14,15 @@ using namespace std;
 const int SCREEN_WIDTH = 640;
 const int SCREEN_HEIGHT = 480;
 
-//Texture wrapper class
-class LTexture
-{
-	public:
-		//Initializes variables
-		LTexture();
-
-		//Deallocates memory
-		~LTexture();
-
-		//Loads image specific path
-		bool loadFromFile( string path );
-
-		#ifdef _SDL_TTF_H
-		//Create image from font string
-		bool loadFromRenderedText( string textureText, SDL_Color textColor );
-		#endif
-
-		//Deallocates texture
-		void free();
-
-		//Set color modulation
-		void setColor( Uint8 red, Uint8 green, Uint8 blue );
-
-		//set blending
-		void setBlendMode( SDL_BlendMode blending );
-
-		//Set alpha modulation
-		void setAlpha( Uint8 alpha );
-
-		//Render texture at given point
-		void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
-
-		//Gets image dimensions
-		int getWidth();
-		int getHeight();
-
-		//Pixel Manipulators
-		bool lockTexture();
-		bool unlockTexture();
-		void* getPixels();
-		int getPitch();
-
-	private:
-		//The actual hardware texture
-		SDL_Texture* mTexture;
-		void* mPixels;
-		int mPitch;
-
-		//Image dimensions
-		int mWidth;
-		int mHeight;
-};
-
 //Starts SDL and creates window
 bool init();
 
 //Loads media
 bool loadMedia();
 
+//Runs the effect picked with the number keys over the keyed pixels
+void applyEffect( SDL_Keycode key );
+
 //Frees media and shuts down SDL
 void close();
 
@@ -82,230 +35,15 @@ SDL_Renderer* gRenderer = NULL;
 //Scene texture
 LTexture gFooTexture;
 
-LTexture::LTexture()
-{
-	//Initialize
-	mTexture = NULL;
-	mWidth = 0;
-	mHeight = 0;
-	mPixels = NULL;
-	mPitch = 0;
-}
-
-LTexture::~LTexture()
-{
-	//Deallocate
-	free();
-}
-
-bool LTexture::loadFromFile( string path )
-{
-	//Get rid of preexisting texture
-	free();
-
-	//The final texture
-	SDL_Texture* newTexture = NULL;
-
-	//Load image at specified path
-	SDL_Surface* loadedSurface = IMG_Load( path.c_str() );
-	if( loadedSurface == NULL )
-	{
-		cout << "Unable to load image %s! SDL_image Error: %s\n" << path.c_str() << IMG_GetError() << endl;
-	}
-	else
-	{
-		//Convert surface to display format
-		SDL_Surface* formattedSurface = SDL_ConvertSurfaceFormat ( loadedSurface, SDL_GetWindowPixelFormat( gWindow ), NULL );
-		if( formattedSurface == NULL )
-		{
-			cout << "Unable to convert loaded surface to display format! SDL Error: %s\n" << SDL_GetError() << endl;
-		}
-		else
-		{
-
-			//Create blank streamable texture
-			newTexture = SDL_CreateTexture( gRenderer, SDL_GetWindowPixelFormat( gWindow ), SDL_TEXTUREACCESS_STREAMING, formattedSurface->w, formattedSurface->h );
-			if( newTexture == NULL )
-			{
-				cout << "Unable to create blank texture! SDL Error: %s\n" << SDL_GetError() << endl;
-			}
-			else
-			{
-
-				//Lock texture for manipulation
-				SDL_LockTexture( newTexture, NULL, &mPixels, &mPitch );
-
-			//Copy loaded/formatted surface pixels
-			memcpy( mPixels, formattedSurface->pixels, formattedSurface->pitch * formattedSurface->h );
-
-			//Unlock texture to update
-			SDL_UnlockTexture( newTexture );
-			mPixels = NULL;
-
-			//Get image dimensions
-			mWidth = formattedSurface->w;
-			mHeight = formattedSurface->h;
-		}
-		//Get rid of old loaded surface
-		SDL_FreeSurface( formattedSurface );
-	}
-
-	//Get rid of old loaded surface
-	SDL_FreeSurface( loadedSurface );
-
-	}
-
-	//Return Success
-	mTexture = newTexture;
-	return mTexture != NULL;
-}
-
-#ifdef _SDL_TTF_H
-bool LTexture::loadFromRenderedText( string textureText, SDL_Color textColor)
-{
-	//Get rid of  preexisting texture
-	free();
-
-	//Render text surface
-	SDL_Surface* textSurface = TTF_RenderText_Solid( gFont, textureText.c_str(), textColor );
-	if( textSurface != NULL )
-	{
-		//Create texture from surface pixels
-		mTexture = SDL_CreateTextureFromSurface( gRenderer, textSurface );
-		if( mTexture == NULL )
-		{
-			cout << "Unable to create texture from rendered text! SDL Error: %s\n" << SDL_GetError << endl;
-		}
-		else
-		{
-			//Get image dimensions
-			mWidth = textSurface->w;
-			mHeight = textSurface->h;
-		}
-		//Get rid of old surface
-		SDL_FreeSurface( textSurface );
-	}
-	else
-	{
-		cout << "Unable to render text surface! SDL_ttf Error: %s\n" << TTF_GetError() << endl;
-	}
-
-	//Return success
-	return mTexture != NULL;
-}
-#endif
-
-void LTexture::free()
-{
-	//Free texture if it exists
-	if( mTexture != NULL )
-	{
-		SDL_DestroyTexture( mTexture );
-		mTexture = NULL;
-		mWidth = 0;
-		mHeight = 0;
-		mPixels = NULL;
-		mPitch = 0;
-	}
-}
-
-void LTexture::setColor( Uint8 red, Uint8 green, Uint8 blue )
-{
-	//Modulate texture rgb
-	SDL_SetTextureColorMod( mTexture, red, green, blue );
-}
-
-void LTexture::setBlendMode( SDL_BlendMode blending )
-{
-	//Set blending function
-	SDL_SetTextureBlendMode( mTexture, blending );
-}
-
-void LTexture::setAlpha( Uint8 alpha )
-{
-	//modulate texture alpha
-	SDL_SetTextureAlphaMod( mTexture, alpha );
-}
-
-void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip )
-{
-	//Set rendering space and render to screen
-	SDL_Rect renderQuad = { x, y, mWidth, mHeight };
-
-	//Set clip rendering dimensions
-	if( clip != NULL )
-	{
-		renderQuad.w = clip->w;
-		renderQuad.h = clip->h;
-	}
-
-	//Render to screen
-	SDL_RenderCopyEx( gRenderer, mTexture, clip, &renderQuad, angle, center, flip );
-}
-
-int LTexture::getWidth()
-{
-	return mWidth;
-}
-
-int LTexture::getHeight()
-{
-	return mHeight;
-}
-
-bool LTexture::lockTexture()
-{
-	bool success = true;
-
-	//Texture is already locked
-	if( mPixels != NULL )
-	{
-		cout << "Texture is already locked!\n" << endl;
-		success = false;
-	}
-	//Lock texture
-	else
-	{
-		if( SDL_LockTexture( mTexture, NULL, &mPixels, &mPitch ) != 0 )
-		{
-			cout << "Unable to lock texture! %s\n" << SDL_GetError() << endl;
-			success = false;
-		}
-	}
+//Runtime effects, on every core
+PixelPipeline* gEffects = NULL;
 
-	return success;
-}
+//Texture pixels after keying, every effect starts from them
+std::vector<Uint32> gKeyedPixels;
 
-bool LTexture::unlockTexture()
-{
-	bool success = true;
-
-	//Texture is not locked
-	if( mPixels == NULL )
-	{
-		cout << "Texture is not locked!\n" << endl;
-		success = false;
-	}
-	//Unlock texture
-	else
-	{
-		SDL_UnlockTexture( mTexture );
-		mPixels = NULL;
-		mPitch = 0;
-	}
-
-	return success;
-}
-
-void* LTexture::getPixels()
-{
-	return mPixels;
-}
-
-int LTexture::getPitch()
-{
-	return mPitch;
-}
+//A small retro palette
+const Uint32 EFFECT_PALETTE[] = { 0x000000FF, 0xFFFFFFFF, 0x880000FF, 0xAAFFEEFF, 0xCC44CCFF, 0x00CC55FF, 0x0000AAFF, 0xEEEE77FF };
+const int EFFECT_PALETTE_SIZE = 8;
 
 bool init()
 {
@@ -367,7 +105,7 @@ bool loadMedia()
 	bool success = true;
 
 	//load foo texture
-	if( !gFooTexture.loadFromFile( "foo.png" ) )
+	if( !gFooTexture.loadFromFile( "foo.png", SDL_TEXTUREACCESS_STREAMING ) )
 	{
 		cout << "Failed to load corner texture!\n" << endl;
 		success = false;
@@ -378,13 +116,13 @@ bool loadMedia()
 		if( !gFooTexture.lockTexture() )
 		{
 			cout << "Unable to lock Foo' texture!\n" << endl;
+			success = false;
 		}
 		//Manual color key
 		else
 		{
-			//Allocate format from window
-			Uint32 format = SDL_GetWindowPixelFormat( gWindow );
-			SDL_PixelFormat* mappingFormat = SDL_AllocFormat ( format );
+			//Allocate the format the streaming texture was created with, every pipeline op works in RGBA8888
+			SDL_PixelFormat* mappingFormat = SDL_AllocFormat( SDL_PIXELFORMAT_RGBA8888 );
 
 			//Get pixel data
 			Uint32* pixels = (Uint32*)gFooTexture.getPixels();
@@ -395,13 +133,12 @@ bool loadMedia()
 			Uint32 transparent = SDL_MapRGBA( mappingFormat, 0xFF, 0xFF, 0xFF, 0x00 );
 
 			//Color key pixels
-			for( int i = 0; i < pixelCount; ++i )
-			{
-				if( pixels[ i ] == colorKey )
-				{
-					pixels[ i ] = transparent;
-				}
-			}
+			gEffects = new PixelPipeline( SDL_GetCPUCount() );
+			gEffects->addColorKey( colorKey, transparent );
+			gEffects->apply( pixels, gFooTexture.getPitch(), gFooTexture.getWidth(), gFooTexture.getHeight() );
+
+			//Keep them for the effects
+			gKeyedPixels.assign( pixels, pixels + pixelCount );
 
 			//Unlock texture
 			gFooTexture.unlockTexture();
@@ -415,11 +152,53 @@ bool loadMedia()
 	return success;
 }
 
+void applyEffect( SDL_Keycode key )
+{
+	//Pick the operations
+	gEffects->clear();
+	switch( key )
+	{
+		case SDLK_2: gEffects->addTint( 0xFF, 0x80, 0x40 ); break;
+		case SDLK_3: gEffects->addGrayscale(); break;
+		case SDLK_4: gEffects->addThreshold( 0x80 ); break;
+		case SDLK_5: gEffects->addBlur( 2 ); break;
+		case SDLK_6: gEffects->addPalette( EFFECT_PALETTE, EFFECT_PALETTE_SIZE ); break;
+
+		//Everything at once, still one pass before the blur and one after
+		case SDLK_7:
+			gEffects->addTint( 0xFF, 0xC0, 0x80 );
+			gEffects->addGrayscale();
+			gEffects->addBlur( 1 );
+			gEffects->addPalette( EFFECT_PALETTE, EFFECT_PALETTE_SIZE );
+			break;
+
+		//1 shows the plain texture
+		case SDLK_1: break;
+		default: return;
+	}
+
+	if( !gFooTexture.lockTexture() )
+	{
+		cout << "Unable to lock Foo' texture!" << endl;
+		return;
+	}
+
+	//Start over from the keyed pixels and run the effect
+	memcpy( gFooTexture.getPixels(), &gKeyedPixels[ 0 ], gKeyedPixels.size() * 4 );
+	gEffects->apply( gFooTexture.getPixels(), gFooTexture.getPitch(), gFooTexture.getWidth(), gFooTexture.getHeight() );
+
+	gFooTexture.unlockTexture();
+}
+
 void close()
 {
 	//Free loaded images
 	gFooTexture.free();
 
+	//Stop effect workers
+	delete gEffects;
+	gEffects = NULL;
+
 	//Destroy window
 	SDL_DestroyRenderer( gRenderer );
 	SDL_DestroyWindow( gWindow );
@@ -464,6 +243,11 @@ int main()
 					{
 						quit = true;
 					}
+					//Number keys switch effects
+					else if( e.type == SDL_KEYDOWN )
+					{
+						applyEffect( e.key.keysym.sym );
+					}
 
 				}
 
@@ -0,0 +1,144 @@
+#include <SDL2/SDL.h>
+#include <string.h>
+#include <vector>
+#include <iostream>
+#include "../Engine/DirtyTracker.h"
+#include "../Engine/BenchUtil.h"
+
+using namespace std;
+
+//Screen sized frames
+const int FRAME_WIDTH = 640;
+const int FRAME_HEIGHT = 480;
+const int FRAME_PITCH = FRAME_WIDTH * 4;
+const int FRAME_BYTES = FRAME_PITCH * FRAME_HEIGHT;
+
+//Frames per run
+const int BENCH_FRAMES = 600;
+
+//Sprite moving over the mostly static content
+const int SPRITE_SIZE = 48;
+const int SPRITE_SPEED = 3;
+
+//Kinds of content
+enum ContentMode
+{
+	CONTENT_STATIC,
+	CONTENT_DYNAMIC,
+	TOTAL_CONTENT_MODES
+};
+
+//Content display names
+const char* CONTENT_MODE_NAMES[] = { "mostly static", "fully dynamic" };
+
+//Ways to bring the texture up to date
+enum UploadMode
+{
+	UPLOAD_FULL,
+	UPLOAD_DIRTY,
+	UPLOAD_ADAPTIVE,
+	TOTAL_UPLOAD_MODES
+};
+
+//Upload display names
+const char* UPLOAD_MODE_NAMES[] = { "full copy", "dirty tiles", "dirty or full" };
+
+//Draws frame number frame of the given content
+void makeFrame( ContentMode mode, int frame, vector<Uint32>& pixels )
+{
+	if( mode == CONTENT_DYNAMIC )
+	{
+		//Every pixel changes every frame
+		Uint32 random = (Uint32)frame * 2654435761u + 1;
+		for( int i = 0; i < FRAME_WIDTH * FRAME_HEIGHT; ++i )
+		{
+			pixels[ i ] = nextRandom( random );
+		}
+		return;
+	}
+
+	//Fixed checkerboard with one sprite bouncing across it
+	for( int y = 0; y < FRAME_HEIGHT; ++y )
+	{
+		for( int x = 0; x < FRAME_WIDTH; ++x )
+		{
+			pixels[ y * FRAME_WIDTH + x ] = ( ( x / 8 + y / 8 ) & 1 ) ? 0xFFFFFFFF : 0x808080FF;
+		}
+	}
+	int travel = frame * SPRITE_SPEED % ( ( FRAME_WIDTH - SPRITE_SIZE ) * 2 );
+	int spriteX = travel < FRAME_WIDTH - SPRITE_SIZE ? travel : ( FRAME_WIDTH - SPRITE_SIZE ) * 2 - travel;
+	int spriteY = ( FRAME_HEIGHT - SPRITE_SIZE ) / 2;
+	for( int y = 0; y < SPRITE_SIZE; ++y )
+	{
+		for( int x = 0; x < SPRITE_SIZE; ++x )
+		{
+			pixels[ ( spriteY + y ) * FRAME_WIDTH + spriteX + x ] = 0xFF0000FF;
+		}
+	}
+}
+
+int main( int argc, char* args[] )
+{
+	cout << "content\tupload\tbytes/frame\tus CPU/frame\tmatches" << endl;
+
+	vector<Uint32> frame( FRAME_WIDTH * FRAME_HEIGHT );
+	vector<Uint8> texture( FRAME_BYTES );
+	bool allMatch = true;
+	for( int c = 0; c < TOTAL_CONTENT_MODES; ++c )
+	{
+		ContentMode mode = (ContentMode)c;
+		for( int u = 0; u < TOTAL_UPLOAD_MODES; ++u )
+		{
+			UploadMode upload = (UploadMode)u;
+			DirtyTracker tracker( FRAME_WIDTH, FRAME_HEIGHT );
+			memset( &texture[ 0 ], 0, FRAME_BYTES );
+			double bytes = 0;
+			Uint64 counter = 0;
+			bool matches = true;
+			for( int f = 0; f < BENCH_FRAMES; ++f )
+			{
+				//Frame drawing stays out of the timing
+				makeFrame( mode, f, frame );
+				const Uint8* source = (const Uint8*)&frame[ 0 ];
+
+				//Texture buffer stands in for the locked streaming texture
+				Uint64 start = SDL_GetPerformanceCounter();
+				if( upload != UPLOAD_FULL )
+				{
+					int count = upload == UPLOAD_ADAPTIVE ? tracker.diffOrWhole( source, FRAME_PITCH ) : tracker.diff( source, FRAME_PITCH );
+					const vector<SDL_Rect>& rects = tracker.getRects();
+					for( int i = 0; i < count; ++i )
+					{
+						for( int y = rects[ i ].y; y < rects[ i ].y + rects[ i ].h; ++y )
+						{
+							memcpy( &texture[ y * FRAME_PITCH + rects[ i ].x * 4 ], source + y * FRAME_PITCH + rects[ i ].x * 4, rects[ i ].w * 4 );
+						}
+					}
+					bytes += tracker.getDirtyBytes();
+				}
+				else
+				{
+					memcpy( &texture[ 0 ], source, FRAME_BYTES );
+					bytes += FRAME_BYTES;
+				}
+				counter += SDL_GetPerformanceCounter() - start;
+
+				//The texture has to end up holding the whole frame either way
+				matches = matches && memcmp( &texture[ 0 ], source, FRAME_BYTES ) == 0;
+			}
+
+			double seconds = (double)counter / SDL_GetPerformanceFrequency();
+			cout << CONTENT_MODE_NAMES[ mode ] << "\t" << UPLOAD_MODE_NAMES[ upload ] << "\t" << bytes / BENCH_FRAMES << "\t";
+			cout << seconds / BENCH_FRAMES * 1000000.0 << "\t" << ( matches ? "yes" : "no" ) << endl;
+			allMatch = allMatch && matches;
+		}
+	}
+
+	if( !allMatch )
+	{
+		cout << "Uploaded textures do not match their frames!" << endl;
+		return 1;
+	}
+
+	return 0;
+}
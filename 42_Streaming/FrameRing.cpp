@@ -0,0 +1,221 @@
+#include "FrameRing.h"
+
+FrameRing::FrameRing( int slots, int frameBytes, RingPolicy policy )
+{
+	//Two slots are the least that lets both sides work at once
+	mSlotCount = slots < 2 ? 2 : ( slots > MAX_SLOTS ? MAX_SLOTS : slots );
+	mFrameBytes = frameBytes;
+	mPixels.assign( (size_t)mSlotCount * frameBytes, 0 );
+	mPolicy = policy;
+
+	//Plain sets are fine before either thread has the ring
+	for( int i = 0; i < MAX_SLOTS; ++i )
+	{
+		SDL_AtomicSet( &mSlots[ i ].state, SLOT_FREE );
+		SDL_AtomicSet( &mSlots[ i ].sequence, 0 );
+		mSlots[ i ].readyCounter = 0;
+	}
+
+	mWriteSlot = -1;
+	mReadSlot = -1;
+	SDL_AtomicSet( &mWritten, 0 );
+	resetStats();
+}
+
+void* FrameRing::beginWrite()
+{
+	//Take a free slot if there is one
+	for( int i = 0; i < mSlotCount; ++i )
+	{
+		if( SDL_AtomicCAS( &mSlots[ i ].state, SLOT_FREE, SLOT_WRITING ) )
+		{
+			mWriteSlot = i;
+			return &mPixels[ (size_t)i * mFrameBytes ];
+		}
+	}
+
+	if( mPolicy == RING_BACKPRESSURE )
+	{
+		SDL_AtomicAdd( &mStalls, 1 );
+		return NULL;
+	}
+
+	//Otherwise overwrite the oldest frame the consumer has not taken, retrying if it takes it first
+	//The consumer holds one slot while reading and more only for the moment it sweeps skipped frames,
+	//it hands those straight back, so with at least two slots a ready or free one always turns up
+	while( true )
+	{
+		int oldest = findReady( false );
+		if( oldest >= 0 && SDL_AtomicCAS( &mSlots[ oldest ].state, SLOT_READY, SLOT_WRITING ) )
+		{
+			SDL_AtomicAdd( &mOverwritten, 1 );
+			mWriteSlot = oldest;
+			return &mPixels[ (size_t)oldest * mFrameBytes ];
+		}
+		for( int i = 0; i < mSlotCount; ++i )
+		{
+			if( SDL_AtomicCAS( &mSlots[ i ].state, SLOT_FREE, SLOT_WRITING ) )
+			{
+				mWriteSlot = i;
+				return &mPixels[ (size_t)i * mFrameBytes ];
+			}
+		}
+	}
+}
+
+void FrameRing::endWrite()
+{
+	if( mWriteSlot < 0 )
+	{
+		return;
+	}
+
+	//Stamp the frame, then publish it, the compare and swap orders the pixels and stamps before it
+	//Only the producer moves a slot out of writing, so it cannot fail
+	Slot& slot = mSlots[ mWriteSlot ];
+	slot.readyCounter = SDL_GetPerformanceCounter();
+	SDL_AtomicSet( &slot.sequence, SDL_AtomicAdd( &mWritten, 1 ) + 1 );
+	SDL_AtomicCAS( &slot.state, SLOT_WRITING, SLOT_READY );
+	mWriteSlot = -1;
+}
+
+void* FrameRing::beginRead()
+{
+	while( true )
+	{
+		//Newest frame when dropping, oldest when every frame has to be shown
+		int next = findReady( mPolicy == RING_DROP );
+		if( next < 0 )
+		{
+			return NULL;
+		}
+		if( !SDL_AtomicCAS( &mSlots[ next ].state, SLOT_READY, SLOT_READING ) )
+		{
+			//Producer took it back first
+			continue;
+		}
+		mReadSlot = next;
+
+		//Anything older still waiting will never be shown, hand it back now
+		//Slots are claimed before their sequence is checked, so one republished in between is never freed unread
+		if( mPolicy == RING_DROP )
+		{
+			int sequence = SDL_AtomicGet( &mSlots[ next ].sequence );
+			for( int i = 0; i < mSlotCount; ++i )
+			{
+				if( i == next || !SDL_AtomicCAS( &mSlots[ i ].state, SLOT_READY, SLOT_READING ) )
+				{
+					continue;
+				}
+				if( SDL_AtomicGet( &mSlots[ i ].sequence ) < sequence )
+				{
+					SDL_AtomicCAS( &mSlots[ i ].state, SLOT_READING, SLOT_FREE );
+					++mSkipped;
+				}
+				else
+				{
+					SDL_AtomicCAS( &mSlots[ i ].state, SLOT_READING, SLOT_READY );
+				}
+			}
+		}
+
+		return &mPixels[ (size_t)next * mFrameBytes ];
+	}
+}
+
+void FrameRing::endRead()
+{
+	if( mReadSlot < 0 )
+	{
+		return;
+	}
+
+	//Time from publish to being done with the frame
+	Slot& slot = mSlots[ mReadSlot ];
+	double latency = (double)( SDL_GetPerformanceCounter() - slot.readyCounter ) / SDL_GetPerformanceFrequency();
+	mLatencyTotal += latency;
+	if( latency > mLatencyMax )
+	{
+		mLatencyMax = latency;
+	}
+	++mRead;
+
+	//Only the consumer moves a slot out of reading, so it cannot fail
+	SDL_AtomicCAS( &slot.state, SLOT_READING, SLOT_FREE );
+	mReadSlot = -1;
+}
+
+int FrameRing::getReadSequence()
+{
+	return mReadSlot < 0 ? 0 : SDL_AtomicGet( &mSlots[ mReadSlot ].sequence );
+}
+
+int FrameRing::getFrameBytes()
+{
+	return mFrameBytes;
+}
+
+RingPolicy FrameRing::getPolicy()
+{
+	return mPolicy;
+}
+
+int FrameRing::getWrittenCount()
+{
+	return SDL_AtomicGet( &mWritten );
+}
+
+int FrameRing::getReadCount()
+{
+	return mRead;
+}
+
+int FrameRing::getDroppedCount()
+{
+	return SDL_AtomicGet( &mOverwritten ) + mSkipped;
+}
+
+int FrameRing::getStallCount()
+{
+	return SDL_AtomicGet( &mStalls );
+}
+
+double FrameRing::getMeanLatency()
+{
+	return mRead > 0 ? mLatencyTotal / mRead : 0;
+}
+
+double FrameRing::getMaxLatency()
+{
+	return mLatencyMax;
+}
+
+void FrameRing::resetStats()
+{
+	SDL_AtomicSet( &mOverwritten, 0 );
+	SDL_AtomicSet( &mStalls, 0 );
+	mRead = 0;
+	mSkipped = 0;
+	mLatencyTotal = 0;
+	mLatencyMax = 0;
+}
+
+int FrameRing::findReady( bool newest )
+{
+	int found = -1;
+	int foundSequence = 0;
+	for( int i = 0; i < mSlotCount; ++i )
+	{
+		if( SDL_AtomicGet( &mSlots[ i ].state ) != SLOT_READY )
+		{
+			continue;
+		}
+		int sequence = SDL_AtomicGet( &mSlots[ i ].sequence );
+		if( found < 0 || ( newest ? sequence > foundSequence : sequence < foundSequence ) )
+		{
+			found = i;
+			foundSequence = sequence;
+		}
+	}
+	return found;
+}
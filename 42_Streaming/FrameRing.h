@@ -0,0 +1,120 @@
+#ifndef FRAME_RING_H
+#define FRAME_RING_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+//What happens when the producer gets ahead of the consumer
+enum RingPolicy
+{
+	//Producer never waits, it reuses the oldest unread frame and the consumer skips to the newest one
+	RING_DROP,
+
+	//Producer waits for a free slot and the consumer reads every frame in order
+	RING_BACKPRESSURE
+};
+
+//Ring of frame buffers handed from one producer thread to one consumer thread without locks
+//Each slot's state is an atomic, a thread only touches a slot's pixels while its state says that thread owns it
+class FrameRing
+{
+	public:
+		//Most slots in a ring
+		static const int MAX_SLOTS = 16;
+
+		//Allocates slots frames of frameBytes each
+		FrameRing( int slots, int frameBytes, RingPolicy policy = RING_DROP );
+
+		//Producer side, a buffer to fill, or NULL if every slot is taken and the policy is backpressure
+		void* beginWrite();
+
+		//Producer side, publishes the buffer from beginWrite
+		void endWrite();
+
+		//Consumer side, the frame to upload next, or NULL if nothing new is ready
+		void* beginRead();
+
+		//Consumer side, hands the frame from beginRead back to the producer
+		void endRead();
+
+		//Sequence number of the frame from beginRead, counting from 1
+		int getReadSequence();
+
+		//Frame size and policy
+		int getFrameBytes();
+		RingPolicy getPolicy();
+
+		//Frames published and read
+		int getWrittenCount();
+		int getReadCount();
+
+		//Published frames that were never read, overwritten by the producer or skipped by the consumer
+		int getDroppedCount();
+
+		//Times beginWrite found no free slot under backpressure
+		int getStallCount();
+
+		//Seconds from a frame being published to it being handed back, averaged and worst
+		double getMeanLatency();
+		double getMaxLatency();
+
+		//Forgets counts and latencies
+		void resetStats();
+
+	private:
+		//Who owns a slot
+		enum SlotState
+		{
+			SLOT_FREE,
+			SLOT_WRITING,
+			SLOT_READY,
+			SLOT_READING
+		};
+
+		//One frame's bookkeeping, padded so producer and consumer don't share cache lines
+		struct Slot
+		{
+			//SlotState, once the ring is shared only changed by compare and swap, which is a full barrier
+			//so pixels written by a slot's owner are visible before the slot is handed on
+			SDL_atomic_t state;
+
+			//Publish order, set before the slot becomes ready
+			SDL_atomic_t sequence;
+
+			//Performance counter when published, only read by the slot's owner
+			Uint64 readyCounter;
+
+			char padding[ 64 ];
+		};
+
+		//Ready slot with the lowest or highest sequence, -1 if there is none
+		int findReady( bool newest );
+
+		//Slots and their pixels
+		Slot mSlots[ MAX_SLOTS ];
+		int mSlotCount;
+		int mFrameBytes;
+		std::vector< Uint8 > mPixels;
+		RingPolicy mPolicy;
+
+		//Slot each side currently owns, -1 for none
+		int mWriteSlot;
+		int mReadSlot;
+
+		//Producer counts, atomic since the consumer reports them
+		SDL_atomic_t mWritten;
+		SDL_atomic_t mOverwritten;
+		SDL_atomic_t mStalls;
+
+		//Consumer counts
+		int mRead;
+		int mSkipped;
+		double mLatencyTotal;
+		double mLatencyMax;
+
+		//Owns its buffers, so no copies
+		FrameRing( const FrameRing& );
+		FrameRing& operator=( const FrameRing& );
+};
+
+#endif
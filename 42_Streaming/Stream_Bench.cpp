@@ -0,0 +1,113 @@
+#include <SDL2/SDL.h>
+#include <string.h>
+#include <vector>
+#include <iostream>
+#include "FrameRing.h"
+#include "../Engine/FramePacer.h"
+
+using namespace std;
+
+//Synthetic frames the size of the screen
+const int FRAME_WIDTH = 640;
+const int FRAME_HEIGHT = 480;
+const int FRAME_PIXELS = FRAME_WIDTH * FRAME_HEIGHT;
+
+//Producer and consumer rates
+const int PRODUCER_FPS = 1000;
+const int CONSUMER_FPS = 60;
+
+//Seconds per run
+const double BENCH_SECONDS = 2.0;
+
+//Slots in the ring
+const int RING_SLOTS = 3;
+
+//Policy display names
+const char* RING_POLICY_NAMES[] = { "drop", "backpressure" };
+
+//Shared between the synthetic decoder thread and the bench
+struct Source
+{
+	FrameRing* ring;
+	SDL_atomic_t quit;
+};
+
+//Synthetic decoder, fills every pixel of each frame with its sequence number
+int produce( void* data )
+{
+	Source* source = (Source*)data;
+	FramePacer pacer( PRODUCER_FPS );
+	while( !SDL_AtomicGet( &source->quit ) )
+	{
+		Uint32* pixels = (Uint32*)source->ring->beginWrite();
+		if( pixels == NULL )
+		{
+			//Consumer is behind, wait for a slot
+			SDL_Delay( 1 );
+			continue;
+		}
+
+		Uint32 sequence = (Uint32)source->ring->getWrittenCount() + 1;
+		for( int i = 0; i < FRAME_PIXELS; ++i )
+		{
+			pixels[ i ] = sequence;
+		}
+		source->ring->endWrite();
+		pacer.wait();
+	}
+	return 0;
+}
+
+int main( int argc, char* args[] )
+{
+	cout << "policy\twritten\tuploaded\tdropped\tstalls\ttorn\tout of order\tmean latency ms\tmax latency ms" << endl;
+
+	//Stand in for the streaming texture's locked pixels
+	vector<Uint32> texture( FRAME_PIXELS );
+
+	for( int p = 0; p < 2; ++p )
+	{
+		RingPolicy policy = (RingPolicy)p;
+		FrameRing ring( RING_SLOTS, FRAME_PIXELS * 4, policy );
+		Source source;
+		source.ring = &ring;
+		SDL_AtomicSet( &source.quit, 0 );
+		SDL_Thread* decoder = SDL_CreateThread( produce, "Decoder", &source );
+
+		//Render loop, uploads the next frame if there is one
+		FramePacer pacer( CONSUMER_FPS );
+		int torn = 0;
+		int outOfOrder = 0;
+		int lastSequence = 0;
+		for( int frame = 0; frame < CONSUMER_FPS * BENCH_SECONDS; ++frame )
+		{
+			Uint32* pixels = (Uint32*)ring.beginRead();
+			if( pixels != NULL )
+			{
+				memcpy( &texture[ 0 ], pixels, FRAME_PIXELS * 4 );
+
+				//Every pixel should come from the same frame, and frames should only move forward
+				int sequence = ring.getReadSequence();
+				if( texture[ 0 ] != (Uint32)sequence || texture[ FRAME_PIXELS / 2 ] != (Uint32)sequence || texture[ FRAME_PIXELS - 1 ] != (Uint32)sequence )
+				{
+					++torn;
+				}
+				if( sequence <= lastSequence || ( policy == RING_BACKPRESSURE && sequence != lastSequence + 1 ) )
+				{
+					++outOfOrder;
+				}
+				lastSequence = sequence;
+				ring.endRead();
+			}
+			pacer.wait();
+		}
+
+		SDL_AtomicSet( &source.quit, 1 );
+		SDL_WaitThread( decoder, NULL );
+
+		cout << RING_POLICY_NAMES[ policy ] << "\t" << ring.getWrittenCount() << "\t" << ring.getReadCount() << "\t" << ring.getDroppedCount() << "\t" << ring.getStallCount() << "\t";
+		cout << torn << "\t" << outOfOrder << "\t" << ring.getMeanLatency() * 1000.0 << "\t" << ring.getMaxLatency() * 1000.0 << endl;
+	}
+
+	return 0;
+}
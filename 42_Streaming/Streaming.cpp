@@ -1,8 +1,14 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <stdio.h>
+#include <string.h>
 #include <string>
 #include <iostream>
+#include "../Engine/LTexture.h"
+#include "../Engine/FramePacer.h"
+#include "../Engine/DirtyTracker.h"
+#include "../Engine/PixelKernels.h"
+#include "FrameRing.h"
 
 using namespace std;
 
@@ -10,64 +16,18 @@ using namespace std;
 const int SCREEN_WIDTH = 640;
 const int SCREEN_HEIGHT = 480;
 
-//Texture wrapper class
-class LTexture
-{
-	public:
-		//Initializes variables
-		LTexture();
-
-		//Deallocates memory
-		~LTexture();
-
-		//Loads image specific path
-		bool loadFromFile( string path );
-
-		#ifdef _SDL_TTF_H
-		//Create image from font string
-		bool loadFromRenderedText( string textureText, SDL_Color textColor );
-		#endif
-
-		//Creates blank texture
-		bool createBlank( int width, int height );
-
-		//Deallocates texture
-		void free();
-
-		//Set color modulation
-		void setColor( Uint8 red, Uint8 green, Uint8 blue );
-
-		//set blending
-		void setBlendMode( SDL_BlendMode blending );
-
-		//Set alpha modulation
-		void setAlpha( Uint8 alpha );
-
-		//Render texture at given point
-		void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
+//Animation frames the decoder thread produces per second, the old loop showed each image for 4 frames at 60
+const int STREAM_FPS = 15;
 
-		//Gets image dimensions
-		int getWidth();
-		int getHeight();
+//Frames in flight between the decoder and the render thread
+const int STREAM_SLOTS = 3;
 
-		//Pixel Manipulators
-		bool lockTexture();
-		bool unlockTexture();
-		void* getPixels();
-		void copyPixels(void* pixels );
-		int getPitch();
-		Uint32 getPixel32( unsigned int x, unsigned int y );
+//Animation frame dimensions
+const int STREAM_WIDTH = 64;
+const int STREAM_HEIGHT = 205;
 
-	private:
-		//The actual hardware texture
-		SDL_Texture* mTexture;
-		void* mPixels;
-		int mPitch;
-
-		//Image dimensions
-		int mWidth;
-		int mHeight;
-};
+//Side of the squares frames are compared in, the animation is small so its tiles are too
+const int STREAM_TILE_SIZE = 16;
 
 //A test animations screen
 class DataStream
@@ -82,14 +42,27 @@ class DataStream
 		//Deallocates
 		void free();
 
-		//Gets current frame data
-		void* getBuffer();
+		//Starts decoding frames into a ring on their own thread
+		bool start( RingPolicy policy );
+
+		//Stops the decoder thread
+		void stop();
+
+		//Ring the decoded frames arrive in, NULL until started
+		FrameRing* getRing();
 
 	private:
+		//Decoder thread entry point
+		static int decodeMain( void* data );
+
 		//Internal data
 		SDL_Surface* mImages[ 4 ];
 		int mCurrentImage;
-		int mDelayFrames;
+
+		//Decoded frames and the thread filling them
+		FrameRing* mRing;
+		SDL_Thread* mThread;
+		SDL_atomic_t mQuit;
 };
 
 //Starts SDL and creates window
@@ -113,347 +86,136 @@ LTexture gStreamingTexture;
 //Animation stream
 DataStream gDataStream;
 
-LTexture::LTexture()
-{
-	//Initialize
-	mTexture = NULL;
-	mWidth = 0;
-	mHeight = 0;
-	mPixels = NULL;
-	mPitch = 0;
-}
+//Parts of the streaming texture that changed since the last upload
+DirtyTracker gDirtyTracker( STREAM_WIDTH, STREAM_HEIGHT, STREAM_TILE_SIZE );
 
-LTexture::~LTexture()
+DataStream::DataStream()
 {
-	//Deallocate
-	free();
+	mImages[ 0 ] = NULL;
+	mImages[ 1 ] = NULL;
+	mImages[ 2 ] = NULL;
+	mImages[ 3 ] = NULL;
+
+	mCurrentImage = 0;
+
+	mRing = NULL;
+	mThread = NULL;
+	SDL_AtomicSet( &mQuit, 0 );
 }
 
-bool LTexture::loadFromFile( string path )
+bool DataStream::loadMedia()
 {
-	//Get rid of preexisting texture
-	free();
-
-	//The final texture
-	SDL_Texture* newTexture = NULL;
+	bool success = true;
 
-	//Load image at specified path
-	SDL_Surface* loadedSurface = IMG_Load( path.c_str() );
-	if( loadedSurface == NULL )
-	{
-		cout << "Unable to load image %s! SDL_image Error: %s\n" << path.c_str() << IMG_GetError() << endl;
-	}
-	else
+	for(int i = 0; i < 4; ++i )
 	{
-		//Convert surface to display format
-		SDL_Surface* formattedSurface = SDL_ConvertSurfaceFormat ( loadedSurface, SDL_PIXELFORMAT_RGBA8888, NULL );
-		if( formattedSurface == NULL )
+		char path[ 64 ] = "";
+		sprintf( path, "foo_walk_%d.png", i );
+
+		SDL_Surface* loadedSurface = IMG_Load( path );
+		if( loadedSurface == NULL )
 		{
-			cout << "Unable to convert loaded surface to display format! SDL Error: %s\n" << SDL_GetError() << endl;
+			cout << "Unable to laod %s! SDL_image Error: %s\n" << path << IMG_GetError() << endl;
+			success = false;
 		}
 		else
 		{
-
-			//Create blank streamable texture
-			newTexture = SDL_CreateTexture( gRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STREAMING, formattedSurface->w, formattedSurface->h );
-			if( newTexture == NULL )
+			//Common image formats convert straight into the frame, anything else goes through SDL
+			mImages[ i ] = SDL_CreateRGBSurfaceWithFormat( 0, loadedSurface->w, loadedSurface->h, 32, SDL_PIXELFORMAT_RGBA8888 );
+			if( mImages[ i ] != NULL && !convertToRGBA8888( getBestPixelKernel(), loadedSurface, mImages[ i ]->pixels, mImages[ i ]->pitch ) )
 			{
-				cout << "Unable to create blank texture! SDL Error: %s\n" << SDL_GetError() << endl;
+				SDL_FreeSurface( mImages[ i ] );
+				mImages[ i ] = SDL_ConvertSurfaceFormat( loadedSurface, SDL_PIXELFORMAT_RGBA8888, 0 );
 			}
-			else
-			{
-
-				//Enable blending on texture
-				SDL_SetTextureBlendMode( newTexture, SDL_BLENDMODE_BLEND );
-
-				//Lock texture for manipulation
-				SDL_LockTexture( newTexture, &formattedSurface->clip_rect, &mPixels, &mPitch );
-
-			//Copy loaded/formatted surface pixels
-			memcpy( mPixels, formattedSurface->pixels, formattedSurface->pitch * formattedSurface->h );
-
-			//Get image dimensions
-			mWidth = formattedSurface->w;
-			mHeight = formattedSurface->h;
-
-			//Get pixel data in editable format
-			Uint32* pixels = (Uint32*)mPixels;
-			int pixelCount = ( mPitch / 4 ) * mHeight;
-
-			//Map colors
-			Uint32 colorKey = SDL_MapRGB ( formattedSurface->format, 0, 0xFF, 0xFF );
-			Uint32 transparent = SDL_MapRGBA ( formattedSurface->format, 0x00, 0xFF, 0xFF, 0x00 );
-
-			//Color key pixels
-			for( int i = 0; i < pixelCount; ++i )
+			if( mImages[ i ] == NULL )
 			{
-				if( pixels[ i ] == colorKey )
-				{
-					pixels[ i ] = transparent;
-				}
+				cout << "Unable to convert " << path << "! SDL Error: " << SDL_GetError() << endl;
+				success = false;
 			}
-
-			//Unlock texture to update
-			SDL_UnlockTexture( newTexture );
-			mPixels = NULL;
-
-		}
-		//Get rid of old formatted surface
-		SDL_FreeSurface( formattedSurface );
-	}
-
-	//Get rid of old loaded surface
-	SDL_FreeSurface( loadedSurface );
-
-	}
-
-	//Return Success
-	mTexture = newTexture;
-	return mTexture != NULL;
-}
-
-#ifdef _SDL_TTF_H
-bool LTexture::loadFromRenderedText( string textureText, SDL_Color textColor)
-{
-	//Get rid of  preexisting texture
-	free();
-
-	//Render text surface
-	SDL_Surface* textSurface = TTF_RenderText_Solid( gFont, textureText.c_str(), textColor );
-	if( textSurface != NULL )
-	{
-		//Create texture from surface pixels
-		mTexture = SDL_CreateTextureFromSurface( gRenderer, textSurface );
-		if( mTexture == NULL )
-		{
-			cout << "Unable to create texture from rendered text! SDL Error: %s\n" << SDL_GetError << endl;
-		}
-		else
-		{
-			//Get image dimensions
-			mWidth = textSurface->w;
-			mHeight = textSurface->h;
 		}
-		//Get rid of old surface
-		SDL_FreeSurface( textSurface );
-	}
-	else
-	{
-		cout << "Unable to render text surface! SDL_ttf Error: %s\n" << TTF_GetError() << endl;
-	}
-
-	//Return success
-	return mTexture != NULL;
-}
-#endif
-
-bool LTexture::createBlank( int width, int height )
-{
-	//Create uninitialized texture
-	mTexture = SDL_CreateTexture( gRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STREAMING, width, height );
-	if( mTexture == NULL )
-	{
-		cout << "Unable to create blank texture! SDL Error: %s\n" << SDL_GetError() << endl;
-	}
-	else
-	{
-		mWidth = width;
-		mHeight = height;
-	}
-
-	return mTexture != NULL;
-}
 
-void LTexture::free()
-{
-	//Free texture if it exists
-	if( mTexture != NULL )
-	{
-		SDL_DestroyTexture( mTexture );
-		mTexture = NULL;
-		mWidth = 0;
-		mHeight = 0;
-		mPixels = NULL;
-		mPitch = 0;
+		SDL_FreeSurface( loadedSurface );
 	}
+	return success;
 }
 
-void LTexture::setColor( Uint8 red, Uint8 green, Uint8 blue )
-{
-	//Modulate texture rgb
-	SDL_SetTextureColorMod( mTexture, red, green, blue );
-}
-
-void LTexture::setBlendMode( SDL_BlendMode blending )
-{
-	//Set blending function
-	SDL_SetTextureBlendMode( mTexture, blending );
-}
-
-void LTexture::setAlpha( Uint8 alpha )
-{
-	//modulate texture alpha
-	SDL_SetTextureAlphaMod( mTexture, alpha );
-}
-
-void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip )
+void DataStream::free()
 {
-	//Set rendering space and render to screen
-	SDL_Rect renderQuad = { x, y, mWidth, mHeight };
+	//The decoder reads the images, so it goes first
+	stop();
 
-	//Set clip rendering dimensions
-	if( clip != NULL )
+	for( int i = 0; i < 4; ++i )
 	{
-		renderQuad.w = clip->w;
-		renderQuad.h = clip->h;
+		SDL_FreeSurface( mImages[ i ] );
+		mImages[ i ] = NULL;
 	}
-
-	//Render to screen
-	SDL_RenderCopyEx( gRenderer, mTexture, clip, &renderQuad, angle, center, flip );
-}
-
-int LTexture::getWidth()
-{
-	return mWidth;
-}
-
-int LTexture::getHeight()
-{
-	return mHeight;
 }
 
-bool LTexture::lockTexture()
+bool DataStream::start( RingPolicy policy )
 {
-	bool success = true;
-
-	//Texture is already locked
-	if( mPixels != NULL )
-	{
-		cout << "Texture is already locked!\n" << endl;
-		success = false;
-	}
-	//Lock texture
-	else
+	//Already running or nothing to decode
+	if( mThread != NULL || mImages[ 0 ] == NULL )
 	{
-		if( SDL_LockTexture( mTexture, NULL, &mPixels, &mPitch ) != 0 )
-		{
-			cout << "Unable to lock texture! %s\n" << SDL_GetError() << endl;
-			success = false;
-		}
+		return false;
 	}
 
-	return success;
-}
-
-bool LTexture::unlockTexture()
-{
-	bool success = true;
-
-	//Texture is not locked
-	if( mPixels == NULL )
-	{
-		cout << "Texture is not locked!\n" << endl;
-		success = false;
-	}
-	//Unlock texture
-	else
+	//Every image has the same size and format
+	mRing = new FrameRing( STREAM_SLOTS, mImages[ 0 ]->pitch * mImages[ 0 ]->h, policy );
+	SDL_AtomicSet( &mQuit, 0 );
+	mThread = SDL_CreateThread( decodeMain, "Decoder", this );
+	if( mThread == NULL )
 	{
-		SDL_UnlockTexture( mTexture );
-		mPixels = NULL;
-		mPitch = 0;
+		cout << "Unable to create decoder thread! SDL Error: " << SDL_GetError() << endl;
+		delete mRing;
+		mRing = NULL;
+		return false;
 	}
 
-	return success;
-}
-
-void* LTexture::getPixels()
-{
-	return mPixels;
+	return true;
 }
 
-void LTexture::copyPixels( void* pixels )
+void DataStream::stop()
 {
-	//Texture is locked
-	if( mPixels != NULL )
+	if( mThread != NULL )
 	{
-		//Copy to locked pixels
-		memcpy( mPixels, pixels,  mPitch * mHeight );
+		SDL_AtomicSet( &mQuit, 1 );
+		SDL_WaitThread( mThread, NULL );
+		mThread = NULL;
 	}
-}
-
-int LTexture::getPitch()
-{
-	return mPitch;
-}
-
-Uint32 LTexture::getPixel32( unsigned int x, unsigned int y )
-{
-	//Convert the pixels to bit
-	Uint32 *pixels = (Uint32*)mPixels;
 
-	//Get the pixel requested
-	return pixels[ ( y * ( mPitch / 4 ) ) + x ];
+	delete mRing;
+	mRing = NULL;
 }
 
-DataStream::DataStream()
+FrameRing* DataStream::getRing()
 {
-	mImages[ 0 ] = NULL;
-	mImages[ 1 ] = NULL;
-	mImages[ 2 ] = NULL;
-	mImages[ 3 ] = NULL;
-
-	mCurrentImage = 0;
-	mDelayFrames = 4;
+	return mRing;
 }
 
-bool DataStream::loadMedia()
+int DataStream::decodeMain( void* data )
 {
-	bool success = true;
-
-	for(int i = 0; i < 4; ++i )
+	DataStream* stream = (DataStream*)data;
+	FramePacer pacer( STREAM_FPS );
+	while( !SDL_AtomicGet( &stream->mQuit ) )
 	{
-		char path[ 64 ] = "";
-		sprintf( path, "foo_walk_%d.png", i );
-
-		SDL_Surface* loadedSurface = IMG_Load( path );
-		if( loadedSurface == NULL )
-		{
-			cout << "Unable to laod %s! SDL_image Error: %s\n" << path << IMG_GetError() << endl;
-			success = false;
-		}
-		else
+		//Wait for a slot when the ring applies backpressure
+		void* pixels = stream->mRing->beginWrite();
+		if( pixels == NULL )
 		{
-			mImages[ i ] = SDL_ConvertSurfaceFormat ( loadedSurface, SDL_PIXELFORMAT_RGBA8888, NULL );
+			SDL_Delay( 1 );
+			continue;
 		}
 
-		SDL_FreeSurface( loadedSurface );
-	}
-	return success;
-}
-
-void DataStream::free()
-{
-	for( int i = 0; i < 4; ++i )
-	{
-		SDL_FreeSurface( mImages[ i ] );
-	}
-}
-
-void* DataStream::getBuffer()
-{
-	--mDelayFrames;
-	if( mDelayFrames == 0 )
-	{
-		++mCurrentImage;
-		mDelayFrames = 4;
-	}
+		//Decode the next image, here just a copy out of the preloaded surfaces
+		SDL_Surface* image = stream->mImages[ stream->mCurrentImage ];
+		memcpy( pixels, image->pixels, image->pitch * image->h );
+		stream->mRing->endWrite();
+		stream->mCurrentImage = ( stream->mCurrentImage + 1 ) % 4;
 
-	if( mCurrentImage == 4 )
-	{
-		mCurrentImage = 0;
+		pacer.wait();
 	}
 
-	return mImages[ mCurrentImage ]->pixels;
+	return 0;
 }
 
 bool init()
@@ -519,7 +281,7 @@ bool loadMedia()
 	bool success = true;
 
 	//load blank texture
-	if( !gStreamingTexture.createBlank( 64, 205 ) )
+	if( !gStreamingTexture.createBlank( STREAM_WIDTH, STREAM_HEIGHT ) )
 	{
 		cout << "Failed to create streaming texture!\n" << endl;
 		success = false;
@@ -552,8 +314,15 @@ void close()
 	SDL_Quit();
 }
 
-int main()
+int main( int argc, char* args[] )
 {
+	//Frames are dropped to stay current unless backpressure is asked for
+	RingPolicy policy = RING_DROP;
+	if( argc > 1 && string( args[ 1 ] ) == "backpressure" )
+	{
+		policy = RING_BACKPRESSURE;
+	}
+
 	//Start up SDL and create window
 	if( !init() )
 	{
@@ -566,6 +335,11 @@ int main()
 		{
 			cout << "Failed to load media!\n" << endl;
 		}
+		//Start decoding
+		else if( !gDataStream.start( policy ) )
+		{
+			cout << "Failed to start decoding!\n" << endl;
+		}
 		else
 		{
 			//Main loop flag
@@ -574,6 +348,13 @@ int main()
 			//Event handler
 			SDL_Event e;
 
+			//Decoded frames
+			FrameRing* ring = gDataStream.getRing();
+
+			//Bytes sent to the texture against whole frame copies
+			double uploadedBytes = 0;
+			int uploads = 0;
+
 			//While application is running
 			while( !quit )
 			{
@@ -592,10 +373,19 @@ int main()
 				SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
 				SDL_RenderClear( gRenderer );
 
-				//Copy frame from buffer
-				gStreamingTexture.lockTexture();
-				gStreamingTexture.copyPixels ( gDataStream.getBuffer() );
-				gStreamingTexture.unlockTexture();
+				//Upload the parts of the newest decoded frame that changed, if one finished since the last upload, or all of it in one copy when most of it did
+				void* frame = ring->beginRead();
+				if( frame != NULL )
+				{
+					int count = gDirtyTracker.diffOrWhole( frame, STREAM_WIDTH * 4 );
+					if( count > 0 )
+					{
+						gStreamingTexture.copyRects( frame, STREAM_WIDTH * 4, &gDirtyTracker.getRects()[ 0 ], count );
+					}
+					uploadedBytes += gDirtyTracker.getDirtyBytes();
+					++uploads;
+					ring->endRead();
+				}
 
 				//Redner frame
 				gStreamingTexture.render( ( SCREEN_WIDTH - gStreamingTexture.getWidth() ) / 2, ( SCREEN_HEIGHT - gStreamingTexture.getHeight() ) / 2 );
@@ -603,6 +393,14 @@ int main()
 				//Update screen
 				SDL_RenderPresent( gRenderer );
 			}
+
+			//Report how the stream kept up
+			cout << ring->getWrittenCount() << " frames decoded, " << ring->getReadCount() << " uploaded, " << ring->getDroppedCount() << " dropped, " << ring->getStallCount() << " decoder stalls" << endl;
+			cout << "Upload latency mean " << ring->getMeanLatency() * 1000.0 << " ms, max " << ring->getMaxLatency() * 1000.0 << " ms" << endl;
+			if( uploads > 0 )
+			{
+				cout << uploadedBytes / uploads << " bytes uploaded per frame of " << STREAM_WIDTH * STREAM_HEIGHT * 4 << endl;
+			}
 		}
 	}
 
@@ -0,0 +1,316 @@
+#include "AssetManager.h"
+#include "TextureCache.h"
+#include <iostream>
+
+using namespace std;
+
+AssetManager::AssetManager( SDL_Renderer* renderer, int threads )
+{
+	//Initialize
+	mRenderer = renderer;
+	mPending = 0;
+	mQuit = false;
+	mLock = SDL_CreateMutex();
+	mWork = SDL_CreateCond();
+
+	//Start decoders
+	if( threads < 1 )
+	{
+		threads = 1;
+	}
+	for( int i = 0; i < threads; ++i )
+	{
+		SDL_Thread* thread = SDL_CreateThread( decodeMain, "AssetDecoder", this );
+		if( thread == NULL )
+		{
+			cout << "Unable to create asset decoder! SDL Error: " << SDL_GetError() << endl;
+			break;
+		}
+		mThreads.push_back( thread );
+	}
+}
+
+AssetManager::~AssetManager()
+{
+	//Wake decoders so they see the quit flag
+	SDL_LockMutex( mLock );
+	mQuit = true;
+	SDL_CondBroadcast( mWork );
+	SDL_UnlockMutex( mLock );
+
+	//Wait for decoders to finish
+	for( int i = 0; i < (int)mThreads.size(); ++i )
+	{
+		SDL_WaitThread( mThreads[ i ], NULL );
+	}
+	mThreads.clear();
+
+	//Let go of everything still held
+	for( int i = 0; i < (int)mAssets.size(); ++i )
+	{
+		dropAsset( i );
+	}
+
+	SDL_DestroyCond( mWork );
+	SDL_DestroyMutex( mLock );
+}
+
+AssetHandle AssetManager::request( string path )
+{
+	SDL_LockMutex( mLock );
+
+	int index = 0;
+	map< string, int >::iterator found = mIndices.find( path );
+	if( found != mIndices.end() )
+	{
+		index = found->second;
+		Asset& asset = mAssets[ index ];
+
+		//Released earlier, start over
+		if( asset.state == ASSET_RELEASED )
+		{
+			asset.state = ASSET_QUEUED;
+			asset.references = 1;
+			mDecodeQueue.push_back( index );
+			++mPending;
+			SDL_CondSignal( mWork );
+		}
+		//Already on its way or loaded
+		else
+		{
+			++asset.references;
+		}
+	}
+	else
+	{
+		//New image
+		Asset asset = { path, ASSET_QUEUED, 1, NULL };
+		index = (int)mAssets.size();
+		mAssets.push_back( asset );
+		mIndices[ path ] = index;
+		mDecodeQueue.push_back( index );
+		++mPending;
+		SDL_CondSignal( mWork );
+	}
+
+	SDL_UnlockMutex( mLock );
+
+	return index + 1;
+}
+
+void AssetManager::retain( AssetHandle handle )
+{
+	SDL_LockMutex( mLock );
+	if( handle > 0 && handle <= (int)mAssets.size() && mAssets[ handle - 1 ].state != ASSET_RELEASED )
+	{
+		++mAssets[ handle - 1 ].references;
+	}
+	SDL_UnlockMutex( mLock );
+}
+
+void AssetManager::release( AssetHandle handle )
+{
+	SDL_LockMutex( mLock );
+	if( handle > 0 && handle <= (int)mAssets.size() && mAssets[ handle - 1 ].state != ASSET_RELEASED )
+	{
+		//Last reference gone
+		if( --mAssets[ handle - 1 ].references == 0 )
+		{
+			dropAsset( handle - 1 );
+		}
+	}
+	SDL_UnlockMutex( mLock );
+}
+
+int AssetManager::upload( int maxUploads )
+{
+	int uploaded = 0;
+
+	SDL_LockMutex( mLock );
+
+	//No decoder could be started, so requests are decoded here or they would never be serviced
+	while( mThreads.empty() && (int)mUploadQueue.size() < maxUploads && !mDecodeQueue.empty() )
+	{
+		decodeNext();
+	}
+
+	while( uploaded < maxUploads && !mUploadQueue.empty() )
+	{
+		int index = mUploadQueue.front();
+		mUploadQueue.pop_front();
+
+		//Released while it waited
+		Asset& asset = mAssets[ index ];
+		if( asset.state != ASSET_DECODED )
+		{
+			continue;
+		}
+
+		//Hand the pixels to the texture cache, which keeps this asset's reference
+		int width = 0;
+		int height = 0;
+		if( TextureCache::getInstance().adopt( mRenderer, asset.path, asset.surface, width, height ) != NULL )
+		{
+			asset.state = ASSET_READY;
+		}
+		else
+		{
+			asset.state = ASSET_FAILED;
+		}
+
+		//Get rid of decoded surface
+		SDL_FreeSurface( asset.surface );
+		asset.surface = NULL;
+		--mPending;
+		++uploaded;
+	}
+	SDL_UnlockMutex( mLock );
+
+	return uploaded;
+}
+
+AssetManager::AssetState AssetManager::getState( AssetHandle handle )
+{
+	AssetState state = ASSET_FAILED;
+
+	SDL_LockMutex( mLock );
+	if( handle > 0 && handle <= (int)mAssets.size() )
+	{
+		state = mAssets[ handle - 1 ].state;
+	}
+	SDL_UnlockMutex( mLock );
+
+	return state;
+}
+
+bool AssetManager::isReady( AssetHandle handle )
+{
+	return getState( handle ) == ASSET_READY;
+}
+
+bool AssetManager::hasFailed( AssetHandle handle )
+{
+	return getState( handle ) == ASSET_FAILED;
+}
+
+string AssetManager::getPath( AssetHandle handle )
+{
+	string path;
+
+	SDL_LockMutex( mLock );
+	if( handle > 0 && handle <= (int)mAssets.size() )
+	{
+		path = mAssets[ handle - 1 ].path;
+	}
+	SDL_UnlockMutex( mLock );
+
+	return path;
+}
+
+int AssetManager::getPendingCount()
+{
+	SDL_LockMutex( mLock );
+	int pending = mPending;
+	SDL_UnlockMutex( mLock );
+
+	return pending;
+}
+
+bool AssetManager::isIdle()
+{
+	return getPendingCount() == 0;
+}
+
+int AssetManager::decodeMain( void* data )
+{
+	AssetManager* manager = (AssetManager*)data;
+
+	SDL_LockMutex( manager->mLock );
+	while( true )
+	{
+		//Sleep until there is work or we are told to quit
+		while( manager->mDecodeQueue.empty() && !manager->mQuit )
+		{
+			SDL_CondWait( manager->mWork, manager->mLock );
+		}
+		if( manager->mQuit )
+		{
+			break;
+		}
+
+		manager->decodeNext();
+	}
+	SDL_UnlockMutex( manager->mLock );
+
+	return 0;
+}
+
+void AssetManager::decodeNext()
+{
+	//Skip requests released before we got to them
+	int index = mDecodeQueue.front();
+	mDecodeQueue.pop_front();
+	if( mAssets[ index ].state != ASSET_QUEUED )
+	{
+		return;
+	}
+	string path = mAssets[ index ].path;
+
+	//Decode without holding the lock
+	SDL_UnlockMutex( mLock );
+	SDL_Surface* surface = TextureCache::decode( path );
+	SDL_LockMutex( mLock );
+
+	//Released or already decoded by another thread in the meantime
+	Asset& asset = mAssets[ index ];
+	if( asset.state != ASSET_QUEUED )
+	{
+		if( surface != NULL )
+		{
+			SDL_FreeSurface( surface );
+		}
+	}
+	else if( surface == NULL )
+	{
+		asset.state = ASSET_FAILED;
+		--mPending;
+	}
+	//Wait for the render thread
+	else
+	{
+		asset.surface = surface;
+		asset.state = ASSET_DECODED;
+		mUploadQueue.push_back( index );
+	}
+}
+
+void AssetManager::dropAsset( int index )
+{
+	Asset& asset = mAssets[ index ];
+
+	switch( asset.state )
+	{
+		//Still on its way
+		case ASSET_QUEUED:
+			--mPending;
+			break;
+
+		//Decoded but never uploaded
+		case ASSET_DECODED:
+			SDL_FreeSurface( asset.surface );
+			asset.surface = NULL;
+			--mPending;
+			break;
+
+		//Give back the texture cache reference
+		case ASSET_READY:
+			TextureCache::getInstance().release( asset.path );
+			break;
+
+		default:
+			break;
+	}
+
+	asset.state = ASSET_RELEASED;
+	asset.references = 0;
+}
@@ -0,0 +1,103 @@
+#ifndef ASSET_MANAGER_H
+#define ASSET_MANAGER_H
+
+#include <SDL2/SDL.h>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+//Identifies a requested image, 0 is never a valid handle
+typedef int AssetHandle;
+
+//Decodes images on worker threads and uploads them into the texture cache in bounded batches,
+//every public function belongs to the render thread
+class AssetManager
+{
+	public:
+		//Where an image is in the pipeline
+		enum AssetState
+		{
+			ASSET_QUEUED,
+			ASSET_DECODED,
+			ASSET_READY,
+			ASSET_FAILED,
+			ASSET_RELEASED
+		};
+
+		//Starts the decoder threads, if none can be started upload decodes on the render thread instead
+		AssetManager( SDL_Renderer* renderer, int threads = 2 );
+
+		//Stops decoders and drops every image still held
+		~AssetManager();
+
+		//Queues the image at path for decoding, requesting the same path again shares the handle
+		AssetHandle request( std::string path );
+
+		//Adds and drops a reference to a handle, the image is let go with the last one
+		void retain( AssetHandle handle );
+		void release( AssetHandle handle );
+
+		//Uploads at most maxUploads decoded images, call once a frame from the render thread
+		//Without decoder threads it first decodes up to maxUploads queued images itself
+		int upload( int maxUploads );
+
+		//Handle state, once ready LTexture::loadFromFile on the path is a cache hit
+		AssetState getState( AssetHandle handle );
+		bool isReady( AssetHandle handle );
+		bool hasFailed( AssetHandle handle );
+		std::string getPath( AssetHandle handle );
+
+		//Requests still waiting to be decoded or uploaded
+		int getPendingCount();
+
+		//True when nothing is left to decode or upload
+		bool isIdle();
+
+	private:
+		//One requested image
+		struct Asset
+		{
+			std::string path;
+			AssetState state;
+			int references;
+			SDL_Surface* surface;
+		};
+
+		//Manager is not copyable
+		AssetManager( const AssetManager& );
+		AssetManager& operator=( const AssetManager& );
+
+		//Decoder thread entry point
+		static int decodeMain( void* data );
+
+		//Decodes the first queued request, lock must be held and is let go while decoding
+		void decodeNext();
+
+		//Drops the texture or surface an asset holds, lock must be held
+		void dropAsset( int index );
+
+		//Renderer the textures are uploaded to
+		SDL_Renderer* mRenderer;
+
+		//Every image ever requested, indexed by handle - 1
+		std::vector< Asset > mAssets;
+		std::map< std::string, int > mIndices;
+
+		//Asset indices waiting for a decoder and for the render thread
+		std::deque< int > mDecodeQueue;
+		std::deque< int > mUploadQueue;
+
+		//Requests not yet ready or failed
+		int mPending;
+
+		//Guards everything above against the decoders
+		SDL_mutex* mLock;
+		SDL_cond* mWork;
+		bool mQuit;
+
+		//Decoder threads
+		std::vector< SDL_Thread* > mThreads;
+};
+
+#endif
@@ -0,0 +1,150 @@
+#include "AtlasPacker.h"
+
+AtlasPacker::AtlasPacker( int width, int padding )
+{
+	//Initialize
+	mWidth = width;
+	mPadding = padding;
+	reset();
+}
+
+bool AtlasPacker::insert( int width, int height, SDL_Rect& placed )
+{
+	//Padding travels with the rectangle
+	int paddedWidth = width + mPadding;
+	int paddedHeight = height + mPadding;
+
+	//Lowest resting spot, ties go to the narrowest node so gaps fill first
+	int bestIndex = -1;
+	int bestTop = 0;
+	int bestNodeWidth = 0;
+	for( int i = 0; i < (int)mSkyline.size(); ++i )
+	{
+		int y = fit( i, paddedWidth );
+		if( y < 0 )
+		{
+			continue;
+		}
+
+		int top = y + paddedHeight;
+		if( bestIndex < 0 || top < bestTop || ( top == bestTop && mSkyline[ i ].width < bestNodeWidth ) )
+		{
+			bestIndex = i;
+			bestTop = top;
+			bestNodeWidth = mSkyline[ i ].width;
+		}
+	}
+
+	//Wider than the sheet
+	if( bestIndex < 0 )
+	{
+		return false;
+	}
+
+	placed.x = mSkyline[ bestIndex ].x;
+	placed.y = bestTop - paddedHeight;
+	placed.w = width;
+	placed.h = height;
+
+	//Raise the skyline over the new rectangle
+	SkylineNode node = { placed.x, bestTop, paddedWidth };
+	mSkyline.insert( mSkyline.begin() + bestIndex, node );
+
+	//Trim or drop the nodes it now covers
+	for( int i = bestIndex + 1; i < (int)mSkyline.size(); )
+	{
+		int covered = node.x + node.width - mSkyline[ i ].x;
+		if( covered <= 0 )
+		{
+			break;
+		}
+
+		if( covered >= mSkyline[ i ].width )
+		{
+			mSkyline.erase( mSkyline.begin() + i );
+		}
+		else
+		{
+			mSkyline[ i ].x += covered;
+			mSkyline[ i ].width -= covered;
+			break;
+		}
+	}
+
+	//Merge neighbours at the same height
+	for( int i = 0; i + 1 < (int)mSkyline.size(); )
+	{
+		if( mSkyline[ i ].y == mSkyline[ i + 1 ].y )
+		{
+			mSkyline[ i ].width += mSkyline[ i + 1 ].width;
+			mSkyline.erase( mSkyline.begin() + i + 1 );
+		}
+		else
+		{
+			++i;
+		}
+	}
+
+	//Grow the sheet
+	if( placed.y + height > mHeight )
+	{
+		mHeight = placed.y + height;
+	}
+	mUsedArea += width * height;
+
+	return true;
+}
+
+void AtlasPacker::reset()
+{
+	//One flat node across the whole sheet
+	mSkyline.clear();
+	SkylineNode floor = { 0, 0, mWidth };
+	mSkyline.push_back( floor );
+	mHeight = 0;
+	mUsedArea = 0;
+}
+
+int AtlasPacker::getWidth()
+{
+	return mWidth;
+}
+
+int AtlasPacker::getHeight()
+{
+	return mHeight;
+}
+
+float AtlasPacker::getOccupancy()
+{
+	if( mHeight == 0 )
+	{
+		return 0.f;
+	}
+
+	return (float)mUsedArea / ( (float)mWidth * mHeight );
+}
+
+int AtlasPacker::fit( int index, int width )
+{
+	//Would stick out of the right edge, the last column is allowed to drop its padding
+	int x = mSkyline[ index ].x;
+	if( x + width - mPadding > mWidth )
+	{
+		return -1;
+	}
+
+	//Rest on the highest node underneath
+	int y = 0;
+	int remaining = width;
+	for( int i = index; remaining > 0 && i < (int)mSkyline.size(); ++i )
+	{
+		if( mSkyline[ i ].y > y )
+		{
+			y = mSkyline[ i ].y;
+		}
+		remaining -= mSkyline[ i ].width;
+	}
+
+	return y;
+}
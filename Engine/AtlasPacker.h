@@ -0,0 +1,51 @@
+#ifndef ATLAS_PACKER_H
+#define ATLAS_PACKER_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+//Skyline bottom-left rectangle packer for a fixed width sheet that grows downwards
+class AtlasPacker
+{
+	public:
+		//Starts an empty sheet, padding is left right of and below every rectangle
+		AtlasPacker( int width, int padding = 1 );
+
+		//Finds room for a width by height rectangle, returns false if it is wider than the sheet
+		bool insert( int width, int height, SDL_Rect& placed );
+
+		//Empties the sheet
+		void reset();
+
+		//Sheet dimensions, the height covers every placed rectangle
+		int getWidth();
+		int getHeight();
+
+		//Fraction of the sheet covered by rectangles
+		float getOccupancy();
+
+	private:
+		//Top edge of the packed area over [x, x + width)
+		struct SkylineNode
+		{
+			int x;
+			int y;
+			int width;
+		};
+
+		//Lowest top edge a rectangle at node index would rest on, -1 if it does not fit
+		int fit( int index, int width );
+
+		//Sheet width and padding
+		int mWidth;
+		int mPadding;
+
+		//Skyline from left to right
+		std::vector< SkylineNode > mSkyline;
+
+		//Packed height and area
+		int mHeight;
+		int mUsedArea;
+};
+
+#endif
@@ -0,0 +1,48 @@
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+#include <iostream>
+#include "TextureAtlas.h"
+
+using namespace std;
+
+//Packs images into name.bmp and name.atlas for TextureAtlas::loadFromFile
+int main( int argc, char* args[] )
+{
+	if( argc < 3 )
+	{
+		cout << "Usage: atlas_pack name image..." << endl;
+		return 1;
+	}
+
+	string name = args[ 1 ];
+	vector< string > paths;
+	for( int i = 2; i < argc; ++i )
+	{
+		paths.push_back( args[ i ] );
+	}
+
+	//Pack sheet
+	vector< AtlasRegion > regions;
+	SDL_Surface* sheet = TextureAtlas::pack( &paths[ 0 ], (int)paths.size(), regions );
+	if( sheet == NULL )
+	{
+		cout << "Failed to pack atlas!" << endl;
+		return 1;
+	}
+
+	//Write sheet and clip table
+	bool saved = TextureAtlas::save( sheet, regions, name + ".bmp", name + ".atlas" );
+	if( saved )
+	{
+		cout << name << ".bmp: " << sheet->w << "x" << sheet->h << ", " << regions.size() << " images" << endl;
+		for( int i = 0; i < (int)regions.size(); ++i )
+		{
+			SDL_Rect& clip = regions[ i ].clip;
+			cout << "  " << regions[ i ].path << " " << clip.x << " " << clip.y << " " << clip.w << " " << clip.h << endl;
+		}
+	}
+	SDL_FreeSurface( sheet );
+
+	return saved ? 0 : 1;
+}
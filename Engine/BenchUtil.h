@@ -0,0 +1,21 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <SDL2/SDL.h>
+
+//Next value of a xorshift stream
+inline Uint32 nextRandom( Uint32& state )
+{
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return state;
+}
+
+//Seconds since start
+inline double getSeconds( Uint64 start )
+{
+	return (double)( SDL_GetPerformanceCounter() - start ) / SDL_GetPerformanceFrequency();
+}
+
+#endif
@@ -0,0 +1,181 @@
+#include "CollisionMask.h"
+#include <iostream>
+
+using namespace std;
+
+CollisionMask::CollisionMask()
+{
+	//Initialize
+	mWordsPerRow = 0;
+	mWidth = 0;
+	mHeight = 0;
+	mBounds.x = 0;
+	mBounds.y = 0;
+	mBounds.w = 0;
+	mBounds.h = 0;
+}
+
+bool CollisionMask::build( SDL_Surface* surface, Uint8 threshold )
+{
+	//Get rid of preexisting mask
+	free();
+
+	//Color key as it looks once converted
+	Uint32 colorKey = 0;
+	bool keyed = SDL_GetColorKey( surface, &colorKey ) == 0;
+	Uint8 keyRed = 0, keyGreen = 0, keyBlue = 0;
+	if( keyed )
+	{
+		SDL_GetRGB( colorKey, surface->format, &keyRed, &keyGreen, &keyBlue );
+	}
+
+	//Read every pixel the same way whatever format the image came in
+	SDL_Surface* formattedSurface = SDL_ConvertSurfaceFormat( surface, SDL_PIXELFORMAT_RGBA8888, 0 );
+	if( formattedSurface == NULL )
+	{
+		cout << "Unable to convert surface for collision mask! SDL Error: " << SDL_GetError() << endl;
+		return false;
+	}
+
+	mWidth = formattedSurface->w;
+	mHeight = formattedSurface->h;
+	mWordsPerRow = ( mWidth + 63 ) / 64;
+	mBits.assign( mWordsPerRow * mHeight, 0 );
+
+	//Solid bounds grow as pixels turn up
+	int left = mWidth, right = 0;
+	int top = mHeight, bottom = 0;
+
+	SDL_LockSurface( formattedSurface );
+	for( int y = 0; y < mHeight; ++y )
+	{
+		//Rows may be padded past the width
+		Uint32* pixels = (Uint32*)( (Uint8*)formattedSurface->pixels + y * formattedSurface->pitch );
+		Uint64* row = &mBits[ y * mWordsPerRow ];
+		for( int x = 0; x < mWidth; ++x )
+		{
+			Uint8 r, g, b, a;
+			SDL_GetRGBA( pixels[ x ], formattedSurface->format, &r, &g, &b, &a );
+			if( a <= threshold || ( keyed && r == keyRed && g == keyGreen && b == keyBlue ) )
+			{
+				continue;
+			}
+
+			row[ x / 64 ] |= (Uint64)1 << ( x % 64 );
+			left = x < left ? x : left;
+			right = x + 1 > right ? x + 1 : right;
+			top = y < top ? y : top;
+			bottom = y + 1;
+		}
+	}
+	SDL_UnlockSurface( formattedSurface );
+
+	//Get rid of formatted surface
+	SDL_FreeSurface( formattedSurface );
+
+	if( left < right )
+	{
+		mBounds.x = left;
+		mBounds.y = top;
+		mBounds.w = right - left;
+		mBounds.h = bottom - top;
+	}
+
+	return true;
+}
+
+void CollisionMask::free()
+{
+	mBits.clear();
+	mWordsPerRow = 0;
+	mWidth = 0;
+	mHeight = 0;
+	mBounds.x = 0;
+	mBounds.y = 0;
+	mBounds.w = 0;
+	mBounds.h = 0;
+}
+
+bool CollisionMask::collides( int x, int y, CollisionMask& other, int otherX, int otherY )
+{
+	//Overlap of the solid bounds on screen
+	int left = x + mBounds.x > otherX + other.mBounds.x ? x + mBounds.x : otherX + other.mBounds.x;
+	int top = y + mBounds.y > otherY + other.mBounds.y ? y + mBounds.y : otherY + other.mBounds.y;
+	int right = x + mBounds.x + mBounds.w < otherX + other.mBounds.x + other.mBounds.w ? x + mBounds.x + mBounds.w : otherX + other.mBounds.x + other.mBounds.w;
+	int bottom = y + mBounds.y + mBounds.h < otherY + other.mBounds.y + other.mBounds.h ? y + mBounds.y + mBounds.h : otherY + other.mBounds.y + other.mBounds.h;
+
+	//Masks whose solid pixels are apart cannot touch
+	if( left >= right || top >= bottom )
+	{
+		return false;
+	}
+
+	//Words of this mask covering the overlap, solid pixels outside it have nothing solid under them
+	int firstWord = ( left - x ) / 64;
+	int lastWord = ( right - 1 - x ) / 64;
+	for( int screenY = top; screenY < bottom; ++screenY )
+	{
+		const Uint64* row = &mBits[ ( screenY - y ) * mWordsPerRow ];
+		for( int word = firstWord; word <= lastWord; ++word )
+		{
+			//64 pixels at once against the other mask's pixels under them
+			if( row[ word ] != 0 && ( row[ word ] & other.getBits( screenY - otherY, word * 64 + x - otherX ) ) != 0 )
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+bool CollisionMask::isSolid( int x, int y )
+{
+	if( x < 0 || y < 0 || x >= mWidth || y >= mHeight )
+	{
+		return false;
+	}
+
+	return ( mBits[ y * mWordsPerRow + x / 64 ] >> ( x % 64 ) & 1 ) != 0;
+}
+
+SDL_Rect CollisionMask::getBounds()
+{
+	return mBounds;
+}
+
+int CollisionMask::getWidth()
+{
+	return mWidth;
+}
+
+int CollisionMask::getHeight()
+{
+	return mHeight;
+}
+
+Uint64 CollisionMask::getBits( int row, int column )
+{
+	if( row < 0 || row >= mHeight )
+	{
+		return 0;
+	}
+
+	//Word holding the first pixel, rounding down for columns left of the mask
+	int word = column >= 0 ? column / 64 : -( ( -column + 63 ) / 64 );
+	int shift = column - word * 64;
+	const Uint64* bits = &mBits[ row * mWordsPerRow ];
+
+	//Low part from the first word, high part from the next one
+	Uint64 result = 0;
+	if( word >= 0 && word < mWordsPerRow )
+	{
+		result = bits[ word ] >> shift;
+	}
+	if( shift != 0 && word + 1 >= 0 && word + 1 < mWordsPerRow )
+	{
+		result |= bits[ word + 1 ] << ( 64 - shift );
+	}
+
+	return result;
+}
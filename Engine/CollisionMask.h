@@ -0,0 +1,49 @@
+#ifndef COLLISION_MASK_H
+#define COLLISION_MASK_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+//One bit per pixel of an image, set where the image is solid
+class CollisionMask
+{
+	public:
+		//Initializes an empty mask
+		CollisionMask();
+
+		//Marks pixels that are not color keyed and have alpha above threshold as solid
+		bool build( SDL_Surface* surface, Uint8 threshold = 0 );
+
+		//Empties the mask
+		void free();
+
+		//Whether any solid pixel of this mask placed at x, y lands on a solid pixel of other placed at otherX, otherY
+		bool collides( int x, int y, CollisionMask& other, int otherX, int otherY );
+
+		//Whether the pixel is solid, pixels outside the mask are not
+		bool isSolid( int x, int y );
+
+		//Gets the box around every solid pixel, empty if there are none
+		SDL_Rect getBounds();
+
+		//Gets mask dimensions
+		int getWidth();
+		int getHeight();
+
+	private:
+		//64 pixels of a row starting at any column, pixels outside the mask read as clear
+		Uint64 getBits( int row, int column );
+
+		//Rows of 64 bit words, the lowest bit of a word is its leftmost pixel
+		std::vector<Uint64> mBits;
+		int mWordsPerRow;
+
+		//Mask dimensions
+		int mWidth;
+		int mHeight;
+
+		//Box around every solid pixel
+		SDL_Rect mBounds;
+};
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef CPU_DISPATCH_H
+#define CPU_DISPATCH_H
+
+#include <SDL2/SDL.h>
+
+//x86 builds get vector kernels, everything else runs scalar, kernel files include immintrin.h under this
+#if defined( __x86_64__ ) || defined( __i386__ ) || defined( _M_X64 ) || defined( _M_IX86 )
+#define CPU_HAS_X86
+#endif
+
+//Lets SSE2 and AVX2 kernels compile without building the whole file for them
+#if defined( __GNUC__ ) || defined( __clang__ )
+#define CPU_TARGET_SSE2 __attribute__(( target( "sse2" ) ))
+#define CPU_TARGET_AVX2 __attribute__(( target( "avx2" ) ))
+#else
+#define CPU_TARGET_SSE2
+#define CPU_TARGET_AVX2
+#endif
+
+//Instruction sets a kernel can run on, every kernel enum takes its values from these
+enum CpuLevel
+{
+	CPU_SCALAR,
+	CPU_SSE2,
+	CPU_AVX2,
+	TOTAL_CPU_LEVELS
+};
+
+//Checks whether the level can run on this machine
+inline bool isCpuLevelSupported( int level )
+{
+	switch( level )
+	{
+		case CPU_SCALAR: return true;
+		#ifdef CPU_HAS_X86
+		case CPU_SSE2: return SDL_HasSSE2() == SDL_TRUE;
+		case CPU_AVX2: return SDL_HasAVX2() == SDL_TRUE;
+		#endif
+		default: return false;
+	}
+}
+
+//Picks the widest supported level
+inline int getBestCpuLevel()
+{
+	if( isCpuLevelSupported( CPU_AVX2 ) )
+	{
+		return CPU_AVX2;
+	}
+	if( isCpuLevelSupported( CPU_SSE2 ) )
+	{
+		return CPU_SSE2;
+	}
+	return CPU_SCALAR;
+}
+
+//Gets level display name
+inline const char* getCpuLevelName( int level )
+{
+	switch( level )
+	{
+		case CPU_SCALAR: return "scalar";
+		case CPU_SSE2: return "sse2";
+		case CPU_AVX2: return "avx2";
+		default: return "unknown";
+	}
+}
+
+//Unsupported levels run scalar rather than fault
+inline int getRunnableCpuLevel( int level )
+{
+	return isCpuLevelSupported( level ) ? level : CPU_SCALAR;
+}
+
+#endif
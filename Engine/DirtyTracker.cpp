@@ -0,0 +1,180 @@
+#include "DirtyTracker.h"
+#include <string.h>
+
+DirtyTracker::DirtyTracker( int width, int height, int tileSize )
+{
+	//Initialize
+	mWidth = width > 0 ? width : 0;
+	mHeight = height > 0 ? height : 0;
+	mTileSize = tileSize > 0 ? tileSize : 32;
+	mTilesX = ( mWidth + mTileSize - 1 ) / mTileSize;
+	mTilesY = ( mHeight + mTileSize - 1 ) / mTileSize;
+	mLast.assign( (size_t)mWidth * mHeight * 4, 0 );
+	mInvalid = true;
+	mWholeFrames = 0;
+	mDirtyBytes = 0;
+}
+
+int DirtyTracker::diff( const void* pixels, int pitch )
+{
+	mRects.clear();
+	mOpen.clear();
+	mDirtyBytes = 0;
+
+	const Uint8* bytes = (const Uint8*)pixels;
+	int rowBytes = mWidth * 4;
+	int tileBytes = mTileSize * 4;
+	for( int tileY = 0; tileY < mTilesY; ++tileY )
+	{
+		int top = tileY * mTileSize;
+		int height = top + mTileSize > mHeight ? mHeight - top : mTileSize;
+
+		//Find the changed tiles of this row, everything is changed after an invalidate
+		mDirty.assign( mTilesX, mInvalid ? 1 : 0 );
+		int dirtyCount = mInvalid ? mTilesX : 0;
+		for( int y = top; y < top + height; ++y )
+		{
+			const Uint8* row = bytes + (size_t)y * pitch;
+			Uint8* last = &mLast[ (size_t)y * rowBytes ];
+
+			//Unchanged rows are skipped with one compare, memcmp is already vectorized by the C library
+			if( dirtyCount < mTilesX && memcmp( row, last, rowBytes ) != 0 )
+			{
+				for( int tileX = 0; tileX < mTilesX; ++tileX )
+				{
+					int left = tileX * tileBytes;
+					int width = left + tileBytes > rowBytes ? rowBytes - left : tileBytes;
+					if( !mDirty[ tileX ] && memcmp( row + left, last + left, width ) != 0 )
+					{
+						mDirty[ tileX ] = 1;
+						++dirtyCount;
+					}
+				}
+			}
+
+			//Keep the row for the next frame, once every tile is known to be changed only copying is left
+			if( dirtyCount > 0 )
+			{
+				memcpy( last, row, rowBytes );
+			}
+		}
+
+		//Merge runs of changed tiles along the row
+		mNextOpen.clear();
+		int tileX = 0;
+		while( tileX < mTilesX )
+		{
+			if( !mDirty[ tileX ] )
+			{
+				++tileX;
+				continue;
+			}
+			int first = tileX;
+			while( tileX < mTilesX && mDirty[ tileX ] )
+			{
+				++tileX;
+			}
+			int left = first * mTileSize;
+			int right = tileX * mTileSize > mWidth ? mWidth : tileX * mTileSize;
+
+			//Grow the rectangle above if it spans exactly the same columns, otherwise start a new one
+			int grown = -1;
+			for( int i = 0; i < (int)mOpen.size(); ++i )
+			{
+				SDL_Rect& above = mRects[ mOpen[ i ] ];
+				if( above.x == left && above.w == right - left )
+				{
+					grown = mOpen[ i ];
+					above.h += height;
+					break;
+				}
+			}
+			if( grown < 0 )
+			{
+				SDL_Rect rect = { left, top, right - left, height };
+				grown = (int)mRects.size();
+				mRects.push_back( rect );
+			}
+			mNextOpen.push_back( grown );
+			mDirtyBytes += ( right - left ) * height * 4;
+		}
+
+		mOpen.swap( mNextOpen );
+	}
+
+	mInvalid = false;
+	return (int)mRects.size();
+}
+
+int DirtyTracker::diffOrWhole( const void* pixels, int pitch, int wholePercent, int holdFrames )
+{
+	//Held frames skip comparing entirely
+	if( mWholeFrames > 1 )
+	{
+		--mWholeFrames;
+		return reportWhole();
+	}
+
+	//A diff after an invalidate is all changed without saying anything about the content
+	bool invalid = mInvalid;
+	int count = diff( pixels, pitch );
+
+	//The last held frame is compared only to bring the copy the next diff uses up to date
+	if( mWholeFrames == 1 )
+	{
+		mWholeFrames = 0;
+		return reportWhole();
+	}
+
+	//Mostly changed frames are cheaper to send whole, and likely to be followed by more of them
+	if( !invalid && (Sint64)mDirtyBytes * 100 > (Sint64)mWidth * mHeight * 4 * wholePercent )
+	{
+		mWholeFrames = holdFrames;
+		return reportWhole();
+	}
+
+	return count;
+}
+
+const std::vector< SDL_Rect >& DirtyTracker::getRects()
+{
+	return mRects;
+}
+
+int DirtyTracker::getDirtyBytes()
+{
+	return mDirtyBytes;
+}
+
+void DirtyTracker::invalidate()
+{
+	mInvalid = true;
+}
+
+int DirtyTracker::reportWhole()
+{
+	mRects.clear();
+	mDirtyBytes = 0;
+	if( mWidth > 0 && mHeight > 0 )
+	{
+		SDL_Rect whole = { 0, 0, mWidth, mHeight };
+		mRects.push_back( whole );
+		mDirtyBytes = mWidth * mHeight * 4;
+	}
+	return (int)mRects.size();
+}
+
+int DirtyTracker::getWidth()
+{
+	return mWidth;
+}
+
+int DirtyTracker::getHeight()
+{
+	return mHeight;
+}
+
+int DirtyTracker::getTileSize()
+{
+	return mTileSize;
+}
@@ -0,0 +1,68 @@
+#ifndef DIRTY_TRACKER_H
+#define DIRTY_TRACKER_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+//Finds the parts of a streamed frame that changed since the last one, tile by tile
+//Changed tiles are merged into as few rectangles as simple row runs allow, so only those need uploading
+class DirtyTracker
+{
+	public:
+		//Tracks frames of width by height 32 bit pixels in tileSize square tiles
+		DirtyTracker( int width, int height, int tileSize = 32 );
+
+		//Compares a frame against the last one and returns how many rectangles changed, the first frame is all changed
+		int diff( const void* pixels, int pitch );
+
+		//Like diff, but once most of a frame changes the whole frame is reported as one rectangle for the next holdFrames frames without comparing them
+		//Fully dynamic content then costs one copy and one lock a frame instead of a full compare plus a lock per rectangle
+		int diffOrWhole( const void* pixels, int pitch, int wholePercent = 50, int holdFrames = 30 );
+
+		//Rectangles that changed in the last diff
+		const std::vector< SDL_Rect >& getRects();
+
+		//Bytes the last diff's rectangles cover
+		int getDirtyBytes();
+
+		//Makes the next diff report the whole frame
+		void invalidate();
+
+		//Frame and tile dimensions
+		int getWidth();
+		int getHeight();
+		int getTileSize();
+
+	private:
+		//Reports the whole frame as changed
+		int reportWhole();
+
+		//Frame dimensions
+		int mWidth;
+		int mHeight;
+
+		//Tile size and tile grid
+		int mTileSize;
+		int mTilesX;
+		int mTilesY;
+
+		//Copy of the last frame, tightly packed
+		std::vector< Uint8 > mLast;
+
+		//Whether the next diff reports everything
+		bool mInvalid;
+
+		//Frames diffOrWhole still reports whole before comparing again
+		int mWholeFrames;
+
+		//Changed flags of the tile row being compared
+		std::vector< Uint8 > mDirty;
+
+		//Changed rectangles, and which of them are still open to grow down a row
+		std::vector< SDL_Rect > mRects;
+		std::vector< int > mOpen;
+		std::vector< int > mNextOpen;
+		int mDirtyBytes;
+};
+
+#endif
@@ -0,0 +1,167 @@
+#include "FramePacer.h"
+#include <algorithm>
+#include <math.h>
+
+//Sleep overshoot assumed before any has been measured
+const Uint64 DEFAULT_SLEEP_SLACK = 2000000;
+
+//A frame later than this many periods gives up on catching up and starts a new schedule
+const Uint64 MAX_FRAMES_BEHIND = 2;
+
+FramePacer::FramePacer( double fps, int historySize ) : mTimer( TIMER_PERFORMANCE )
+{
+	//Initialize
+	mPeriod = 0;
+	mDeadline = 0;
+	mLastFrame = 0;
+	mSleepSlack = DEFAULT_SLEEP_SLACK;
+	mHistorySize = historySize > 0 ? historySize : 1;
+	mHistoryNext = 0;
+	mMissed = 0;
+	setTarget( fps );
+}
+
+void FramePacer::setTarget( double fps )
+{
+	//A rate of zero or less never waits
+	mPeriod = fps > 0 ? (Uint64)( 1000000000.0 / fps + 0.5 ) : 0;
+	mTimer.stop();
+}
+
+double FramePacer::getTarget()
+{
+	return mPeriod > 0 ? 1000000000.0 / mPeriod : 0;
+}
+
+void FramePacer::start()
+{
+	mTimer.start();
+	mLastFrame = 0;
+	mDeadline = mPeriod;
+}
+
+void FramePacer::wait()
+{
+	if( !mTimer.isStarted() )
+	{
+		start();
+	}
+
+	Uint64 now = mTimer.getNanoseconds();
+
+	//Unpaced frames have no deadline to meet or miss
+	if( mPeriod > 0 )
+	{
+		if( now < mDeadline )
+		{
+			//Sleep while the wait is safely longer than a sleep overshoots, then spin to the deadline
+			if( mDeadline - now > mSleepSlack )
+			{
+				sleep( mDeadline - now - mSleepSlack );
+			}
+			while( now < mDeadline )
+			{
+				now = mTimer.getNanoseconds();
+			}
+
+			//Next frame is due one period after this one was, so error from this wait is not carried over
+			mDeadline += mPeriod;
+		}
+		else
+		{
+			++mMissed;
+
+			//Slightly late frames keep the schedule so the next one makes up the time, far behind starts over
+			mDeadline += mPeriod;
+			if( now > mDeadline + mPeriod * MAX_FRAMES_BEHIND )
+			{
+				mDeadline = now + mPeriod;
+			}
+		}
+	}
+
+	//Record the frame
+	Uint64 frameTime = now - mLastFrame;
+	mLastFrame = now;
+	if( (int)mHistory.size() < mHistorySize )
+	{
+		mHistory.push_back( frameTime );
+	}
+	else
+	{
+		mHistory[ mHistoryNext ] = frameTime;
+	}
+	mHistoryNext = ( mHistoryNext + 1 ) % mHistorySize;
+}
+
+FramePacerStats FramePacer::getStats()
+{
+	FramePacerStats stats = { 0, 0, 0, 0, 0, 0, 0 };
+	stats.frames = (int)mHistory.size();
+	if( stats.frames == 0 )
+	{
+		return stats;
+	}
+
+	//Mean and variance in milliseconds
+	double total = 0;
+	for( int i = 0; i < stats.frames; ++i )
+	{
+		total += mHistory[ i ] / 1000000.0;
+	}
+	stats.mean = total / stats.frames;
+	stats.fps = stats.mean > 0 ? 1000.0 / stats.mean : 0;
+	for( int i = 0; i < stats.frames; ++i )
+	{
+		double difference = mHistory[ i ] / 1000000.0 - stats.mean;
+		stats.variance += difference * difference;
+	}
+	stats.variance /= stats.frames;
+	stats.deviation = sqrt( stats.variance );
+
+	//Nearest rank percentile from a sorted copy
+	std::vector< Uint64 > sorted( mHistory );
+	std::sort( sorted.begin(), sorted.end() );
+	int rank = (int)ceil( stats.frames * 0.99 ) - 1;
+	stats.p99 = sorted[ rank < 0 ? 0 : rank ] / 1000000.0;
+	stats.max = sorted.back() / 1000000.0;
+
+	return stats;
+}
+
+int FramePacer::getMissedCount()
+{
+	return mMissed;
+}
+
+void FramePacer::resetStats()
+{
+	mHistory.clear();
+	mHistoryNext = 0;
+	mMissed = 0;
+}
+
+void FramePacer::sleep( Uint64 nanoseconds )
+{
+	Uint32 milliseconds = (Uint32)( nanoseconds / 1000000 );
+	if( milliseconds == 0 )
+	{
+		return;
+	}
+
+	Uint64 before = mTimer.getNanoseconds();
+	SDL_Delay( milliseconds );
+	Uint64 slept = mTimer.getNanoseconds() - before;
+
+	//Jump up to a worse overshoot straight away, ease back down slowly when sleeps improve
+	Uint64 asked = (Uint64)milliseconds * 1000000;
+	Uint64 overshoot = slept > asked ? slept - asked : 0;
+	if( overshoot > mSleepSlack )
+	{
+		mSleepSlack = overshoot;
+	}
+	else
+	{
+		mSleepSlack -= ( mSleepSlack - overshoot ) / 16;
+	}
+}
@@ -0,0 +1,80 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+#include "LTimer.h"
+
+//Frame time spread over the frames a pacer has kept, in milliseconds
+struct FramePacerStats
+{
+	//Frames measured
+	int frames;
+
+	//Average frame time and frames per second
+	double mean;
+	double fps;
+
+	//Spread of the frame times
+	double variance;
+	double deviation;
+
+	//Slowest frame and the frame time 99 out of 100 frames beat
+	double max;
+	double p99;
+};
+
+//Holds frames to a target rate by sleeping most of the wait and spinning the rest on the performance counter
+//Frames are due on a fixed schedule, so a frame that ends late shortens the next wait instead of drifting
+class FramePacer
+{
+	public:
+		//Paces to fps frames per second, keeping the last historySize frame times for stats
+		FramePacer( double fps = 60, int historySize = 1024 );
+
+		//Changes the target rate, starting a new schedule
+		void setTarget( double fps );
+		double getTarget();
+
+		//Starts the schedule, the first frame is due one frame from now
+		void start();
+
+		//Waits until the current frame is due and records its time, starts the schedule if needed
+		void wait();
+
+		//Frame time stats over the kept frames
+		FramePacerStats getStats();
+
+		//Frames that ended too late to wait at all
+		int getMissedCount();
+
+		//Forgets kept frame times and misses
+		void resetStats();
+
+	private:
+		//Sleeps whole milliseconds, learning how far the sleep overshoots
+		void sleep( Uint64 nanoseconds );
+
+		//Run time of the pacer
+		LTimer mTimer;
+
+		//Nanoseconds per frame, and when the next frame is due
+		Uint64 mPeriod;
+		Uint64 mDeadline;
+
+		//When the last frame ended
+		Uint64 mLastFrame;
+
+		//How much longer than asked a sleep has been taking, spinning covers the last of the wait
+		Uint64 mSleepSlack;
+
+		//Recent frame times in nanoseconds, oldest overwritten first
+		std::vector< Uint64 > mHistory;
+		int mHistorySize;
+		int mHistoryNext;
+
+		//Frames that ended too late to wait at all
+		int mMissed;
+};
+
+#endif
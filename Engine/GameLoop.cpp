@@ -0,0 +1,92 @@
+#include "GameLoop.h"
+
+GameLoop::GameLoop( double stepsPerSecond, int maxStepsPerFrame ) : mTimer( TIMER_PERFORMANCE )
+{
+	//Initialize
+	mStep = 1.0 / ( stepsPerSecond > 0 ? stepsPerSecond : 60 );
+	mMaxSteps = maxStepsPerFrame > 0 ? maxStepsPerFrame : 1;
+	mAccumulator = 0;
+	mStepCount = 0;
+	mStepCounter = 0;
+	mDroppedFrames = 0;
+}
+
+void GameLoop::start()
+{
+	mTimer.start();
+	mAccumulator = 0;
+}
+
+int GameLoop::advance( StepFunction step, void* data )
+{
+	if( !mTimer.isStarted() )
+	{
+		start();
+	}
+
+	//Real time since the last advance
+	return advance( mTimer.lap() / 1000000000.0, step, data );
+}
+
+int GameLoop::advance( double seconds, StepFunction step, void* data )
+{
+	mAccumulator += seconds;
+
+	//Run as many fixed steps as the time has covered
+	int steps = 0;
+	Uint64 start = SDL_GetPerformanceCounter();
+	while( mAccumulator >= mStep && steps < mMaxSteps )
+	{
+		step( data );
+		mAccumulator -= mStep;
+		++steps;
+	}
+	mStepCounter += SDL_GetPerformanceCounter() - start;
+	mStepCount += steps;
+
+	//Drop time we could not catch up on instead of spiralling
+	if( mAccumulator >= mStep )
+	{
+		mAccumulator = 0;
+		++mDroppedFrames;
+	}
+
+	return steps;
+}
+
+double GameLoop::getAlpha()
+{
+	return mAccumulator / mStep;
+}
+
+double GameLoop::getStep()
+{
+	return mStep;
+}
+
+Uint64 GameLoop::getStepCount()
+{
+	return mStepCount;
+}
+
+double GameLoop::getStepSeconds()
+{
+	return (double)mStepCounter / SDL_GetPerformanceFrequency();
+}
+
+int GameLoop::getDroppedFrames()
+{
+	return mDroppedFrames;
+}
+
+void GameLoop::resetStats()
+{
+	mStepCount = 0;
+	mStepCounter = 0;
+	mDroppedFrames = 0;
+}
+
+double interpolate( double previous, double current, double alpha )
+{
+	return previous + ( current - previous ) * alpha;
+}
@@ -0,0 +1,63 @@
+#ifndef GAME_LOOP_H
+#define GAME_LOOP_H
+
+#include <SDL2/SDL.h>
+#include "LTimer.h"
+
+//Advances the simulation passed as data by one fixed step, GameLoop::getStep gives its length
+typedef void ( *StepFunction )( void* data );
+
+//Drives a simulation in fixed steps however fast frames are rendered
+//Time left over after the last whole step carries into the next frame, and getAlpha tells rendering how far into the next step it is
+class GameLoop
+{
+	public:
+		//Simulates stepsPerSecond steps per second, running at most maxStepsPerFrame in one frame before dropping time
+		GameLoop( double stepsPerSecond = 60, int maxStepsPerFrame = 8 );
+
+		//Forgets carried time and starts measuring real time from now
+		void start();
+
+		//Runs the steps real time has covered since the last advance, starts if needed, returns steps run
+		int advance( StepFunction step, void* data );
+
+		//Runs the steps the given seconds cover, for replays and headless runs that supply their own time
+		int advance( double seconds, StepFunction step, void* data );
+
+		//Fraction of a step simulated time is behind real time, render between the last two states by this much
+		double getAlpha();
+
+		//Seconds per step
+		double getStep();
+
+		//Steps run and CPU time spent inside them since the last reset
+		Uint64 getStepCount();
+		double getStepSeconds();
+
+		//Frames that had to drop time to avoid falling further behind
+		int getDroppedFrames();
+
+		//Forgets step counts and times
+		void resetStats();
+
+	private:
+		//Real time between advances
+		LTimer mTimer;
+
+		//Seconds per step and the limit per frame
+		double mStep;
+		int mMaxSteps;
+
+		//Unsimulated seconds
+		double mAccumulator;
+
+		//Steps run, performance counter ticks spent in them and frames that dropped time
+		Uint64 mStepCount;
+		Uint64 mStepCounter;
+		int mDroppedFrames;
+};
+
+//Value alpha of the way from the previous step's state to the current one
+double interpolate( double previous, double current, double alpha );
+
+#endif
@@ -0,0 +1,310 @@
+#include "GlyphCache.h"
+#include "AtlasPacker.h"
+#include <iostream>
+
+using namespace std;
+
+//Atlas sheet width, the printable glyphs of a sample sized font fit a few rows of it
+const int GLYPH_SHEET_WIDTH = 512;
+
+//Space between glyphs so filtering never bleeds a neighbour in
+const int GLYPH_PADDING = 1;
+
+GlyphCache::GlyphCache()
+{
+	//Initialize
+	mTexture = NULL;
+	mWidth = 0;
+	mHeight = 0;
+	mLineHeight = 0;
+	mDrawCalls = 0;
+	for( int i = 0; i < GLYPH_COUNT; ++i )
+	{
+		SDL_Rect empty = { 0, 0, 0, 0 };
+		mGlyphs[ i ].clip = empty;
+		mGlyphs[ i ].offsetX = 0;
+		mGlyphs[ i ].advance = 0;
+	}
+}
+
+GlyphCache::~GlyphCache()
+{
+	//Deallocate
+	free();
+}
+
+bool GlyphCache::load( SDL_Renderer* renderer, TTF_Font* font )
+{
+	//Get rid of preexisting atlas
+	free();
+
+	//Render every glyph the way TTF_RenderText_Solid would, white on a keyed background
+	SDL_Color white = { 0xFF, 0xFF, 0xFF, 0xFF };
+	//Every slot starts empty so a failed load only frees what it rendered
+	SDL_Surface* surfaces[ GLYPH_COUNT ] = { NULL };
+	AtlasPacker packer( GLYPH_SHEET_WIDTH, GLYPH_PADDING );
+	bool success = true;
+	for( int i = 0; i < GLYPH_COUNT; ++i )
+	{
+		Uint16 character = (Uint16)( FIRST_GLYPH + i );
+
+		int minX, maxX, minY, maxY, advance;
+		if( !TTF_GlyphIsProvided( font, character ) || TTF_GlyphMetrics( font, character, &minX, &maxX, &minY, &maxY, &advance ) != 0 )
+		{
+			continue;
+		}
+
+		//Single glyph renders start at the pen, or at the glyph's left edge if it hangs further left
+		mGlyphs[ i ].offsetX = minX < 0 ? minX : 0;
+		mGlyphs[ i ].advance = advance;
+
+		//Spaces have nothing to draw
+		if( character == ' ' )
+		{
+			continue;
+		}
+
+		surfaces[ i ] = TTF_RenderGlyph_Solid( font, character, white );
+		if( surfaces[ i ] == NULL )
+		{
+			cout << "Unable to render glyph " << (char)character << "! SDL_ttf Error: " << TTF_GetError() << endl;
+			success = false;
+			break;
+		}
+		if( !packer.insert( surfaces[ i ]->w, surfaces[ i ]->h, mGlyphs[ i ].clip ) )
+		{
+			cout << "Glyph " << (char)character << " too wide for the glyph atlas!" << endl;
+			success = false;
+			break;
+		}
+	}
+
+	//Copy glyphs into one sheet, background stays black and is keyed out
+	if( success )
+	{
+		SDL_Surface* sheet = SDL_CreateRGBSurfaceWithFormat( 0, packer.getWidth(), packer.getHeight() > 0 ? packer.getHeight() : 1, 32, SDL_PIXELFORMAT_RGBA8888 );
+		if( sheet == NULL )
+		{
+			cout << "Unable to create glyph atlas surface! SDL Error: " << SDL_GetError() << endl;
+			success = false;
+		}
+		else
+		{
+			SDL_FillRect( sheet, NULL, SDL_MapRGB( sheet->format, 0, 0, 0 ) );
+			for( int i = 0; i < GLYPH_COUNT; ++i )
+			{
+				if( surfaces[ i ] != NULL )
+				{
+					SDL_Rect destination = mGlyphs[ i ].clip;
+					SDL_BlitSurface( surfaces[ i ], NULL, sheet, &destination );
+				}
+			}
+			SDL_SetColorKey( sheet, SDL_TRUE, SDL_MapRGB( sheet->format, 0, 0, 0 ) );
+
+			//Create texture from sheet pixels
+			mTexture = SDL_CreateTextureFromSurface( renderer, sheet );
+			if( mTexture == NULL )
+			{
+				cout << "Unable to create glyph atlas texture! SDL Error: " << SDL_GetError() << endl;
+				success = false;
+			}
+			else
+			{
+				SDL_SetTextureBlendMode( mTexture, SDL_BLENDMODE_BLEND );
+				mWidth = sheet->w;
+				mHeight = sheet->h;
+			}
+			SDL_FreeSurface( sheet );
+		}
+	}
+
+	//Get rid of glyph surfaces
+	for( int i = 0; i < GLYPH_COUNT; ++i )
+	{
+		if( surfaces[ i ] != NULL )
+		{
+			SDL_FreeSurface( surfaces[ i ] );
+		}
+	}
+
+	if( !success )
+	{
+		free();
+		return false;
+	}
+
+	//Kerning table, looked up once here instead of per string
+	mLineHeight = TTF_FontHeight( font );
+	if( TTF_GetFontKerning( font ) )
+	{
+		mKerning.assign( GLYPH_COUNT * GLYPH_COUNT, 0 );
+		for( int first = 0; first < GLYPH_COUNT; ++first )
+		{
+			for( int second = 0; second < GLYPH_COUNT; ++second )
+			{
+				mKerning[ first * GLYPH_COUNT + second ] = TTF_GetFontKerningSizeGlyphs( font, FIRST_GLYPH + first, FIRST_GLYPH + second );
+			}
+		}
+	}
+
+	return true;
+}
+
+void GlyphCache::free()
+{
+	//Free texture if it exists
+	if( mTexture != NULL )
+	{
+		SDL_DestroyTexture( mTexture );
+		mTexture = NULL;
+		mWidth = 0;
+		mHeight = 0;
+		mLineHeight = 0;
+	}
+	mKerning.clear();
+	for( int i = 0; i < GLYPH_COUNT; ++i )
+	{
+		SDL_Rect empty = { 0, 0, 0, 0 };
+		mGlyphs[ i ].clip = empty;
+		mGlyphs[ i ].offsetX = 0;
+		mGlyphs[ i ].advance = 0;
+	}
+}
+
+void GlyphCache::reserve( int characters )
+{
+	mVertices.reserve( characters * 4 );
+	mIndices.reserve( characters * 6 );
+}
+
+void GlyphCache::begin()
+{
+	//Keeps capacity, so no allocation once warmed up
+	mVertices.clear();
+	mIndices.clear();
+}
+
+void GlyphCache::add( const string& text, int x, int y, SDL_Color color )
+{
+	int penX = x;
+	for( int i = 0; i < (int)text.size(); ++i )
+	{
+		Glyph* glyph = getGlyph( text[ i ] );
+		if( glyph == NULL )
+		{
+			continue;
+		}
+		if( i > 0 )
+		{
+			penX += getKerning( text[ i - 1 ], text[ i ] );
+		}
+
+		SDL_Rect& clip = glyph->clip;
+		if( clip.w > 0 )
+		{
+			//Texture coordinates of the clip
+			float u0 = (float)clip.x / mWidth;
+			float v0 = (float)clip.y / mHeight;
+			float u1 = (float)( clip.x + clip.w ) / mWidth;
+			float v1 = (float)( clip.y + clip.h ) / mHeight;
+
+			//Screen corners of the quad
+			float x0 = (float)( penX + glyph->offsetX );
+			float y0 = (float)y;
+			float x1 = x0 + clip.w;
+			float y1 = y0 + clip.h;
+
+			//Vertex color tints the white glyphs
+			int base = (int)mVertices.size();
+			SDL_Vertex corners[ 4 ] =
+			{
+				{ { x0, y0 }, color, { u0, v0 } },
+				{ { x1, y0 }, color, { u1, v0 } },
+				{ { x1, y1 }, color, { u1, v1 } },
+				{ { x0, y1 }, color, { u0, v1 } }
+			};
+			mVertices.insert( mVertices.end(), corners, corners + 4 );
+
+			//Two triangles per quad
+			int quad[ 6 ] = { base, base + 1, base + 2, base, base + 2, base + 3 };
+			mIndices.insert( mIndices.end(), quad, quad + 6 );
+		}
+
+		penX += glyph->advance;
+	}
+}
+
+bool GlyphCache::flush( SDL_Renderer* renderer )
+{
+	//Nothing queued
+	if( mIndices.empty() || mTexture == NULL )
+	{
+		return false;
+	}
+
+	//Submit the whole batch at once
+	if( SDL_RenderGeometry( renderer, mTexture, &mVertices[ 0 ], (int)mVertices.size(), &mIndices[ 0 ], (int)mIndices.size() ) != 0 )
+	{
+		cout << "Unable to render glyph batch! SDL Error: " << SDL_GetError() << endl;
+		return false;
+	}
+
+	++mDrawCalls;
+	return true;
+}
+
+bool GlyphCache::render( SDL_Renderer* renderer, const string& text, int x, int y, SDL_Color color )
+{
+	begin();
+	add( text, x, y, color );
+	return flush( renderer );
+}
+
+int GlyphCache::getTextWidth( const string& text )
+{
+	//Pen travel, same as the width TTF_SizeText gives for plain text
+	int width = 0;
+	for( int i = 0; i < (int)text.size(); ++i )
+	{
+		Glyph* glyph = getGlyph( text[ i ] );
+		if( glyph != NULL )
+		{
+			width += glyph->advance + ( i > 0 ? getKerning( text[ i - 1 ], text[ i ] ) : 0 );
+		}
+	}
+	return width;
+}
+
+int GlyphCache::getHeight()
+{
+	return mLineHeight;
+}
+
+int GlyphCache::getDrawCalls()
+{
+	return mDrawCalls;
+}
+
+void GlyphCache::resetDrawCalls()
+{
+	mDrawCalls = 0;
+}
+
+GlyphCache::Glyph* GlyphCache::getGlyph( char character )
+{
+	int index = (unsigned char)character - FIRST_GLYPH;
+	if( index < 0 || index >= GLYPH_COUNT || mTexture == NULL )
+	{
+		return NULL;
+	}
+	return &mGlyphs[ index ];
+}
+
+int GlyphCache::getKerning( char first, char second )
+{
+	if( mKerning.empty() || getGlyph( first ) == NULL || getGlyph( second ) == NULL )
+	{
+		return 0;
+	}
+	return mKerning[ ( (unsigned char)first - FIRST_GLYPH ) * GLYPH_COUNT + (unsigned char)second - FIRST_GLYPH ];
+}
@@ -0,0 +1,100 @@
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+#include <vector>
+
+//A font's printable ASCII glyphs rendered once into an atlas, strings are drawn as quads from it with one geometry call
+//Changing text costs no SDL_ttf calls and no texture allocations
+class GlyphCache
+{
+	public:
+		//Cached characters
+		static const int FIRST_GLYPH = 32;
+		static const int LAST_GLYPH = 126;
+		static const int GLYPH_COUNT = LAST_GLYPH - FIRST_GLYPH + 1;
+
+		//Initializes variables
+		GlyphCache();
+
+		//Deallocates memory
+		~GlyphCache();
+
+		//Renders every glyph of font into the atlas, in white so any color can be drawn
+		bool load( SDL_Renderer* renderer, TTF_Font* font );
+
+		//Deallocates atlas
+		void free();
+
+		//Reserves room for characters so steady state never reallocates
+		void reserve( int characters );
+
+		//Starts a new batch
+		void begin();
+
+		//Queues text with its top left corner at the given point, characters not cached are skipped
+		void add( const std::string& text, int x, int y, SDL_Color color );
+
+		//Submits queued text and returns whether anything was drawn
+		bool flush( SDL_Renderer* renderer );
+
+		//Draws text on its own, same as begin, add and flush
+		bool render( SDL_Renderer* renderer, const std::string& text, int x, int y, SDL_Color color );
+
+		//Size text would be drawn at
+		int getTextWidth( const std::string& text );
+		int getHeight();
+
+		//Geometry calls issued since last reset
+		int getDrawCalls();
+		void resetDrawCalls();
+
+	private:
+		//Where one glyph is in the atlas and how it sits on a line
+		struct Glyph
+		{
+			//Atlas clip, empty for glyphs the font lacks
+			SDL_Rect clip;
+
+			//Offset of the clip from the pen position, and how far the pen moves after it
+			int offsetX;
+			int advance;
+		};
+
+		//Glyph of a character, NULL if it is not cached
+		Glyph* getGlyph( char character );
+
+		//Extra pen movement between a pair of cached characters
+		int getKerning( char first, char second );
+
+		//The atlas texture
+		SDL_Texture* mTexture;
+
+		//Atlas dimensions
+		int mWidth;
+		int mHeight;
+
+		//Line height of the font
+		int mLineHeight;
+
+		//Cached glyphs by character
+		Glyph mGlyphs[ GLYPH_COUNT ];
+
+		//Pair kerning by first then second glyph, empty if the font does not kern
+		std::vector<int> mKerning;
+
+		//Queued geometry
+		std::vector<SDL_Vertex> mVertices;
+		std::vector<int> mIndices;
+
+		//Geometry calls issued
+		int mDrawCalls;
+
+		//Owns its texture, so no copies
+		GlyphCache( const GlyphCache& );
+		GlyphCache& operator=( const GlyphCache& );
+};
+
+#endif
@@ -0,0 +1,424 @@
+#include "LTexture.h"
+#include "TextureCache.h"
+#include "PixelKernels.h"
+#include "PixelCache.h"
+#include <SDL2/SDL_image.h>
+#include <string.h>
+#include <iostream>
+
+using namespace std;
+
+//Cyan color key and the transparent pixel it becomes, as SDL_MapRGB and SDL_MapRGBA give them in RGBA8888
+const Uint32 RGBA8888_COLOR_KEY = 0x00FFFFFF;
+const Uint32 RGBA8888_TRANSPARENT = 0x00FFFF00;
+
+LTexture::LTexture()
+{
+	//Initialize
+	mTexture = NULL;
+	mWidth = 0;
+	mHeight = 0;
+	mPixels = NULL;
+	mPitch = 0;
+	mOffsetX = 0;
+	mOffsetY = 0;
+	mRed = 0xFF;
+	mGreen = 0xFF;
+	mBlue = 0xFF;
+	mAlpha = 0xFF;
+	mBlendMode = SDL_BLENDMODE_BLEND;
+}
+
+LTexture::~LTexture()
+{
+	//Deallocate
+	free();
+}
+
+bool LTexture::loadFromFile( string path, SDL_TextureAccess access )
+{
+	//Get rid of preexisting texture
+	free();
+
+	//Static images are shared with every other texture loaded from the same path
+	if( access == SDL_TEXTUREACCESS_STATIC )
+	{
+		mTexture = TextureCache::getInstance().acquire( gRenderer, path, mWidth, mHeight );
+		if( mTexture != NULL )
+		{
+			mCachePath = path;
+		}
+
+		return mTexture != NULL;
+	}
+
+	//The final texture
+	SDL_Texture* newTexture = NULL;
+
+	//Pixels converted and color keyed on an earlier run skip decoding, the source is checked before anything is read
+	PixelCache& cache = PixelCache::getInstance();
+	PixelSource source;
+	bool sourceFound = PixelCache::stat( path, source );
+	CachedPixels cached;
+	if( sourceFound && cache.open( path, source, cached ) )
+	{
+		//Create blank streamable texture
+		newTexture = SDL_CreateTexture( gRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STREAMING, cached.width, cached.height );
+		if( newTexture == NULL )
+		{
+			cout << "Unable to create blank texture! SDL Error: " << SDL_GetError() << endl;
+		}
+		else
+		{
+			//Enable blending on texture
+			SDL_SetTextureBlendMode( newTexture, SDL_BLENDMODE_BLEND );
+
+			//Copy cached pixels straight from the file mapping, row by row in case the texture pads its rows
+			if( SDL_LockTexture( newTexture, NULL, &mPixels, &mPitch ) != 0 )
+			{
+				cout << "Unable to lock texture! " << SDL_GetError() << endl;
+				SDL_DestroyTexture( newTexture );
+				newTexture = NULL;
+			}
+			else
+			{
+				for( int y = 0; y < cached.height; ++y )
+				{
+					memcpy( (Uint8*)mPixels + y * mPitch, cached.pixels + y * cached.width * 4, cached.width * 4 );
+				}
+				SDL_UnlockTexture( newTexture );
+
+				//Get image dimensions
+				mWidth = cached.width;
+				mHeight = cached.height;
+			}
+			mPixels = NULL;
+		}
+
+		cache.close( cached );
+	}
+	else
+	{
+		//Load image at specified path
+		SDL_Surface* loadedSurface = IMG_Load( path.c_str() );
+		if( loadedSurface == NULL )
+		{
+			cout << "Unable to load image " << path << "! SDL_image Error: " << IMG_GetError() << endl;
+		}
+		else
+		{
+			//Create blank streamable texture
+			newTexture = SDL_CreateTexture( gRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STREAMING, loadedSurface->w, loadedSurface->h );
+			if( newTexture == NULL )
+			{
+				cout << "Unable to create blank texture! SDL Error: " << SDL_GetError() << endl;
+			}
+			else
+			{
+				//Enable blending on texture
+				SDL_SetTextureBlendMode( newTexture, SDL_BLENDMODE_BLEND );
+
+				//Lock texture for manipulation
+				if( SDL_LockTexture( newTexture, NULL, &mPixels, &mPitch ) != 0 )
+				{
+					cout << "Unable to lock texture! " << SDL_GetError() << endl;
+					SDL_DestroyTexture( newTexture );
+					newTexture = NULL;
+					mPixels = NULL;
+				}
+				else
+				{
+					//Common image formats convert straight into the texture, anything else goes through SDL first
+					PixelKernel kernel = getBestPixelKernel();
+					bool converted = convertToRGBA8888( kernel, loadedSurface, mPixels, mPitch );
+					if( !converted )
+					{
+						//Convert surface to display format
+						SDL_Surface* formattedSurface = SDL_ConvertSurfaceFormat( loadedSurface, SDL_PIXELFORMAT_RGBA8888, 0 );
+						if( formattedSurface == NULL )
+						{
+							cout << "Unable to convert loaded surface to display format! SDL Error: " << SDL_GetError() << endl;
+						}
+						else
+						{
+							//Copy formatted surface pixels, row by row since the pitches can differ
+							SDL_LockSurface( formattedSurface );
+							for( int y = 0; y < formattedSurface->h; ++y )
+							{
+								memcpy( (Uint8*)mPixels + y * mPitch, (Uint8*)formattedSurface->pixels + y * formattedSurface->pitch, formattedSurface->w * 4 );
+							}
+							SDL_UnlockSurface( formattedSurface );
+							converted = true;
+
+							//Get rid of old formatted surface
+							SDL_FreeSurface( formattedSurface );
+						}
+					}
+
+					if( converted )
+					{
+						//Get image dimensions
+						mWidth = loadedSurface->w;
+						mHeight = loadedSurface->h;
+
+						//Color key pixels, cyan in RGBA8888 becomes transparent
+						colorKeyPixels( kernel, (Uint32*)mPixels, ( mPitch / 4 ) * mHeight, RGBA8888_COLOR_KEY, RGBA8888_TRANSPARENT );
+
+						//Keep the result for the next run
+						if( sourceFound )
+						{
+							cache.store( path, source, mPixels, mPitch, mWidth, mHeight );
+						}
+					}
+
+					//Unlock texture to update
+					SDL_UnlockTexture( newTexture );
+					mPixels = NULL;
+
+					if( !converted )
+					{
+						SDL_DestroyTexture( newTexture );
+						newTexture = NULL;
+					}
+				}
+			}
+
+			//Get rid of old loaded surface
+			SDL_FreeSurface( loadedSurface );
+		}
+	}
+
+	//Return success
+	mTexture = newTexture;
+	return mTexture != NULL;
+}
+
+bool LTexture::createBlank( int width, int height, SDL_TextureAccess access )
+{
+	//Get rid of preexisting texture
+	free();
+
+	//Create uninitialized texture
+	mTexture = SDL_CreateTexture( gRenderer, SDL_PIXELFORMAT_RGBA8888, access, width, height );
+	if( mTexture == NULL )
+	{
+		cout << "Unable to create blank texture! SDL Error: " << SDL_GetError() << endl;
+	}
+	else
+	{
+		mWidth = width;
+		mHeight = height;
+	}
+
+	return mTexture != NULL;
+}
+
+void LTexture::free()
+{
+	//Free texture if it exists
+	if( mTexture != NULL )
+	{
+		//Shared textures are only destroyed by their last user
+		if( !mCachePath.empty() )
+		{
+			TextureCache::getInstance().release( mCachePath );
+			mCachePath.clear();
+		}
+		else
+		{
+			SDL_DestroyTexture( mTexture );
+		}
+
+		mTexture = NULL;
+		mWidth = 0;
+		mHeight = 0;
+		mPixels = NULL;
+		mPitch = 0;
+		mOffsetX = 0;
+		mOffsetY = 0;
+	}
+
+	//Fresh textures start unmodulated
+	mRed = 0xFF;
+	mGreen = 0xFF;
+	mBlue = 0xFF;
+	mAlpha = 0xFF;
+	mBlendMode = SDL_BLENDMODE_BLEND;
+}
+
+void LTexture::setColor( Uint8 red, Uint8 green, Uint8 blue )
+{
+	//Modulate texture rgb
+	mRed = red;
+	mGreen = green;
+	mBlue = blue;
+	SDL_SetTextureColorMod( mTexture, red, green, blue );
+}
+
+void LTexture::setBlendMode( SDL_BlendMode blending )
+{
+	//Set blending function
+	mBlendMode = blending;
+	SDL_SetTextureBlendMode( mTexture, blending );
+}
+
+void LTexture::setAlpha( Uint8 alpha )
+{
+	//Modulate texture alpha
+	mAlpha = alpha;
+	SDL_SetTextureAlphaMod( mTexture, alpha );
+}
+
+void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip )
+{
+	//Another user of a shared texture may have changed its modulation
+	if( !mCachePath.empty() )
+	{
+		SDL_SetTextureColorMod( mTexture, mRed, mGreen, mBlue );
+		SDL_SetTextureAlphaMod( mTexture, mAlpha );
+		SDL_SetTextureBlendMode( mTexture, mBlendMode );
+	}
+
+	//Set rendering space and render to screen
+	SDL_Rect renderQuad = { x, y, mWidth, mHeight };
+
+	//Our image, which is only part of the texture inside an atlas
+	SDL_Rect source = { mOffsetX, mOffsetY, mWidth, mHeight };
+
+	//Set clip rendering dimensions
+	if( clip != NULL )
+	{
+		source.x += clip->x;
+		source.y += clip->y;
+		source.w = clip->w;
+		source.h = clip->h;
+		renderQuad.w = clip->w;
+		renderQuad.h = clip->h;
+	}
+
+	//Render to screen
+	SDL_RenderCopyEx( gRenderer, mTexture, &source, &renderQuad, angle, center, flip );
+}
+
+void LTexture::setAsRenderTarget()
+{
+	//Make self render target
+	SDL_SetRenderTarget( gRenderer, mTexture );
+}
+
+int LTexture::getWidth()
+{
+	return mWidth;
+}
+
+int LTexture::getHeight()
+{
+	return mHeight;
+}
+
+bool LTexture::lockTexture()
+{
+	bool success = true;
+
+	//Texture is already locked
+	if( mPixels != NULL )
+	{
+		cout << "Texture is already locked!" << endl;
+		success = false;
+	}
+	//Lock texture
+	else
+	{
+		if( SDL_LockTexture( mTexture, NULL, &mPixels, &mPitch ) != 0 )
+		{
+			cout << "Unable to lock texture! " << SDL_GetError() << endl;
+			success = false;
+		}
+	}
+
+	return success;
+}
+
+bool LTexture::unlockTexture()
+{
+	bool success = true;
+
+	//Texture is not locked
+	if( mPixels == NULL )
+	{
+		cout << "Texture is not locked!" << endl;
+		success = false;
+	}
+	//Unlock texture
+	else
+	{
+		SDL_UnlockTexture( mTexture );
+		mPixels = NULL;
+		mPitch = 0;
+	}
+
+	return success;
+}
+
+void* LTexture::getPixels()
+{
+	return mPixels;
+}
+
+void LTexture::copyPixels( void* pixels )
+{
+	//Texture is locked
+	if( mPixels != NULL )
+	{
+		//Copy to locked pixels
+		memcpy( mPixels, pixels, mPitch * mHeight );
+	}
+}
+
+bool LTexture::copyRects( const void* pixels, int pitch, const SDL_Rect* rects, int count )
+{
+	//Whole frame locking is separate, and shared textures are not ours to write
+	if( mPixels != NULL || !mCachePath.empty() )
+	{
+		cout << "Unable to copy rectangles into a locked or shared texture!" << endl;
+		return false;
+	}
+
+	//Lock and fill each rectangle on its own so only it is uploaded
+	bool success = true;
+	const Uint8* source = (const Uint8*)pixels;
+	for( int i = 0; i < count; ++i )
+	{
+		void* locked;
+		int lockedPitch;
+		if( SDL_LockTexture( mTexture, &rects[ i ], &locked, &lockedPitch ) != 0 )
+		{
+			cout << "Unable to lock texture rectangle! " << SDL_GetError() << endl;
+			success = false;
+			continue;
+		}
+
+		int rowBytes = rects[ i ].w * 4;
+		for( int y = 0; y < rects[ i ].h; ++y )
+		{
+			memcpy( (Uint8*)locked + y * lockedPitch, source + ( rects[ i ].y + y ) * pitch + rects[ i ].x * 4, rowBytes );
+		}
+		SDL_UnlockTexture( mTexture );
+	}
+
+	return success;
+}
+
+int LTexture::getPitch()
+{
+	return mPitch;
+}
+
+Uint32 LTexture::getPixel32( unsigned int x, unsigned int y )
+{
+	//Convert the pixels to 32 bit
+	Uint32* pixels = (Uint32*)mPixels;
+
+	//Get the pixel requested
+	return pixels[ ( y * ( mPitch / 4 ) ) + x ];
+}
@@ -0,0 +1,95 @@
+#ifndef LTEXTURE_H
+#define LTEXTURE_H
+
+#include <SDL2/SDL.h>
+#include <string>
+
+class TextureAtlas;
+class CollisionMask;
+
+//The renderer every texture draws with, each sample defines its own
+extern SDL_Renderer* gRenderer;
+
+//Texture wrapper class
+class LTexture
+{
+	public:
+		//Initializes variables
+		LTexture();
+
+		//Deallocates memory
+		~LTexture();
+
+		//Loads image at specified path, static images are shared through the texture cache
+		//while any other access gets a private streaming texture with editable pixels
+		bool loadFromFile( std::string path, SDL_TextureAccess access = SDL_TEXTUREACCESS_STATIC );
+
+		//Loads a static image like above and builds its collision mask from the same pixels
+		bool loadFromFile( std::string path, CollisionMask& mask );
+
+		//Uses the image loaded from path inside an atlas, clips passed to render stay relative to it
+		bool loadFromAtlas( TextureAtlas& atlas, std::string path );
+
+		//Creates image from font string, needs the sample's gFont and SDL_ttf
+		bool loadFromRenderedText( std::string textureText, SDL_Color textColor );
+
+		//Creates blank texture
+		bool createBlank( int width, int height, SDL_TextureAccess access = SDL_TEXTUREACCESS_STREAMING );
+
+		//Deallocates texture
+		void free();
+
+		//Set color modulation
+		void setColor( Uint8 red, Uint8 green, Uint8 blue );
+
+		//Set blending
+		void setBlendMode( SDL_BlendMode blending );
+
+		//Set alpha modulation
+		void setAlpha( Uint8 alpha );
+
+		//Renders texture at given point
+		void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
+
+		//Set self as render target
+		void setAsRenderTarget();
+
+		//Gets image dimensions
+		int getWidth();
+		int getHeight();
+
+		//Pixel manipulators
+		bool lockTexture();
+		bool unlockTexture();
+		void* getPixels();
+		void copyPixels( void* pixels );
+		bool copyRects( const void* pixels, int pitch, const SDL_Rect* rects, int count );
+		int getPitch();
+		Uint32 getPixel32( unsigned int x, unsigned int y );
+
+	private:
+		//The actual hardware texture
+		SDL_Texture* mTexture;
+		void* mPixels;
+		int mPitch;
+
+		//Image dimensions
+		int mWidth;
+		int mHeight;
+
+		//Position of the image inside a shared atlas texture
+		int mOffsetX;
+		int mOffsetY;
+
+		//Cache key of a shared texture, empty when this texture owns it
+		std::string mCachePath;
+
+		//Modulation, re-applied before each render of a shared texture
+		Uint8 mRed;
+		Uint8 mGreen;
+		Uint8 mBlue;
+		Uint8 mAlpha;
+		SDL_BlendMode mBlendMode;
+};
+
+#endif
@@ -0,0 +1,35 @@
+#include "LTexture.h"
+#include "TextureAtlas.h"
+#include "TextureCache.h"
+#include <iostream>
+
+using namespace std;
+
+bool LTexture::loadFromAtlas( TextureAtlas& atlas, string path )
+{
+	//Get rid of preexisting texture
+	free();
+
+	//Find the image
+	SDL_Rect* clip = atlas.getClip( path );
+	if( clip == NULL )
+	{
+		cout << "Unable to find " << path << " in atlas " << atlas.getKey() << "!" << endl;
+		return false;
+	}
+
+	//Share the sheet, which stays alive as long as any of its images do
+	int sheetWidth = 0;
+	int sheetHeight = 0;
+	mTexture = TextureCache::getInstance().acquireLoaded( atlas.getKey(), sheetWidth, sheetHeight );
+	if( mTexture != NULL )
+	{
+		mCachePath = atlas.getKey();
+		mOffsetX = clip->x;
+		mOffsetY = clip->y;
+		mWidth = clip->w;
+		mHeight = clip->h;
+	}
+
+	return mTexture != NULL;
+}
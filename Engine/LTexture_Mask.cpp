@@ -0,0 +1,39 @@
+#include "LTexture.h"
+#include "CollisionMask.h"
+#include "TextureCache.h"
+#include <iostream>
+
+using namespace std;
+
+bool LTexture::loadFromFile( string path, CollisionMask& mask )
+{
+	//Get rid of preexisting texture
+	free();
+
+	//Decode once for both the mask and the texture
+	SDL_Surface* loadedSurface = TextureCache::decode( path );
+	if( loadedSurface == NULL )
+	{
+		return false;
+	}
+
+	//Mask from the color keyed pixels before they are uploaded
+	if( !mask.build( loadedSurface ) )
+	{
+		cout << "Unable to build collision mask for " << path << "!" << endl;
+	}
+	else
+	{
+		//Shared like any other static image
+		mTexture = TextureCache::getInstance().adopt( gRenderer, path, loadedSurface, mWidth, mHeight );
+		if( mTexture != NULL )
+		{
+			mCachePath = path;
+		}
+	}
+
+	//Get rid of old loaded surface
+	SDL_FreeSurface( loadedSurface );
+
+	return mTexture != NULL;
+}
@@ -0,0 +1,42 @@
+#include "LTexture.h"
+#include <SDL2/SDL_ttf.h>
+#include <iostream>
+
+using namespace std;
+
+//Kept out of LTexture.cpp so samples without text never need SDL_ttf or a font
+extern TTF_Font* gFont;
+
+bool LTexture::loadFromRenderedText( string textureText, SDL_Color textColor )
+{
+	//Get rid of preexisting texture
+	free();
+
+	//Render text surface
+	SDL_Surface* textSurface = TTF_RenderText_Solid( gFont, textureText.c_str(), textColor );
+	if( textSurface != NULL )
+	{
+		//Create texture from surface pixels
+		mTexture = SDL_CreateTextureFromSurface( gRenderer, textSurface );
+		if( mTexture == NULL )
+		{
+			cout << "Unable to create texture from rendered text! SDL Error: " << SDL_GetError() << endl;
+		}
+		else
+		{
+			//Get image dimensions
+			mWidth = textSurface->w;
+			mHeight = textSurface->h;
+		}
+
+		//Get rid of old surface
+		SDL_FreeSurface( textSurface );
+	}
+	else
+	{
+		cout << "Unable to render text surface! SDL_ttf Error: " << TTF_GetError() << endl;
+	}
+
+	//Return success
+	return mTexture != NULL;
+}
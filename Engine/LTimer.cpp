@@ -0,0 +1,149 @@
+#include "LTimer.h"
+
+LTimer::LTimer( TimerClock clock )
+{
+	//Initialize the variables
+	mClock = clock;
+	mStartCount = 0;
+	mPausedCount = 0;
+	mLapCount = 0;
+
+	mPaused = false;
+	mStarted = false;
+}
+
+void LTimer::start()
+{
+	//Start the timer
+	mStarted = true;
+
+	//Unpause the timer
+	mPaused = false;
+
+	//Get the current clock time
+	mStartCount = getCount();
+	mPausedCount = 0;
+	mLapCount = 0;
+}
+
+void LTimer::stop()
+{
+	//Stop the timer
+	mStarted = false;
+
+	//Unpause the timer
+	mPaused = false;
+
+	//Clear clock variables
+	mStartCount = 0;
+	mPausedCount = 0;
+	mLapCount = 0;
+}
+
+void LTimer::pause()
+{
+	//If the timer is running and isn't already paused
+	if( mStarted && !mPaused )
+	{
+		//Pause the timer
+		mPaused = true;
+
+		//Calculate the paused run time
+		mPausedCount = getCount() - mStartCount;
+		mStartCount = 0;
+	}
+}
+
+void LTimer::unpause()
+{
+	//If the timer is running and paused
+	if( mStarted && mPaused )
+	{
+		//Unpause the timer
+		mPaused = false;
+
+		//Reset the starting clock time so the pause is not counted
+		mStartCount = getCount() - mPausedCount;
+
+		//Reset the paused run time
+		mPausedCount = 0;
+	}
+}
+
+Uint32 LTimer::getTicks()
+{
+	return (Uint32)( getNanoseconds() / 1000000 );
+}
+
+Uint64 LTimer::getNanoseconds()
+{
+	return toNanoseconds( getElapsed() );
+}
+
+double LTimer::getSeconds()
+{
+	return (double)getElapsed() / getFrequency();
+}
+
+Uint64 LTimer::lap()
+{
+	//Laps are measured in run time so pauses inside a lap are not counted
+	Uint64 elapsed = getElapsed();
+	Uint64 lap = elapsed - mLapCount;
+	mLapCount = elapsed;
+	return toNanoseconds( lap );
+}
+
+Uint64 LTimer::getSplit()
+{
+	return toNanoseconds( getElapsed() - mLapCount );
+}
+
+bool LTimer::isStarted()
+{
+	//Timer is running and paused or unpaused
+	return mStarted;
+}
+
+bool LTimer::isPaused()
+{
+	//Timer is running and paused
+	return mPaused && mStarted;
+}
+
+TimerClock LTimer::getClock()
+{
+	return mClock;
+}
+
+Uint64 LTimer::getCount()
+{
+	return mClock == TIMER_PERFORMANCE ? SDL_GetPerformanceCounter() : SDL_GetTicks();
+}
+
+Uint64 LTimer::getFrequency()
+{
+	return mClock == TIMER_PERFORMANCE ? SDL_GetPerformanceFrequency() : 1000;
+}
+
+Uint64 LTimer::getElapsed()
+{
+	//A stopped timer has not run
+	if( !mStarted )
+	{
+		return 0;
+	}
+
+	//If the timer is paused return the run time when it was paused, otherwise the current time minus the start time
+	Uint64 elapsed = mPaused ? mPausedCount : getCount() - mStartCount;
+
+	//Ticks wrap at 32 bits, so keep their difference in 32 bits like the old timer did
+	return mClock == TIMER_TICKS ? (Uint32)elapsed : elapsed;
+}
+
+Uint64 LTimer::toNanoseconds( Uint64 counts )
+{
+	//Whole seconds and the remainder apart, so long runs don't overflow
+	Uint64 frequency = getFrequency();
+	return counts / frequency * 1000000000 + counts % frequency * 1000000000 / frequency;
+}
@@ -0,0 +1,77 @@
+#ifndef LTIMER_H
+#define LTIMER_H
+
+#include <SDL2/SDL.h>
+
+//Clocks a timer can read
+enum TimerClock
+{
+	//SDL_GetTicks, whole milliseconds
+	TIMER_TICKS,
+
+	//SDL_GetPerformanceCounter, as fine as the platform allows
+	TIMER_PERFORMANCE
+};
+
+//The application time based timer
+class LTimer
+{
+	public:
+		//Initializes variables, millisecond ticks unless asked for the performance counter
+		LTimer( TimerClock clock = TIMER_TICKS );
+
+		//The various clock actions
+		void start();
+		void stop();
+		void pause();
+		void unpause();
+
+		//Gets the timer's time in milliseconds
+		Uint32 getTicks();
+
+		//Gets the timer's time in nanoseconds and seconds
+		Uint64 getNanoseconds();
+		double getSeconds();
+
+		//Nanoseconds since the last lap or start, and starts the next lap
+		Uint64 lap();
+
+		//Nanoseconds since the last lap or start, without starting the next lap
+		Uint64 getSplit();
+
+		//Checks the status of the timer
+		bool isStarted();
+		bool isPaused();
+
+		//Which clock the timer reads
+		TimerClock getClock();
+
+	private:
+		//Current reading of the timer's clock, and readings per second
+		Uint64 getCount();
+		Uint64 getFrequency();
+
+		//Clock readings the timer has run for
+		Uint64 getElapsed();
+
+		//Clock readings as nanoseconds
+		Uint64 toNanoseconds( Uint64 counts );
+
+		//The clock the timer reads
+		TimerClock mClock;
+
+		//The clock reading when the timer started
+		Uint64 mStartCount;
+
+		//The run time stored when the timer was paused
+		Uint64 mPausedCount;
+
+		//The run time when the current lap started
+		Uint64 mLapCount;
+
+		//The timer status
+		bool mPaused;
+		bool mStarted;
+};
+
+#endif
@@ -0,0 +1,290 @@
+#include "PixelCache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <iostream>
+
+//Unix builds map entries straight from the file, everything else reads them into memory
+#if defined( __unix__ ) || defined( __APPLE__ )
+#define PIXEL_CACHE_HAS_MMAP
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+using namespace std;
+
+//Marks a file as a pixel cache entry
+const Uint32 PIXEL_CACHE_MAGIC = 0x5850544C;
+
+//Bump whenever the stored pixels change meaning, such as a new color key, so old entries go stale
+const Uint32 PIXEL_CACHE_VERSION = 1;
+
+//Pixels start on a cache line after the header and source path
+const Uint32 PIXEL_CACHE_ALIGN = 64;
+
+//Appended to the source path to name its entry
+const char* PIXEL_CACHE_EXTENSION = ".pixels";
+
+//Start of every entry, followed by the source path then the pixels at pixelOffset
+struct PixelCacheHeader
+{
+	Uint32 magic;
+	Uint32 version;
+
+	//Source image the pixels were converted from, as it was then
+	Uint64 sourceSize;
+	Sint64 sourceModified;
+
+	Uint32 width;
+	Uint32 height;
+	Uint32 pathLength;
+	Uint32 pixelOffset;
+};
+
+//Maps the whole file at path for reading
+static bool mapFile( string path, void*& mapping, size_t& size )
+{
+	mapping = NULL;
+	size = 0;
+
+	#ifdef PIXEL_CACHE_HAS_MMAP
+	int file = ::open( path.c_str(), O_RDONLY );
+	if( file == -1 )
+	{
+		return false;
+	}
+
+	struct stat info;
+	if( fstat( file, &info ) == 0 && info.st_size > 0 )
+	{
+		void* view = mmap( NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0 );
+		if( view != MAP_FAILED )
+		{
+			mapping = view;
+			size = (size_t)info.st_size;
+		}
+	}
+
+	//The mapping stays valid after the file is closed
+	::close( file );
+	#else
+	SDL_RWops* file = SDL_RWFromFile( path.c_str(), "rb" );
+	if( file == NULL )
+	{
+		return false;
+	}
+
+	Sint64 length = SDL_RWsize( file );
+	if( length > 0 )
+	{
+		mapping = malloc( (size_t)length );
+		if( mapping != NULL && SDL_RWread( file, mapping, 1, (size_t)length ) == (size_t)length )
+		{
+			size = (size_t)length;
+		}
+		else
+		{
+			::free( mapping );
+			mapping = NULL;
+		}
+	}
+	SDL_RWclose( file );
+	#endif
+
+	return mapping != NULL;
+}
+
+//Releases a file mapped by mapFile
+static void unmapFile( void* mapping, size_t size )
+{
+	if( mapping == NULL )
+	{
+		return;
+	}
+
+	#ifdef PIXEL_CACHE_HAS_MMAP
+	munmap( mapping, size );
+	#else
+	::free( mapping );
+	#endif
+}
+
+PixelCache& PixelCache::getInstance()
+{
+	static PixelCache cache;
+	return cache;
+}
+
+bool PixelCache::stat( string path, PixelSource& source )
+{
+	struct stat info;
+	if( ::stat( path.c_str(), &info ) != 0 )
+	{
+		return false;
+	}
+
+	source.size = (Uint64)info.st_size;
+	source.modified = (Sint64)info.st_mtime;
+	return true;
+}
+
+PixelCache::PixelCache()
+{
+	//Initialize
+	mEnabled = true;
+	mHits = 0;
+	mMisses = 0;
+	mStale = 0;
+}
+
+bool PixelCache::open( string path, const PixelSource& source, CachedPixels& cached )
+{
+	cached.width = 0;
+	cached.height = 0;
+	cached.pixels = NULL;
+	cached.mapping = NULL;
+	cached.mappingSize = 0;
+
+	if( !mEnabled )
+	{
+		return false;
+	}
+
+	void* mapping;
+	size_t size;
+	if( !mapFile( getCachePath( path ), mapping, size ) )
+	{
+		++mMisses;
+		return false;
+	}
+
+	//The entry has to be whole and made from the source as it is now
+	PixelCacheHeader header;
+	bool valid = size >= sizeof( header );
+	if( valid )
+	{
+		memcpy( &header, mapping, sizeof( header ) );
+		valid = header.magic == PIXEL_CACHE_MAGIC && header.version == PIXEL_CACHE_VERSION &&
+			header.sourceSize == source.size && header.sourceModified == source.modified &&
+			header.pathLength == path.size() && sizeof( header ) + header.pathLength <= header.pixelOffset &&
+			header.width > 0 && header.height > 0 &&
+			header.pixelOffset + (Uint64)header.width * header.height * 4 <= size;
+	}
+	if( valid )
+	{
+		valid = memcmp( (const Uint8*)mapping + sizeof( header ), path.c_str(), path.size() ) == 0;
+	}
+	if( !valid )
+	{
+		unmapFile( mapping, size );
+		++mStale;
+		return false;
+	}
+
+	cached.width = header.width;
+	cached.height = header.height;
+	cached.pixels = (const Uint8*)mapping + header.pixelOffset;
+	cached.mapping = mapping;
+	cached.mappingSize = size;
+	++mHits;
+	return true;
+}
+
+void PixelCache::close( CachedPixels& cached )
+{
+	unmapFile( cached.mapping, cached.mappingSize );
+	cached.pixels = NULL;
+	cached.mapping = NULL;
+	cached.mappingSize = 0;
+}
+
+bool PixelCache::store( string path, const PixelSource& source, const void* pixels, int pitch, int width, int height )
+{
+	if( !mEnabled )
+	{
+		return false;
+	}
+
+	PixelCacheHeader header;
+	header.sourceSize = source.size;
+	header.sourceModified = source.modified;
+	header.magic = PIXEL_CACHE_MAGIC;
+	header.version = PIXEL_CACHE_VERSION;
+	header.width = width;
+	header.height = height;
+	header.pathLength = path.size();
+	header.pixelOffset = ( sizeof( header ) + path.size() + PIXEL_CACHE_ALIGN - 1 ) / PIXEL_CACHE_ALIGN * PIXEL_CACHE_ALIGN;
+
+	//Written beside the entry then moved over it, so a crash never leaves half an entry under the real name
+	string cachePath = getCachePath( path );
+	string writePath = cachePath + ".tmp";
+	SDL_RWops* file = SDL_RWFromFile( writePath.c_str(), "wb" );
+	if( file == NULL )
+	{
+		cout << "Unable to write pixel cache " << cachePath << "! SDL Error: " << SDL_GetError() << endl;
+		return false;
+	}
+
+	char padding[ PIXEL_CACHE_ALIGN ] = { 0 };
+	size_t paddingSize = header.pixelOffset - sizeof( header ) - path.size();
+	bool success = SDL_RWwrite( file, &header, sizeof( header ), 1 ) == 1 &&
+		SDL_RWwrite( file, path.c_str(), 1, path.size() ) == path.size() &&
+		SDL_RWwrite( file, padding, 1, paddingSize ) == paddingSize;
+
+	//Rows are packed, dropping any pitch padding
+	for( int y = 0; y < height && success; ++y )
+	{
+		success = SDL_RWwrite( file, (const Uint8*)pixels + y * pitch, width * 4, 1 ) == 1;
+	}
+	success = SDL_RWclose( file ) == 0 && success;
+
+	#ifdef _WIN32
+	//Renaming does not replace files on Windows
+	::remove( cachePath.c_str() );
+	#endif
+	if( !success || rename( writePath.c_str(), cachePath.c_str() ) != 0 )
+	{
+		cout << "Unable to write pixel cache " << cachePath << "!" << endl;
+		::remove( writePath.c_str() );
+		return false;
+	}
+
+	return true;
+}
+
+void PixelCache::remove( string path )
+{
+	::remove( getCachePath( path ).c_str() );
+}
+
+void PixelCache::setEnabled( bool enabled )
+{
+	mEnabled = enabled;
+}
+
+bool PixelCache::isEnabled()
+{
+	return mEnabled;
+}
+
+string PixelCache::getCachePath( string path )
+{
+	return path + PIXEL_CACHE_EXTENSION;
+}
+
+int PixelCache::getHitCount()
+{
+	return mHits;
+}
+
+int PixelCache::getMissCount()
+{
+	return mMisses;
+}
+
+int PixelCache::getStaleCount()
+{
+	return mStale;
+}
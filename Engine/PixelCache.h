@@ -0,0 +1,81 @@
+#ifndef PIXEL_CACHE_H
+#define PIXEL_CACHE_H
+
+#include <SDL2/SDL.h>
+#include <string>
+
+//Size and modification time of a source image, what entries are checked against
+struct PixelSource
+{
+	Uint64 size;
+	Sint64 modified;
+};
+
+//Cached pixels opened for reading, valid until closed
+struct CachedPixels
+{
+	//Image dimensions, rows are packed at width * 4 bytes
+	int width;
+	int height;
+
+	//Color keyed RGBA8888 pixels
+	const Uint8* pixels;
+
+	//Mapped file, or the buffer it was read into where mapping is not available
+	void* mapping;
+	size_t mappingSize;
+};
+
+//Converted and color keyed RGBA8888 pixels kept on disk beside their source image, so later runs skip decoding.
+//Entries are checked against the source's size and modification time and are rewritten when it changes
+class PixelCache
+{
+	public:
+		//The cache every LTexture shares
+		static PixelCache& getInstance();
+
+		//Reads the size and modification time of the image at path, false if it cannot be read
+		//Take it before decoding, so an image changed while it decodes leaves a stale entry rather than a wrong one
+		static bool stat( std::string path, PixelSource& source );
+
+		//Opens the entry for the image at path as source describes it, false if there is none or it is stale
+		bool open( std::string path, const PixelSource& source, CachedPixels& cached );
+
+		//Releases an opened entry
+		void close( CachedPixels& cached );
+
+		//Writes the entry for the image at path, as source described it before decoding, from pixels with the given pitch
+		//Replaces any old entry
+		bool store( std::string path, const PixelSource& source, const void* pixels, int pitch, int width, int height );
+
+		//Deletes the entry for the image at path
+		void remove( std::string path );
+
+		//Turns reading and writing entries on and off, on by default
+		void setEnabled( bool enabled );
+		bool isEnabled();
+
+		//File an image's entry is kept in
+		static std::string getCachePath( std::string path );
+
+		//Opens that found a valid entry, found none and found one out of date
+		int getHitCount();
+		int getMissCount();
+		int getStaleCount();
+
+	private:
+		//Only getInstance creates the cache
+		PixelCache();
+		PixelCache( const PixelCache& );
+		PixelCache& operator=( const PixelCache& );
+
+		//Whether entries are used
+		bool mEnabled;
+
+		//Lookup statistics
+		int mHits;
+		int mMisses;
+		int mStale;
+};
+
+#endif
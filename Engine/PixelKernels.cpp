@@ -0,0 +1,459 @@
+#include "PixelKernels.h"
+#include <string.h>
+
+#ifdef CPU_HAS_X86
+#include <immintrin.h>
+#endif
+
+//Which byte of a shuffle source lands in each byte of four pixels, same for both AVX2 halves
+enum PixelShuffle
+{
+	SHUFFLE_REVERSE,
+	SHUFFLE_EXPAND_RGB,
+	SHUFFLE_EXPAND_BGR,
+	SHUFFLE_PACK_RGB,
+	SHUFFLE_PACK_BGR
+};
+
+//Shuffle byte that zeroes its destination
+const Uint8 SHUFFLE_ZERO = 0x80;
+
+//Scales a color channel by alpha, exact rounding of c * a / 255
+static inline Uint32 scaleChannel( Uint32 c, Uint32 a )
+{
+	Uint32 t = c * a + 128;
+	return ( t + ( t >> 8 ) ) >> 8;
+}
+
+static void colorKeyScalar( Uint32* pixels, int begin, int end, Uint32 key, Uint32 replacement )
+{
+	for( int i = begin; i < end; ++i )
+	{
+		if( pixels[ i ] == key )
+		{
+			pixels[ i ] = replacement;
+		}
+	}
+}
+
+static void premultiplyScalar( Uint32* pixels, int begin, int end )
+{
+	for( int i = begin; i < end; ++i )
+	{
+		Uint32 p = pixels[ i ];
+		Uint32 a = p & 0xFF;
+		pixels[ i ] = ( scaleChannel( p >> 24, a ) << 24 ) | ( scaleChannel( ( p >> 16 ) & 0xFF, a ) << 16 ) | ( scaleChannel( ( p >> 8 ) & 0xFF, a ) << 8 ) | a;
+	}
+}
+
+static void reverseScalar( const Uint32* source, Uint32* destination, int begin, int end )
+{
+	for( int i = begin; i < end; ++i )
+	{
+		Uint32 p = source[ i ];
+		destination[ i ] = ( p >> 24 ) | ( ( p >> 8 ) & 0xFF00 ) | ( ( p << 8 ) & 0xFF0000 ) | ( p << 24 );
+	}
+}
+
+static void expandScalar( const Uint8* source, Uint32* destination, int begin, int end, bool bgr )
+{
+	//Red is the first byte of RGB24 and the last of BGR24
+	int red = bgr ? 2 : 0;
+	int blue = bgr ? 0 : 2;
+	for( int i = begin; i < end; ++i )
+	{
+		const Uint8* p = source + i * 3;
+		destination[ i ] = ( (Uint32)p[ red ] << 24 ) | ( (Uint32)p[ 1 ] << 16 ) | ( (Uint32)p[ blue ] << 8 ) | 0xFF;
+	}
+}
+
+static void packScalar( const Uint32* source, Uint8* destination, int begin, int end, bool bgr )
+{
+	int red = bgr ? 2 : 0;
+	int blue = bgr ? 0 : 2;
+	for( int i = begin; i < end; ++i )
+	{
+		Uint32 p = source[ i ];
+		Uint8* out = destination + i * 3;
+		out[ red ] = (Uint8)( p >> 24 );
+		out[ 1 ] = (Uint8)( p >> 16 );
+		out[ blue ] = (Uint8)( p >> 8 );
+	}
+}
+
+#ifdef CPU_HAS_X86
+//Byte shuffle table for four pixels
+static void makeShuffle( PixelShuffle shuffle, Uint8 table[ 16 ] )
+{
+	memset( table, SHUFFLE_ZERO, 16 );
+	for( int k = 0; k < 4; ++k )
+	{
+		switch( shuffle )
+		{
+			case SHUFFLE_REVERSE:
+				for( int j = 0; j < 4; ++j )
+				{
+					table[ k * 4 + j ] = k * 4 + 3 - j;
+				}
+				break;
+
+			//RGBA8888 keeps alpha in its lowest byte, which comes first in memory and is left zero
+			case SHUFFLE_EXPAND_RGB:
+			case SHUFFLE_EXPAND_BGR:
+				table[ k * 4 + 1 ] = k * 3 + ( shuffle == SHUFFLE_EXPAND_BGR ? 0 : 2 );
+				table[ k * 4 + 2 ] = k * 3 + 1;
+				table[ k * 4 + 3 ] = k * 3 + ( shuffle == SHUFFLE_EXPAND_BGR ? 2 : 0 );
+				break;
+
+			//Twelve packed bytes, the last four are left zero
+			case SHUFFLE_PACK_RGB:
+			case SHUFFLE_PACK_BGR:
+				table[ k * 3 ] = k * 4 + ( shuffle == SHUFFLE_PACK_BGR ? 1 : 3 );
+				table[ k * 3 + 1 ] = k * 4 + 2;
+				table[ k * 3 + 2 ] = k * 4 + ( shuffle == SHUFFLE_PACK_BGR ? 3 : 1 );
+				break;
+		}
+	}
+}
+
+//Byte reversal of each pixel without SSSE3's shuffle, swaps bytes in each half then the halves
+CPU_TARGET_SSE2 static inline __m128i reverseBytesSSE2( __m128i v )
+{
+	v = _mm_or_si128( _mm_slli_epi16( v, 8 ), _mm_srli_epi16( v, 8 ) );
+	v = _mm_shufflelo_epi16( v, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+	return _mm_shufflehi_epi16( v, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+}
+
+CPU_TARGET_SSE2 static void colorKeySSE2( Uint32* pixels, int count, Uint32 key, Uint32 replacement )
+{
+	__m128i keys = _mm_set1_epi32( (int)key );
+	__m128i replacements = _mm_set1_epi32( (int)replacement );
+
+	//Four pixels at a time
+	int i = 0;
+	for( ; i + 4 <= count; i += 4 )
+	{
+		__m128i p = _mm_loadu_si128( (const __m128i*)( pixels + i ) );
+		__m128i keyed = _mm_cmpeq_epi32( p, keys );
+		_mm_storeu_si128( (__m128i*)( pixels + i ), _mm_or_si128( _mm_andnot_si128( keyed, p ), _mm_and_si128( keyed, replacements ) ) );
+	}
+
+	//Leftover pixels
+	colorKeyScalar( pixels, i, count, key, replacement );
+}
+
+CPU_TARGET_AVX2 static void colorKeyAVX2( Uint32* pixels, int count, Uint32 key, Uint32 replacement )
+{
+	__m256i keys = _mm256_set1_epi32( (int)key );
+	__m256i replacements = _mm256_set1_epi32( (int)replacement );
+
+	//Eight pixels at a time
+	int i = 0;
+	for( ; i + 8 <= count; i += 8 )
+	{
+		__m256i p = _mm256_loadu_si256( (const __m256i*)( pixels + i ) );
+		__m256i keyed = _mm256_cmpeq_epi32( p, keys );
+		_mm256_storeu_si256( (__m256i*)( pixels + i ), _mm256_blendv_epi8( p, replacements, keyed ) );
+	}
+
+	//Leftover pixels
+	colorKeyScalar( pixels, i, count, key, replacement );
+}
+
+//Premultiplies two pixels widened to 16 bit channels, alpha first
+CPU_TARGET_SSE2 static inline __m128i premultiplyWideSSE2( __m128i wide, __m128i alphaWords, __m128i round )
+{
+	__m128i alpha = _mm_shufflehi_epi16( _mm_shufflelo_epi16( wide, 0 ), 0 );
+	__m128i t = _mm_add_epi16( _mm_mullo_epi16( wide, alpha ), round );
+	__m128i scaled = _mm_srli_epi16( _mm_add_epi16( t, _mm_srli_epi16( t, 8 ) ), 8 );
+
+	//Alpha itself is kept
+	return _mm_or_si128( _mm_andnot_si128( alphaWords, scaled ), _mm_and_si128( alphaWords, wide ) );
+}
+
+CPU_TARGET_SSE2 static void premultiplySSE2( Uint32* pixels, int count )
+{
+	__m128i zero = _mm_setzero_si128();
+	__m128i round = _mm_set1_epi16( 128 );
+	__m128i alphaWords = _mm_set_epi32( 0, 0xFFFF, 0, 0xFFFF );
+
+	//Four pixels at a time
+	int i = 0;
+	for( ; i + 4 <= count; i += 4 )
+	{
+		__m128i p = _mm_loadu_si128( (const __m128i*)( pixels + i ) );
+		__m128i low = premultiplyWideSSE2( _mm_unpacklo_epi8( p, zero ), alphaWords, round );
+		__m128i high = premultiplyWideSSE2( _mm_unpackhi_epi8( p, zero ), alphaWords, round );
+		_mm_storeu_si128( (__m128i*)( pixels + i ), _mm_packus_epi16( low, high ) );
+	}
+
+	//Leftover pixels
+	premultiplyScalar( pixels, i, count );
+}
+
+//Premultiplies four pixels widened to 16 bit channels, two in each half
+CPU_TARGET_AVX2 static inline __m256i premultiplyWideAVX2( __m256i wide, __m256i alphaWords, __m256i round )
+{
+	__m256i alpha = _mm256_shufflehi_epi16( _mm256_shufflelo_epi16( wide, 0 ), 0 );
+	__m256i t = _mm256_add_epi16( _mm256_mullo_epi16( wide, alpha ), round );
+	__m256i scaled = _mm256_srli_epi16( _mm256_add_epi16( t, _mm256_srli_epi16( t, 8 ) ), 8 );
+	return _mm256_blendv_epi8( scaled, wide, alphaWords );
+}
+
+CPU_TARGET_AVX2 static void premultiplyAVX2( Uint32* pixels, int count )
+{
+	__m256i zero = _mm256_setzero_si256();
+	__m256i round = _mm256_set1_epi16( 128 );
+	__m256i alphaWords = _mm256_set1_epi64x( 0xFFFF );
+
+	//Eight pixels at a time, unpacking and packing both stay within each half so pixels keep their order
+	int i = 0;
+	for( ; i + 8 <= count; i += 8 )
+	{
+		__m256i p = _mm256_loadu_si256( (const __m256i*)( pixels + i ) );
+		__m256i low = premultiplyWideAVX2( _mm256_unpacklo_epi8( p, zero ), alphaWords, round );
+		__m256i high = premultiplyWideAVX2( _mm256_unpackhi_epi8( p, zero ), alphaWords, round );
+		_mm256_storeu_si256( (__m256i*)( pixels + i ), _mm256_packus_epi16( low, high ) );
+	}
+
+	//Leftover pixels
+	premultiplyScalar( pixels, i, count );
+}
+
+CPU_TARGET_SSE2 static void reverseSSE2( const Uint32* source, Uint32* destination, int count )
+{
+	//Four pixels at a time
+	int i = 0;
+	for( ; i + 4 <= count; i += 4 )
+	{
+		__m128i p = _mm_loadu_si128( (const __m128i*)( source + i ) );
+		_mm_storeu_si128( (__m128i*)( destination + i ), reverseBytesSSE2( p ) );
+	}
+
+	//Leftover pixels
+	reverseScalar( source, destination, i, count );
+}
+
+CPU_TARGET_AVX2 static void reverseAVX2( const Uint32* source, Uint32* destination, int count )
+{
+	Uint8 table[ 16 ];
+	makeShuffle( SHUFFLE_REVERSE, table );
+	__m256i shuffle = _mm256_broadcastsi128_si256( _mm_loadu_si128( (const __m128i*)table ) );
+
+	//Eight pixels at a time
+	int i = 0;
+	for( ; i + 8 <= count; i += 8 )
+	{
+		__m256i p = _mm256_loadu_si256( (const __m256i*)( source + i ) );
+		_mm256_storeu_si256( (__m256i*)( destination + i ), _mm256_shuffle_epi8( p, shuffle ) );
+	}
+
+	//Leftover pixels
+	reverseScalar( source, destination, i, count );
+}
+
+CPU_TARGET_SSE2 static void expandSSE2( const Uint8* source, Uint32* destination, int count, bool bgr )
+{
+	__m128i alpha = _mm_set1_epi32( 0xFF );
+	__m128i lane0 = _mm_set_epi32( 0, 0, 0, -1 );
+	__m128i lane1 = _mm_set_epi32( 0, 0, -1, 0 );
+	__m128i lane2 = _mm_set_epi32( 0, -1, 0, 0 );
+	__m128i lane3 = _mm_set_epi32( -1, 0, 0, 0 );
+
+	//Four pixels at a time, reading 16 bytes for their 12 so two more pixels have to follow
+	int i = 0;
+	for( ; i + 6 <= count; i += 4 )
+	{
+		//Pixel k starts k bytes before its lane, so each lane takes the load shifted up by k bytes
+		__m128i packed = _mm_loadu_si128( (const __m128i*)( source + i * 3 ) );
+		__m128i p = _mm_and_si128( packed, lane0 );
+		p = _mm_or_si128( p, _mm_and_si128( _mm_slli_si128( packed, 1 ), lane1 ) );
+		p = _mm_or_si128( p, _mm_and_si128( _mm_slli_si128( packed, 2 ), lane2 ) );
+		p = _mm_or_si128( p, _mm_and_si128( _mm_slli_si128( packed, 3 ), lane3 ) );
+
+		//RGB24 bytes are backwards in a little endian RGBA8888 pixel, BGR24 bytes are only one byte low
+		p = bgr ? _mm_slli_epi32( p, 8 ) : reverseBytesSSE2( p );
+		_mm_storeu_si128( (__m128i*)( destination + i ), _mm_or_si128( p, alpha ) );
+	}
+
+	//Leftover pixels
+	expandScalar( source, destination, i, count, bgr );
+}
+
+CPU_TARGET_AVX2 static void expandAVX2( const Uint8* source, Uint32* destination, int count, bool bgr )
+{
+	Uint8 table[ 16 ];
+	makeShuffle( bgr ? SHUFFLE_EXPAND_BGR : SHUFFLE_EXPAND_RGB, table );
+	__m256i shuffle = _mm256_broadcastsi128_si256( _mm_loadu_si128( (const __m128i*)table ) );
+	__m256i alpha = _mm256_set1_epi32( 0xFF );
+
+	//Eight pixels at a time, each half reads 16 bytes for its 12 so the reads stay inside the source
+	int i = 0;
+	for( ; i + 10 <= count; i += 8 )
+	{
+		const Uint8* p = source + i * 3;
+		__m256i packed = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( (const __m128i*)p ) ), _mm_loadu_si128( (const __m128i*)( p + 12 ) ), 1 );
+		_mm256_storeu_si256( (__m256i*)( destination + i ), _mm256_or_si256( _mm256_shuffle_epi8( packed, shuffle ), alpha ) );
+	}
+
+	//Leftover pixels
+	expandScalar( source, destination, i, count, bgr );
+}
+
+CPU_TARGET_SSE2 static void packSSE2( const Uint32* source, Uint8* destination, int count, bool bgr )
+{
+	__m128i lane0 = _mm_set_epi32( 0, 0, 0, 0xFFFFFF );
+	__m128i lane1 = _mm_set_epi32( 0, 0, 0xFFFFFF, 0 );
+	__m128i lane2 = _mm_set_epi32( 0, 0xFFFFFF, 0, 0 );
+	__m128i lane3 = _mm_set_epi32( 0xFFFFFF, 0, 0, 0 );
+
+	//Four pixels at a time, writing 16 bytes for their 12 so two more pixels have to follow and overwrite the spare bytes
+	int i = 0;
+	for( ; i + 6 <= count; i += 4 )
+	{
+		__m128i p = _mm_loadu_si128( (const __m128i*)( source + i ) );
+		p = bgr ? _mm_srli_epi32( p, 8 ) : reverseBytesSSE2( p );
+
+		//Lane k's three bytes move down k bytes to close the gaps
+		__m128i packed = _mm_and_si128( p, lane0 );
+		packed = _mm_or_si128( packed, _mm_srli_si128( _mm_and_si128( p, lane1 ), 1 ) );
+		packed = _mm_or_si128( packed, _mm_srli_si128( _mm_and_si128( p, lane2 ), 2 ) );
+		packed = _mm_or_si128( packed, _mm_srli_si128( _mm_and_si128( p, lane3 ), 3 ) );
+		_mm_storeu_si128( (__m128i*)( destination + i * 3 ), packed );
+	}
+
+	//Leftover pixels
+	packScalar( source, destination, i, count, bgr );
+}
+
+CPU_TARGET_AVX2 static void packAVX2( const Uint32* source, Uint8* destination, int count, bool bgr )
+{
+	Uint8 table[ 16 ];
+	makeShuffle( bgr ? SHUFFLE_PACK_BGR : SHUFFLE_PACK_RGB, table );
+	__m256i shuffle = _mm256_broadcastsi128_si256( _mm_loadu_si128( (const __m128i*)table ) );
+
+	//Eight pixels at a time, the upper half is written over the lower half's four spare bytes
+	int i = 0;
+	for( ; i + 10 <= count; i += 8 )
+	{
+		__m256i packed = _mm256_shuffle_epi8( _mm256_loadu_si256( (const __m256i*)( source + i ) ), shuffle );
+		Uint8* out = destination + i * 3;
+		_mm_storeu_si128( (__m128i*)out, _mm256_castsi256_si128( packed ) );
+		_mm_storeu_si128( (__m128i*)( out + 12 ), _mm256_extracti128_si256( packed, 1 ) );
+	}
+
+	//Leftover pixels
+	packScalar( source, destination, i, count, bgr );
+}
+#endif
+
+bool isPixelKernelSupported( PixelKernel kernel )
+{
+	return isCpuLevelSupported( kernel );
+}
+
+PixelKernel getBestPixelKernel()
+{
+	return (PixelKernel)getBestCpuLevel();
+}
+
+const char* getPixelKernelName( PixelKernel kernel )
+{
+	return getCpuLevelName( kernel );
+}
+
+void colorKeyPixels( PixelKernel kernel, Uint32* pixels, int count, Uint32 key, Uint32 replacement )
+{
+	switch( getRunnableCpuLevel( kernel ) )
+	{
+		#ifdef CPU_HAS_X86
+		case PIXEL_SSE2: colorKeySSE2( pixels, count, key, replacement ); break;
+		case PIXEL_AVX2: colorKeyAVX2( pixels, count, key, replacement ); break;
+		#endif
+		default: colorKeyScalar( pixels, 0, count, key, replacement ); break;
+	}
+}
+
+void premultiplyAlpha( PixelKernel kernel, Uint32* pixels, int count )
+{
+	switch( getRunnableCpuLevel( kernel ) )
+	{
+		#ifdef CPU_HAS_X86
+		case PIXEL_SSE2: premultiplySSE2( pixels, count ); break;
+		case PIXEL_AVX2: premultiplyAVX2( pixels, count ); break;
+		#endif
+		default: premultiplyScalar( pixels, 0, count ); break;
+	}
+}
+
+void reversePixelBytes( PixelKernel kernel, const Uint32* source, Uint32* destination, int count )
+{
+	switch( getRunnableCpuLevel( kernel ) )
+	{
+		#ifdef CPU_HAS_X86
+		case PIXEL_SSE2: reverseSSE2( source, destination, count ); break;
+		case PIXEL_AVX2: reverseAVX2( source, destination, count ); break;
+		#endif
+		default: reverseScalar( source, destination, 0, count ); break;
+	}
+}
+
+void expandRGB24( PixelKernel kernel, const Uint8* source, Uint32* destination, int count, bool bgr )
+{
+	switch( getRunnableCpuLevel( kernel ) )
+	{
+		#ifdef CPU_HAS_X86
+		case PIXEL_SSE2: expandSSE2( source, destination, count, bgr ); break;
+		case PIXEL_AVX2: expandAVX2( source, destination, count, bgr ); break;
+		#endif
+		default: expandScalar( source, destination, 0, count, bgr ); break;
+	}
+}
+
+void packRGB24( PixelKernel kernel, const Uint32* source, Uint8* destination, int count, bool bgr )
+{
+	switch( getRunnableCpuLevel( kernel ) )
+	{
+		#ifdef CPU_HAS_X86
+		case PIXEL_SSE2: packSSE2( source, destination, count, bgr ); break;
+		case PIXEL_AVX2: packAVX2( source, destination, count, bgr ); break;
+		#endif
+		default: packScalar( source, destination, 0, count, bgr ); break;
+	}
+}
+
+bool convertToRGBA8888( PixelKernel kernel, SDL_Surface* surface, void* pixels, int pitch )
+{
+	Uint32 format = surface->format->format;
+	if( format != SDL_PIXELFORMAT_RGBA8888 && format != SDL_PIXELFORMAT_ABGR8888 && format != SDL_PIXELFORMAT_RGB24 && format != SDL_PIXELFORMAT_BGR24 )
+	{
+		return false;
+	}
+
+	//A color key, such as a PNG's tRNS transparent color, RLE or surface alpha change the pixels, SDL's conversion handles those
+	Uint8 alpha = 0xFF;
+	if( SDL_GetColorKey( surface, NULL ) == 0 || SDL_HasSurfaceRLE( surface ) || ( SDL_GetSurfaceAlphaMod( surface, &alpha ) == 0 && alpha != 0xFF ) )
+	{
+		return false;
+	}
+
+	SDL_LockSurface( surface );
+
+	//Row by row since the surface and destination pitches can differ
+	for( int y = 0; y < surface->h; ++y )
+	{
+		const Uint8* source = (const Uint8*)surface->pixels + y * surface->pitch;
+		Uint32* destination = (Uint32*)( (Uint8*)pixels + y * pitch );
+		switch( format )
+		{
+			case SDL_PIXELFORMAT_RGBA8888: memcpy( destination, source, surface->w * 4 ); break;
+			case SDL_PIXELFORMAT_ABGR8888: reversePixelBytes( kernel, (const Uint32*)source, destination, surface->w ); break;
+			case SDL_PIXELFORMAT_RGB24: expandRGB24( kernel, source, destination, surface->w, false ); break;
+			case SDL_PIXELFORMAT_BGR24: expandRGB24( kernel, source, destination, surface->w, true ); break;
+		}
+	}
+
+	SDL_UnlockSurface( surface );
+
+	return true;
+}
@@ -0,0 +1,46 @@
+#ifndef PIXEL_KERNELS_H
+#define PIXEL_KERNELS_H
+
+#include <SDL2/SDL.h>
+#include "CpuDispatch.h"
+
+//Instruction sets the pixel conversions can run on
+enum PixelKernel
+{
+	PIXEL_SCALAR = CPU_SCALAR,
+	PIXEL_SSE2 = CPU_SSE2,
+	PIXEL_AVX2 = CPU_AVX2,
+	TOTAL_PIXEL_KERNELS = TOTAL_CPU_LEVELS
+};
+
+//Checks whether the kernel can run on this machine
+bool isPixelKernelSupported( PixelKernel kernel );
+
+//Picks the widest supported kernel
+PixelKernel getBestPixelKernel();
+
+//Gets kernel display name
+const char* getPixelKernelName( PixelKernel kernel );
+
+//Every kernel below falls back to scalar if the one asked for is unsupported
+
+//Replaces every pixel equal to key with replacement
+void colorKeyPixels( PixelKernel kernel, Uint32* pixels, int count, Uint32 key, Uint32 replacement );
+
+//Scales red, green and blue of RGBA8888 pixels by their alpha, rounded to nearest
+void premultiplyAlpha( PixelKernel kernel, Uint32* pixels, int count );
+
+//Reverses the bytes of each pixel, turning ABGR8888 into RGBA8888 and back, source and destination may be the same
+void reversePixelBytes( PixelKernel kernel, const Uint32* source, Uint32* destination, int count );
+
+//Expands 24 bit RGB24, or BGR24 if bgr is set, to opaque RGBA8888
+void expandRGB24( PixelKernel kernel, const Uint8* source, Uint32* destination, int count, bool bgr );
+
+//Packs RGBA8888 down to 24 bit RGB24, or BGR24 if bgr is set, dropping alpha
+void packRGB24( PixelKernel kernel, const Uint32* source, Uint8* destination, int count, bool bgr );
+
+//Converts a surface into RGBA8888 pixels with the given pitch
+//False if its format has no kernel or it has a color key, RLE or surface alpha, leave those to SDL_ConvertSurfaceFormat
+bool convertToRGBA8888( PixelKernel kernel, SDL_Surface* surface, void* pixels, int pitch );
+
+#endif
@@ -0,0 +1,190 @@
+#include "SpatialHash.h"
+
+//Strict overlap, boxes that only touch do not count like in the samples' checkCollision
+static bool overlaps( const SDL_Rect& a, const SDL_Rect& b )
+{
+	return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+SpatialHash::SpatialHash( int cellSize, int bucketCount )
+{
+	//Initialize
+	mCellSize = cellSize > 0 ? cellSize : 1;
+	int buckets = 1;
+	while( buckets < bucketCount )
+	{
+		buckets *= 2;
+	}
+	mBucketMask = buckets - 1;
+	mBucketStart.assign( buckets + 1, 0 );
+	mDirty = false;
+}
+
+void SpatialHash::clear()
+{
+	mIds.clear();
+	mBounds.clear();
+	mEntries.clear();
+	mDirty = true;
+}
+
+void SpatialHash::insert( int id, SDL_Rect box )
+{
+	int index = (int)mIds.size();
+	mIds.push_back( id );
+	mBounds.push_back( box );
+
+	//List the collider in every cell it covers
+	int lastX = getCell( box.x + box.w - 1 );
+	int lastY = getCell( box.y + box.h - 1 );
+	for( int cellY = getCell( box.y ); cellY <= lastY; ++cellY )
+	{
+		for( int cellX = getCell( box.x ); cellX <= lastX; ++cellX )
+		{
+			Entry entry = { cellX, cellY, index };
+			mEntries.push_back( entry );
+		}
+	}
+	mDirty = true;
+}
+
+void SpatialHash::insert( int id, int x, int y, int r )
+{
+	SDL_Rect box = { x - r, y - r, r * 2, r * 2 };
+	insert( id, box );
+}
+
+void SpatialHash::findPairs( std::vector< CollisionPair >& pairs )
+{
+	pairs.clear();
+	build();
+
+	int buckets = mBucketMask + 1;
+	for( int bucket = 0; bucket < buckets; ++bucket )
+	{
+		int end = mBucketStart[ bucket + 1 ];
+		for( int i = mBucketStart[ bucket ]; i < end; ++i )
+		{
+			Entry& first = mSorted[ i ];
+			SDL_Rect& a = mBounds[ first.index ];
+			for( int j = i + 1; j < end; ++j )
+			{
+				//Different cells that share a bucket
+				Entry& second = mSorted[ j ];
+				if( second.cellX != first.cellX || second.cellY != first.cellY )
+				{
+					continue;
+				}
+
+				SDL_Rect& b = mBounds[ second.index ];
+				if( !overlaps( a, b ) )
+				{
+					continue;
+				}
+
+				//Pairs sharing several cells are reported by the cell holding their overlap's top left corner
+				int cornerX = a.x > b.x ? a.x : b.x;
+				int cornerY = a.y > b.y ? a.y : b.y;
+				if( getCell( cornerX ) != first.cellX || getCell( cornerY ) != first.cellY )
+				{
+					continue;
+				}
+
+				CollisionPair pair;
+				pair.a = mIds[ first.index < second.index ? first.index : second.index ];
+				pair.b = mIds[ first.index < second.index ? second.index : first.index ];
+				pairs.push_back( pair );
+			}
+		}
+	}
+}
+
+void SpatialHash::query( SDL_Rect box, std::vector< int >& ids )
+{
+	ids.clear();
+	build();
+
+	int lastX = getCell( box.x + box.w - 1 );
+	int lastY = getCell( box.y + box.h - 1 );
+	for( int cellY = getCell( box.y ); cellY <= lastY; ++cellY )
+	{
+		for( int cellX = getCell( box.x ); cellX <= lastX; ++cellX )
+		{
+			int bucket = getBucket( cellX, cellY );
+			int end = mBucketStart[ bucket + 1 ];
+			for( int i = mBucketStart[ bucket ]; i < end; ++i )
+			{
+				Entry& entry = mSorted[ i ];
+				SDL_Rect& bounds = mBounds[ entry.index ];
+				if( entry.cellX != cellX || entry.cellY != cellY || !overlaps( box, bounds ) )
+				{
+					continue;
+				}
+
+				//Same top left corner rule as findPairs so each collider is listed once
+				int cornerX = box.x > bounds.x ? box.x : bounds.x;
+				int cornerY = box.y > bounds.y ? box.y : bounds.y;
+				if( getCell( cornerX ) == cellX && getCell( cornerY ) == cellY )
+				{
+					ids.push_back( mIds[ entry.index ] );
+				}
+			}
+		}
+	}
+}
+
+int SpatialHash::getCount()
+{
+	return (int)mIds.size();
+}
+
+int SpatialHash::getCell( int x )
+{
+	//Plain division rounds towards zero
+	return x >= 0 ? x / mCellSize : -( ( -x + mCellSize - 1 ) / mCellSize );
+}
+
+int SpatialHash::getBucket( int cellX, int cellY )
+{
+	return (int)( ( (Uint32)cellX * 73856093u ) ^ ( (Uint32)cellY * 19349663u ) ) & mBucketMask;
+}
+
+void SpatialHash::build()
+{
+	if( !mDirty )
+	{
+		return;
+	}
+
+	//Count entries per bucket
+	int buckets = mBucketMask + 1;
+	mBucketStart.assign( buckets + 1, 0 );
+	for( int i = 0; i < (int)mEntries.size(); ++i )
+	{
+		++mBucketStart[ getBucket( mEntries[ i ].cellX, mEntries[ i ].cellY ) + 1 ];
+	}
+
+	//Turn counts into start offsets
+	for( int bucket = 0; bucket < buckets; ++bucket )
+	{
+		mBucketStart[ bucket + 1 ] += mBucketStart[ bucket ];
+	}
+
+	//Place entries, the write cursor of each bucket walks up from its start
+	mSorted.resize( mEntries.size() );
+	std::vector< int >& cursor = mBucketStart;
+	for( int i = 0; i < (int)mEntries.size(); ++i )
+	{
+		int bucket = getBucket( mEntries[ i ].cellX, mEntries[ i ].cellY );
+		mSorted[ cursor[ bucket ]++ ] = mEntries[ i ];
+	}
+
+	//Cursors now sit at the next bucket's start, shift them back
+	for( int bucket = buckets; bucket > 0; --bucket )
+	{
+		mBucketStart[ bucket ] = mBucketStart[ bucket - 1 ];
+	}
+	mBucketStart[ 0 ] = 0;
+
+	mDirty = false;
+}
@@ -0,0 +1,74 @@
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+//Two colliders whose bounds overlap
+struct CollisionPair
+{
+	int a;
+	int b;
+};
+
+//Uniform grid broad phase, cells are hashed into a fixed bucket table so the level can be any size
+class SpatialHash
+{
+	public:
+		//Cells are cellSize pixels square, bucketCount is rounded up to a power of two
+		SpatialHash( int cellSize, int bucketCount = 4096 );
+
+		//Removes every collider, keeps memory for the next frame
+		void clear();
+
+		//Adds a collider by its bounding box
+		void insert( int id, SDL_Rect box );
+
+		//Adds a circle collider by its center and radius
+		void insert( int id, int x, int y, int r );
+
+		//Every pair of colliders with overlapping bounds, each pair once with a < b in insertion order
+		void findPairs( std::vector< CollisionPair >& pairs );
+
+		//Every collider whose bounds overlap box, each once
+		void query( SDL_Rect box, std::vector< int >& ids );
+
+		//Colliders inserted since the last clear
+		int getCount();
+
+	private:
+		//A collider listed in one cell
+		struct Entry
+		{
+			int cellX;
+			int cellY;
+			int index;
+		};
+
+		//Cell coordinate of a pixel coordinate, rounding down
+		int getCell( int x );
+
+		//Bucket holding a cell
+		int getBucket( int cellX, int cellY );
+
+		//Sorts entries into buckets after inserts
+		void build();
+
+		//Grid
+		int mCellSize;
+		int mBucketMask;
+
+		//Collider ids and bounds by insertion order
+		std::vector< int > mIds;
+		std::vector< SDL_Rect > mBounds;
+
+		//One entry per cell each collider covers, and the same grouped by bucket
+		std::vector< Entry > mEntries;
+		std::vector< Entry > mSorted;
+		std::vector< int > mBucketStart;
+
+		//Whether mSorted is behind mEntries
+		bool mDirty;
+};
+
+#endif
@@ -0,0 +1,167 @@
+#include "Sweep.h"
+#include <math.h>
+
+//Times past any move
+const double SWEEP_NEVER = 1e30;
+
+//Slack for times that should land exactly on a whole pixel
+const double SWEEP_EPSILON = 1e-9;
+
+//When a point moving from start at velocity is strictly between low and high
+static bool sweepSlab( double start, double velocity, double low, double high, double& enter, double& exit )
+{
+	//Standing still is inside for all time or never
+	if( velocity == 0 )
+	{
+		enter = -SWEEP_NEVER;
+		exit = SWEEP_NEVER;
+		return low < start && start < high;
+	}
+
+	enter = ( low - start ) / velocity;
+	exit = ( high - start ) / velocity;
+	if( enter > exit )
+	{
+		double swap = enter;
+		enter = exit;
+		exit = swap;
+	}
+	return true;
+}
+
+//When a point moving from x, y at velocity is strictly inside the box from left, top to right, bottom
+//Also returns which axis it crossed last to get in
+static bool sweepPoint( double x, double y, int velX, int velY, double left, double top, double right, double bottom, double& enter, double& exit, bool& enteredX )
+{
+	double enterX, exitX, enterY, exitY;
+	if( !sweepSlab( x, velX, left, right, enterX, exitX ) || !sweepSlab( y, velY, top, bottom, enterY, exitY ) )
+	{
+		return false;
+	}
+
+	//Inside once inside on both axes, until out on either
+	enteredX = enterX >= enterY;
+	enter = enteredX ? enterX : enterY;
+	exit = exitX < exitY ? exitX : exitY;
+	return enter < exit;
+}
+
+bool sweepBox( const SDL_Rect& box, int velX, int velY, const SDL_Rect& target, SweepHit& hit )
+{
+	//The box's corner against the target grown by the box's size
+	double enter, exit;
+	bool enteredX;
+	if( !sweepPoint( box.x, box.y, velX, velY, target.x - box.w, target.y - box.h, target.x + target.w, target.y + target.h, enter, exit, enteredX ) )
+	{
+		return false;
+	}
+
+	//Overlapping from the start, or not until after the move
+	if( enter < 0 || enter >= 1 )
+	{
+		return false;
+	}
+
+	hit.time = enter;
+	hit.normalX = enteredX ? ( velX > 0 ? -1 : 1 ) : 0;
+	hit.normalY = enteredX ? 0 : ( velY > 0 ? -1 : 1 );
+	return true;
+}
+
+bool sweepCircle( int x, int y, int r, int velX, int velY, const SDL_Rect& target, SweepHit& hit )
+{
+	//Closest point on the target to the start
+	int closestX = x < target.x ? target.x : ( x > target.x + target.w ? target.x + target.w : x );
+	int closestY = y < target.y ? target.y : ( y > target.y + target.h ? target.y + target.h : y );
+	int deltaX = x - closestX;
+	int deltaY = y - closestY;
+	if( deltaX * deltaX + deltaY * deltaY < r * r )
+	{
+		//Overlapping from the start
+		return false;
+	}
+
+	//The center against the target grown by the radius, its corners are rounded below
+	double enter, exit;
+	bool enteredX;
+	if( !sweepPoint( x, y, velX, velY, target.x - r, target.y - r, target.x + target.w + r, target.y + target.h + r, enter, exit, enteredX ) )
+	{
+		return false;
+	}
+	if( enter >= 1 || exit <= 0 )
+	{
+		return false;
+	}
+
+	//Starting in a corner of the grown box is not overlapping, the corner check below takes over
+	if( enter < 0 )
+	{
+		enter = 0;
+	}
+
+	//Entering along a side is a face contact
+	double contactX = x + velX * enter;
+	double contactY = y + velY * enter;
+	if( ( contactX >= target.x && contactX <= target.x + target.w ) || ( contactY >= target.y && contactY <= target.y + target.h ) )
+	{
+		hit.time = enter;
+		hit.normalX = enteredX ? ( velX > 0 ? -1 : 1 ) : 0;
+		hit.normalY = enteredX ? 0 : ( velY > 0 ? -1 : 1 );
+		return true;
+	}
+
+	//Otherwise the center has to come within the radius of the nearest corner
+	double cornerX = contactX < target.x ? target.x : target.x + target.w;
+	double cornerY = contactY < target.y ? target.y : target.y + target.h;
+	double fromX = x - cornerX;
+	double fromY = y - cornerY;
+	double a = (double)velX * velX + (double)velY * velY;
+	double b = fromX * velX + fromY * velY;
+	double c = fromX * fromX + fromY * fromY - (double)r * r;
+	double discriminant = b * b - a * c;
+	if( a == 0 || discriminant < 0 )
+	{
+		return false;
+	}
+
+	//First root is where the center reaches the corner's circle
+	double time = ( -b - sqrt( discriminant ) ) / a;
+	if( time < 0 || time >= 1 )
+	{
+		return false;
+	}
+
+	hit.time = time;
+	hit.normalX = ( fromX + velX * time ) / r;
+	hit.normalY = ( fromY + velY * time ) / r;
+	return true;
+}
+
+int getSweepTravel( int velocity, const SweepHit& hit )
+{
+	//Round down so the shape stops at or before the contact
+	int speed = velocity < 0 ? -velocity : velocity;
+	int travel = (int)floor( hit.time * speed + SWEEP_EPSILON );
+	if( travel > speed )
+	{
+		travel = speed;
+	}
+
+	return velocity < 0 ? -travel : travel;
+}
+
+SDL_Rect getSweepBounds( const SDL_Rect& box, int velX, int velY )
+{
+	SDL_Rect bounds = box;
+	if( velX < 0 )
+	{
+		bounds.x += velX;
+	}
+	if( velY < 0 )
+	{
+		bounds.y += velY;
+	}
+	bounds.w += velX < 0 ? -velX : velX;
+	bounds.h += velY < 0 ? -velY : velY;
+	return bounds;
+}
@@ -0,0 +1,30 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <SDL2/SDL.h>
+
+//Earliest contact of a moving shape
+struct SweepHit
+{
+	//Fraction of the velocity travelled when the shapes start to overlap
+	double time;
+
+	//Unit normal of the surface that was hit, pointing back at the moving shape
+	double normalX;
+	double normalY;
+};
+
+//Sweeps box along its velocity against target, true if they would start to overlap before the move ends
+//Boxes only touching do not overlap, same as the samples' checkCollision, and targets overlapped from the start are ignored
+bool sweepBox( const SDL_Rect& box, int velX, int velY, const SDL_Rect& target, SweepHit& hit );
+
+//Sweeps the circle at x, y with radius r along its velocity against target with the same rules
+bool sweepCircle( int x, int y, int r, int velX, int velY, const SDL_Rect& target, SweepHit& hit );
+
+//Whole pixels of velocity that can be travelled before the contact, never past it
+int getSweepTravel( int velocity, const SweepHit& hit );
+
+//Box covering a box over its whole move
+SDL_Rect getSweepBounds( const SDL_Rect& box, int velX, int velY );
+
+#endif
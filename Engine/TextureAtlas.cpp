@@ -0,0 +1,288 @@
+#include "TextureAtlas.h"
+#include "AtlasPacker.h"
+#include "TextureCache.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+//Gap between packed images so filtering never bleeds into a neighbour
+const int ATLAS_PADDING = 1;
+
+//Image in the order it gets packed
+struct PackOrder
+{
+	int index;
+	int width;
+	int height;
+};
+
+//Tallest images first keeps the skyline flat
+static bool tallerFirst( const PackOrder& a, const PackOrder& b )
+{
+	if( a.height != b.height )
+	{
+		return a.height > b.height;
+	}
+	return a.width > b.width;
+}
+
+//Directory part of a path including the slash, empty if there is none
+static string getDirectory( string path )
+{
+	size_t slash = path.find_last_of( "/\\" );
+	return slash == string::npos ? "" : path.substr( 0, slash + 1 );
+}
+
+TextureAtlas::TextureAtlas()
+{
+	//Initialize
+	mWidth = 0;
+	mHeight = 0;
+}
+
+TextureAtlas::~TextureAtlas()
+{
+	//Deallocate
+	free();
+}
+
+bool TextureAtlas::build( SDL_Renderer* renderer, string name, string paths[], int count )
+{
+	//Get rid of preexisting atlas
+	free();
+
+	//Pack images into one sheet
+	vector< AtlasRegion > regions;
+	SDL_Surface* sheet = pack( paths, count, regions );
+	if( sheet == NULL )
+	{
+		return false;
+	}
+
+	//The sheet's background is the usual cyan color key
+	SDL_SetColorKey( sheet, SDL_TRUE, SDL_MapRGB( sheet->format, 0, 0xFF, 0xFF ) );
+
+	//Share the sheet through the texture cache like any other image
+	string key = "atlas:" + name;
+	if( TextureCache::getInstance().adopt( renderer, key, sheet, mWidth, mHeight ) != NULL )
+	{
+		mKey = key;
+		mRegions = regions;
+	}
+
+	//Get rid of packed sheet
+	SDL_FreeSurface( sheet );
+
+	return !mKey.empty();
+}
+
+bool TextureAtlas::loadFromFile( SDL_Renderer* renderer, string tablePath )
+{
+	//Get rid of preexisting atlas
+	free();
+
+	//Open the clip table
+	ifstream table( tablePath.c_str() );
+	if( !table.is_open() )
+	{
+		cout << "Unable to open atlas table " << tablePath << "!" << endl;
+		return false;
+	}
+
+	//Sheet image first, relative to the table
+	string image;
+	table >> image;
+	image = getDirectory( tablePath ) + image;
+
+	//Then one line per packed image
+	vector< AtlasRegion > regions;
+	AtlasRegion region;
+	while( table >> region.path >> region.clip.x >> region.clip.y >> region.clip.w >> region.clip.h )
+	{
+		regions.push_back( region );
+	}
+	if( !table.eof() || regions.empty() )
+	{
+		cout << "Error loading atlas table " << tablePath << "!" << endl;
+		return false;
+	}
+
+	//Load sheet
+	if( TextureCache::getInstance().acquire( renderer, image, mWidth, mHeight ) == NULL )
+	{
+		return false;
+	}
+	mKey = image;
+	mRegions = regions;
+
+	return true;
+}
+
+void TextureAtlas::free()
+{
+	//Drop our reference to the sheet
+	if( !mKey.empty() )
+	{
+		TextureCache::getInstance().release( mKey );
+		mKey.clear();
+	}
+
+	mRegions.clear();
+	mWidth = 0;
+	mHeight = 0;
+}
+
+SDL_Rect* TextureAtlas::getClip( string path )
+{
+	for( int i = 0; i < (int)mRegions.size(); ++i )
+	{
+		if( mRegions[ i ].path == path )
+		{
+			return &mRegions[ i ].clip;
+		}
+	}
+
+	return NULL;
+}
+
+string TextureAtlas::getKey()
+{
+	return mKey;
+}
+
+int TextureAtlas::getWidth()
+{
+	return mWidth;
+}
+
+int TextureAtlas::getHeight()
+{
+	return mHeight;
+}
+
+SDL_Surface* TextureAtlas::pack( string paths[], int count, vector< AtlasRegion >& regions )
+{
+	regions.clear();
+
+	//Load every image
+	vector< SDL_Surface* > images( count, (SDL_Surface*)NULL );
+	vector< PackOrder > order( count );
+	bool success = true;
+	int widest = 0;
+	int area = 0;
+	for( int i = 0; i < count && success; ++i )
+	{
+		images[ i ] = TextureCache::decode( paths[ i ] );
+		if( images[ i ] == NULL )
+		{
+			success = false;
+		}
+		else
+		{
+			order[ i ].index = i;
+			order[ i ].width = images[ i ]->w;
+			order[ i ].height = images[ i ]->h;
+			widest = max( widest, images[ i ]->w );
+			area += ( images[ i ]->w + ATLAS_PADDING ) * ( images[ i ]->h + ATLAS_PADDING );
+		}
+	}
+	if( success && widest > MAX_WIDTH )
+	{
+		cout << "Image too wide for an atlas: " << widest << endl;
+		success = false;
+	}
+
+	//Aim for a roughly square sheet with a power of two width
+	SDL_Surface* sheet = NULL;
+	if( success && count > 0 )
+	{
+		int width = 1;
+		while( width < MAX_WIDTH && ( width < widest || width * width < area ) )
+		{
+			width *= 2;
+		}
+
+		//Place images
+		AtlasPacker packer( width, ATLAS_PADDING );
+		sort( order.begin(), order.end(), tallerFirst );
+		regions.resize( count );
+		for( int i = 0; i < count && success; ++i )
+		{
+			int index = order[ i ].index;
+			regions[ index ].path = paths[ index ];
+			if( !packer.insert( order[ i ].width, order[ i ].height, regions[ index ].clip ) )
+			{
+				cout << "Unable to fit " << paths[ index ] << " in the atlas!" << endl;
+				success = false;
+			}
+		}
+
+		//Cyan background so padding and keyed pixels both end up transparent
+		if( success )
+		{
+			sheet = SDL_CreateRGBSurfaceWithFormat( 0, packer.getWidth(), packer.getHeight(), 32, SDL_PIXELFORMAT_RGBA8888 );
+			if( sheet == NULL )
+			{
+				cout << "Unable to create atlas surface! SDL Error: " << SDL_GetError() << endl;
+			}
+			else
+			{
+				SDL_FillRect( sheet, NULL, SDL_MapRGB( sheet->format, 0, 0xFF, 0xFF ) );
+
+				//Copy pixels as they are, keyed pixels are skipped and stay cyan
+				for( int i = 0; i < count; ++i )
+				{
+					SDL_Rect destination = regions[ i ].clip;
+					SDL_SetSurfaceBlendMode( images[ i ], SDL_BLENDMODE_NONE );
+					SDL_BlitSurface( images[ i ], NULL, sheet, &destination );
+				}
+			}
+		}
+	}
+
+	//Get rid of loaded images
+	for( int i = 0; i < count; ++i )
+	{
+		if( images[ i ] != NULL )
+		{
+			SDL_FreeSurface( images[ i ] );
+		}
+	}
+
+	if( sheet == NULL )
+	{
+		regions.clear();
+	}
+
+	return sheet;
+}
+
+bool TextureAtlas::save( SDL_Surface* sheet, vector< AtlasRegion >& regions, string imagePath, string tablePath )
+{
+	//Write sheet
+	if( SDL_SaveBMP( sheet, imagePath.c_str() ) != 0 )
+	{
+		cout << "Unable to save atlas image " << imagePath << "! SDL Error: " << SDL_GetError() << endl;
+		return false;
+	}
+
+	//Write clip table, the sheet is named relative to the table
+	ofstream table( tablePath.c_str() );
+	if( !table.is_open() )
+	{
+		cout << "Unable to save atlas table " << tablePath << "!" << endl;
+		return false;
+	}
+
+	size_t slash = imagePath.find_last_of( "/\\" );
+	table << ( slash == string::npos ? imagePath : imagePath.substr( slash + 1 ) ) << "\n";
+	for( int i = 0; i < (int)regions.size(); ++i )
+	{
+		SDL_Rect& clip = regions[ i ].clip;
+		table << regions[ i ].path << " " << clip.x << " " << clip.y << " " << clip.w << " " << clip.h << "\n";
+	}
+
+	return true;
+}
@@ -0,0 +1,65 @@
+#ifndef TEXTURE_ATLAS_H
+#define TEXTURE_ATLAS_H
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+
+//Where one source image ended up inside an atlas
+struct AtlasRegion
+{
+	std::string path;
+	SDL_Rect clip;
+};
+
+//Several images packed into one shared texture, either at load time or from an offline clip table
+class TextureAtlas
+{
+	public:
+		//Widest sheet the packer builds
+		static const int MAX_WIDTH = 1024;
+
+		//Initializes variables
+		TextureAtlas();
+
+		//Deallocates memory
+		~TextureAtlas();
+
+		//Packs the images at paths into one texture, cached under the given name
+		bool build( SDL_Renderer* renderer, std::string name, std::string paths[], int count );
+
+		//Loads a sheet and clip table written by the offline packer
+		bool loadFromFile( SDL_Renderer* renderer, std::string tablePath );
+
+		//Deallocates atlas
+		void free();
+
+		//Clip of the image loaded from path, NULL if it is not in the atlas
+		SDL_Rect* getClip( std::string path );
+
+		//Texture cache key of the sheet
+		std::string getKey();
+
+		//Gets sheet dimensions
+		int getWidth();
+		int getHeight();
+
+		//Packs the images at paths into a color keyed sheet, NULL on failure
+		static SDL_Surface* pack( std::string paths[], int count, std::vector< AtlasRegion >& regions );
+
+		//Writes a packed sheet as a BMP plus the clip table that loadFromFile reads
+		static bool save( SDL_Surface* sheet, std::vector< AtlasRegion >& regions, std::string imagePath, std::string tablePath );
+
+	private:
+		//Cache key holding our reference to the sheet
+		std::string mKey;
+
+		//Sheet dimensions
+		int mWidth;
+		int mHeight;
+
+		//Packed images
+		std::vector< AtlasRegion > mRegions;
+};
+
+#endif
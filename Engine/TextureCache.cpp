@@ -0,0 +1,167 @@
+#include "TextureCache.h"
+#include <SDL2/SDL_image.h>
+#include <iostream>
+
+using namespace std;
+
+TextureCache& TextureCache::getInstance()
+{
+	//Never destroyed, so global textures freed at exit can still release into it
+	static TextureCache* cache = new TextureCache();
+	return *cache;
+}
+
+TextureCache::TextureCache()
+{
+	//Initialize
+	mHits = 0;
+	mMisses = 0;
+}
+
+SDL_Texture* TextureCache::acquire( SDL_Renderer* renderer, string path, int& width, int& height )
+{
+	//Already loaded
+	Entry* entry = share( path );
+	if( entry != NULL )
+	{
+		width = entry->width;
+		height = entry->height;
+		return entry->texture;
+	}
+
+	//Load image at specified path
+	SDL_Surface* loadedSurface = decode( path );
+	if( loadedSurface == NULL )
+	{
+		return NULL;
+	}
+
+	//Create texture from surface pixels
+	SDL_Texture* newTexture = insert( renderer, path, loadedSurface );
+	if( newTexture != NULL )
+	{
+		width = loadedSurface->w;
+		height = loadedSurface->h;
+	}
+
+	//Get rid of old loaded surface
+	SDL_FreeSurface( loadedSurface );
+
+	return newTexture;
+}
+
+SDL_Texture* TextureCache::adopt( SDL_Renderer* renderer, string path, SDL_Surface* surface, int& width, int& height )
+{
+	//Someone loaded the same image in the meantime
+	Entry* entry = share( path );
+	if( entry != NULL )
+	{
+		width = entry->width;
+		height = entry->height;
+		return entry->texture;
+	}
+
+	//Create texture from the decoded pixels
+	SDL_Texture* newTexture = insert( renderer, path, surface );
+	if( newTexture != NULL )
+	{
+		width = surface->w;
+		height = surface->h;
+	}
+
+	return newTexture;
+}
+
+SDL_Texture* TextureCache::acquireLoaded( string path, int& width, int& height )
+{
+	Entry* entry = share( path );
+	if( entry == NULL )
+	{
+		return NULL;
+	}
+
+	width = entry->width;
+	height = entry->height;
+	return entry->texture;
+}
+
+SDL_Surface* TextureCache::decode( string path )
+{
+	//Load image at specified path
+	SDL_Surface* loadedSurface = IMG_Load( path.c_str() );
+	if( loadedSurface == NULL )
+	{
+		cout << "Unable to load image " << path << "! SDL_image Error: " << IMG_GetError() << endl;
+	}
+	else
+	{
+		//Color key image
+		SDL_SetColorKey( loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ) );
+	}
+
+	return loadedSurface;
+}
+
+TextureCache::Entry* TextureCache::share( string path )
+{
+	map< string, Entry >::iterator found = mEntries.find( path );
+	if( found == mEntries.end() )
+	{
+		return NULL;
+	}
+
+	++found->second.references;
+	++mHits;
+	return &found->second;
+}
+
+SDL_Texture* TextureCache::insert( SDL_Renderer* renderer, string path, SDL_Surface* surface )
+{
+	++mMisses;
+
+	//Create texture from surface pixels
+	SDL_Texture* newTexture = SDL_CreateTextureFromSurface( renderer, surface );
+	if( newTexture == NULL )
+	{
+		cout << "Unable to create texture from " << path << "! SDL Error: " << SDL_GetError() << endl;
+	}
+	else
+	{
+		//Remember the image for the next user
+		Entry entry = { newTexture, surface->w, surface->h, 1 };
+		mEntries[ path ] = entry;
+	}
+
+	return newTexture;
+}
+
+void TextureCache::release( string path )
+{
+	map< string, Entry >::iterator found = mEntries.find( path );
+	if( found == mEntries.end() )
+	{
+		return;
+	}
+
+	//Last user gone
+	if( --found->second.references == 0 )
+	{
+		SDL_DestroyTexture( found->second.texture );
+		mEntries.erase( found );
+	}
+}
+
+int TextureCache::getTextureCount()
+{
+	return (int)mEntries.size();
+}
+
+int TextureCache::getHitCount()
+{
+	return mHits;
+}
+
+int TextureCache::getMissCount()
+{
+	return mMisses;
+}
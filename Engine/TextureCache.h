@@ -0,0 +1,66 @@
+#ifndef TEXTURE_CACHE_H
+#define TEXTURE_CACHE_H
+
+#include <SDL2/SDL.h>
+#include <map>
+#include <string>
+
+//Color keyed textures shared by path, destroyed when their last user releases them
+class TextureCache
+{
+	public:
+		//The cache every LTexture shares
+		static TextureCache& getInstance();
+
+		//Returns the texture for path, loading it on first use, NULL on failure
+		SDL_Texture* acquire( SDL_Renderer* renderer, std::string path, int& width, int& height );
+
+		//Same as acquire, but a first use uploads the already decoded surface, which the caller still owns
+		SDL_Texture* adopt( SDL_Renderer* renderer, std::string path, SDL_Surface* surface, int& width, int& height );
+
+		//Same as acquire for an image that is already loaded, NULL if it is not
+		SDL_Texture* acquireLoaded( std::string path, int& width, int& height );
+
+		//Loads and color keys the image at path, safe to call from any thread
+		static SDL_Surface* decode( std::string path );
+
+		//Drops one reference to path
+		void release( std::string path );
+
+		//Textures currently loaded
+		int getTextureCount();
+
+		//Acquires served from memory and acquires that had to load
+		int getHitCount();
+		int getMissCount();
+
+	private:
+		//One loaded image
+		struct Entry
+		{
+			SDL_Texture* texture;
+			int width;
+			int height;
+			int references;
+		};
+
+		//Returns the entry for path with one more reference, NULL if it is not loaded
+		Entry* share( std::string path );
+
+		//Uploads surface as a new entry with one reference
+		SDL_Texture* insert( SDL_Renderer* renderer, std::string path, SDL_Surface* surface );
+
+		//Only getInstance creates the cache
+		TextureCache();
+		TextureCache( const TextureCache& );
+		TextureCache& operator=( const TextureCache& );
+
+		//Loaded images by path
+		std::map< std::string, Entry > mEntries;
+
+		//Lookup statistics
+		int mHits;
+		int mMisses;
+};
+
+#endif
@@ -0,0 +1,69 @@
+#!/bin/sh
+#Builds every sample twice, once linked against libengine.a and once with the
+#engine sources compiled straight into the binary the way the old copies were,
+#then prints build time and binary size for both.
+#Usage: build_report.sh sample_dir...
+
+ENGINE_DIR=$( cd "$( dirname "$0" )" && pwd )
+OUT_DIR=$( mktemp -d )
+trap 'rm -rf "$OUT_DIR"' EXIT
+
+#Milliseconds since the epoch
+now_ms()
+{
+	echo $(( $( date +%s%N ) / 1000000 ))
+}
+
+#Bytes in a file, 0 if it is missing
+file_size()
+{
+	if [ -f "$1" ]; then wc -c < "$1" | tr -d ' '; else echo 0; fi
+}
+
+#The library is built once and shared by every sample
+make -s -C "$ENGINE_DIR" clean
+start=$( now_ms )
+make -s -C "$ENGINE_DIR" || exit 1
+engine_ms=$(( $( now_ms ) - start ))
+
+#Every source the library is built from, the inline builds compile all of them in
+inline_src=""
+for src in $( make -s --no-print-directory -C "$ENGINE_DIR" print-objs ); do
+	inline_src="$inline_src $ENGINE_DIR/$src"
+done
+
+#Objects are linked whole rather than pulled from an archive, so the text ones need SDL_ttf in every sample
+inline_src="$inline_src -lSDL2_ttf"
+
+printf "%-24s %10s %10s %12s %12s\n" "sample" "lib ms" "inline ms" "lib bytes" "inline bytes"
+
+shared_ms=$engine_ms
+inline_ms=0
+shared_bytes=0
+inline_bytes=0
+for dir in "$@"; do
+	name=$( basename "$dir" )
+
+	start=$( now_ms )
+	make -s -C "$dir" OBJ_NAME="$OUT_DIR/$name.lib" > /dev/null 2>&1 || echo "$name: library build failed" >&2
+	lib_ms=$(( $( now_ms ) - start ))
+
+	start=$( now_ms )
+	make -s -C "$dir" ENGINE="$inline_src" OBJ_NAME="$OUT_DIR/$name.inline" > /dev/null 2>&1 || echo "$name: inline build failed" >&2
+	copy_ms=$(( $( now_ms ) - start ))
+
+	lib_size=$( file_size "$OUT_DIR/$name.lib" )
+	copy_size=$( file_size "$OUT_DIR/$name.inline" )
+
+	printf "%-24s %10d %10d %12d %12d\n" "$name" "$lib_ms" "$copy_ms" "$lib_size" "$copy_size"
+
+	shared_ms=$(( shared_ms + lib_ms ))
+	inline_ms=$(( inline_ms + copy_ms ))
+	shared_bytes=$(( shared_bytes + lib_size ))
+	inline_bytes=$(( inline_bytes + copy_size ))
+done
+
+echo
+echo "engine library build: $engine_ms ms"
+echo "total build: $shared_ms ms with the library, $inline_ms ms inline, delta $(( shared_ms - inline_ms )) ms"
+echo "total binaries: $shared_bytes bytes with the library, $inline_bytes bytes inline, delta $(( shared_bytes - inline_bytes )) bytes"